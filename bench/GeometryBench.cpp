@@ -0,0 +1,233 @@
+// GeometryBench.cpp
+// Geometry kernel benchmark: every SIMD level the CPU supports is checked
+// against the scalar reference and timed on the meshes in models/ plus a
+// synthetic point cloud. Non-zero exit if any path disagrees.
+#include "GeometryKernels.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int REPEATS = 20;
+
+    struct Input
+    {
+        std::string name;
+        PositionStreams points;
+        std::vector<float> radius; // küre testi: noktalar merkez olarak
+    };
+
+    // Ölçekli, döndürülmüş, ötelenmiş: sıradan bir model matrisi
+    const float MODEL_MATRIX[16] = {
+        0.8f, 0.1f, -0.3f, 0.0f,
+        -0.2f, 0.9f, 0.05f, 0.0f,
+        0.3f, 0.0f, 0.85f, 0.0f,
+        2.0f, 0.5f, -3.0f, 1.0f};
+
+    // Orijine bakan küçük bir perspektif frustum'un düzlemleri (normalize)
+    void makePlanes(float planes[24])
+    {
+        const float raw[24] = {
+            1.0f, 0.0f, -0.6f, 0.0f,
+            -1.0f, 0.0f, -0.6f, 0.0f,
+            0.0f, 1.0f, -0.6f, 0.0f,
+            0.0f, -1.0f, -0.6f, 0.0f,
+            0.0f, 0.0f, -1.0f, -0.1f,
+            0.0f, 0.0f, 1.0f, 50.0f};
+        for (int p = 0; p < 6; ++p)
+        {
+            const float *r = raw + p * 4;
+            float len = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+            for (int k = 0; k < 4; ++k)
+                planes[p * 4 + k] = r[k] / len;
+        }
+    }
+
+    bool loadMesh(const std::string &path, Input &input)
+    {
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile(path, aiProcess_Triangulate);
+        if (!scene || !scene->mRootNode)
+            return false;
+        std::vector<Vertex> vertices;
+        for (unsigned int m = 0; m < scene->mNumMeshes; ++m)
+        {
+            const aiMesh *mesh = scene->mMeshes[m];
+            for (unsigned int i = 0; i < mesh->mNumVertices; ++i)
+            {
+                Vertex v{};
+                v.Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+                vertices.push_back(v);
+            }
+        }
+        input.name = std::filesystem::path(path).filename().string();
+        input.points.assign(vertices.data(), vertices.size());
+        return !vertices.empty();
+    }
+
+    void makeCloud(std::size_t count, Input &input)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> dist(-20.0f, 20.0f);
+        std::vector<Vertex> vertices(count);
+        for (Vertex &v : vertices)
+            v.Position = glm::vec3(dist(rng), dist(rng), dist(rng) - 20.0f);
+        input.name = "synthetic " + std::to_string(count);
+        input.points.assign(vertices.data(), vertices.size());
+    }
+
+    bool close(float a, float b)
+    {
+        return std::fabs(a - b) <= 1e-5f * std::max(1.0f, std::max(std::fabs(a), std::fabs(b)));
+    }
+
+    template <typename F>
+    double bestMs(F &&f)
+    {
+        double best = std::numeric_limits<double>::max();
+        for (int r = 0; r < REPEATS; ++r)
+        {
+            auto start = Clock::now();
+            f();
+            best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        return best;
+    }
+
+    // Tek seviye: referansla karşılaştır, sonra ölç. Dönüş: hata sayısı.
+    int runLevel(const GeometryKernels &k, const Input &in, const float planes[24], double scalarMs[5])
+    {
+        const GeometryKernels &ref = *geometryKernelsFor(SimdLevel::Scalar);
+        const PositionStreams &p = in.points;
+        const std::size_t n = p.size();
+        int errors = 0;
+        const float inf = std::numeric_limits<float>::max();
+
+        float refMin[3] = {inf, inf, inf}, refMax[3] = {-inf, -inf, -inf};
+        float gotMin[3] = {inf, inf, inf}, gotMax[3] = {-inf, -inf, -inf};
+        ref.minMax(p.x.data(), p.y.data(), p.z.data(), n, refMin, refMax);
+        k.minMax(p.x.data(), p.y.data(), p.z.data(), n, gotMin, gotMax);
+        if (std::memcmp(refMin, gotMin, sizeof(refMin)) || std::memcmp(refMax, gotMax, sizeof(refMax)))
+            errors++;
+
+        std::vector<float> rx(n), ry(n), rz(n), gx(n), gy(n), gz(n);
+        ref.transformPoints(MODEL_MATRIX, p.x.data(), p.y.data(), p.z.data(), n, rx.data(), ry.data(), rz.data());
+        k.transformPoints(MODEL_MATRIX, p.x.data(), p.y.data(), p.z.data(), n, gx.data(), gy.data(), gz.data());
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (!close(rx[i], gx[i]) || !close(ry[i], gy[i]) || !close(rz[i], gz[i]))
+            {
+                errors++;
+                break;
+            }
+        }
+
+        float refTMin[3] = {inf, inf, inf}, refTMax[3] = {-inf, -inf, -inf};
+        float gotTMin[3] = {inf, inf, inf}, gotTMax[3] = {-inf, -inf, -inf};
+        ref.transformMinMax(MODEL_MATRIX, p.x.data(), p.y.data(), p.z.data(), n, refTMin, refTMax);
+        k.transformMinMax(MODEL_MATRIX, p.x.data(), p.y.data(), p.z.data(), n, gotTMin, gotTMax);
+        for (int c = 0; c < 3; ++c)
+            if (!close(refTMin[c], gotTMin[c]) || !close(refTMax[c], gotTMax[c]))
+                errors++;
+
+        const float center[3] = {(refMin[0] + refMax[0]) * 0.5f, (refMin[1] + refMax[1]) * 0.5f,
+                                 (refMin[2] + refMax[2]) * 0.5f};
+        if (!close(ref.maxDistanceSq(p.x.data(), p.y.data(), p.z.data(), n, center),
+                   k.maxDistanceSq(p.x.data(), p.y.data(), p.z.data(), n, center)))
+            errors++;
+
+        // Dönüştürülmüş noktalar küre merkezi: bir kısmı frustum içinde kalır
+        std::vector<unsigned char> refVis(n), gotVis(n);
+        ref.testSpheres(planes, rx.data(), ry.data(), rz.data(), in.radius.data(), n, refVis.data());
+        k.testSpheres(planes, rx.data(), ry.data(), rz.data(), in.radius.data(), n, gotVis.data());
+        if (refVis != gotVis)
+            errors++;
+
+        float sink[3];
+        double ms[5] = {
+            bestMs([&] { sink[0] = inf; sink[1] = inf; sink[2] = inf; float mx[3] = {-inf, -inf, -inf};
+                         k.minMax(p.x.data(), p.y.data(), p.z.data(), n, sink, mx); }),
+            bestMs([&] { k.transformPoints(MODEL_MATRIX, p.x.data(), p.y.data(), p.z.data(), n, gx.data(), gy.data(), gz.data()); }),
+            bestMs([&] { sink[0] = inf; sink[1] = inf; sink[2] = inf; float mx[3] = {-inf, -inf, -inf};
+                         k.transformMinMax(MODEL_MATRIX, p.x.data(), p.y.data(), p.z.data(), n, sink, mx); }),
+            bestMs([&] { sink[0] = k.maxDistanceSq(p.x.data(), p.y.data(), p.z.data(), n, center); }),
+            bestMs([&] { k.testSpheres(planes, rx.data(), ry.data(), rz.data(), in.radius.data(), n, gotVis.data()); })};
+        if (k.level == SimdLevel::Scalar)
+            std::copy(ms, ms + 5, scalarMs);
+
+        std::printf("  %-7s", simdLevelName(k.level));
+        for (int i = 0; i < 5; ++i)
+            std::printf(" %8.3f (%4.1fx)", ms[i], scalarMs[i] / ms[i]);
+        std::printf("  %s\n", errors ? "MISMATCH" : "ok");
+        return errors;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string modelDir = "models";
+    std::size_t cloud = 1000003; // SIMD genişliğinin katı değil: kuyruk yolu da sınansın
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--models") == 0 && i + 1 < argc)
+            modelDir = argv[++i];
+        else if (std::strcmp(argv[i], "--points") == 0 && i + 1 < argc)
+            cloud = std::strtoull(argv[++i], nullptr, 10);
+    }
+
+    std::vector<Input> inputs;
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator(modelDir, ec))
+    {
+        if (entry.path().extension() != ".obj")
+            continue;
+        Input input;
+        if (loadMesh(entry.path().string(), input))
+            inputs.push_back(std::move(input));
+        else
+            std::fprintf(stderr, "skipping %s\n", entry.path().string().c_str());
+    }
+    inputs.emplace_back();
+    makeCloud(cloud, inputs.back());
+    for (Input &in : inputs)
+    {
+        in.radius.resize(in.points.size());
+        for (std::size_t i = 0; i < in.radius.size(); ++i)
+            in.radius[i] = 0.05f + 0.01f * static_cast<float>(i % 17);
+    }
+
+    float planes[24];
+    makePlanes(planes);
+
+    std::printf("selected: %s (VM_SIMD caps it)\n", simdLevelName(geometryKernels().level));
+    std::printf("ms per call, best of %d; speedup vs scalar in parentheses\n", REPEATS);
+    int errors = 0;
+    for (const Input &in : inputs)
+    {
+        std::printf("%s: %zu points\n", in.name.c_str(), in.points.size());
+        std::printf("  %-7s %16s %16s %16s %16s %16s\n", "level", "minMax", "transform", "xformMinMax",
+                    "maxDistSq", "spheres");
+        double scalarMs[5] = {1, 1, 1, 1, 1};
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE41, SimdLevel::AVX2, SimdLevel::AVX512})
+        {
+            if (const GeometryKernels *k = geometryKernelsFor(level))
+                errors += runLevel(*k, in, planes, scalarMs);
+            else
+                std::printf("  %-7s not supported\n", simdLevelName(level));
+        }
+    }
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,760 @@
+// ImportBench.cpp
+// Asset import benchmark: every stage of Model::import + Model(ModelData&&)
+// is timed on its own (file read, Assimp parse, materials, node/mesh
+// conversion, post-processing, bounds, texture decode, texture upload, mesh
+// upload) with cold and warm file cache, throughput and allocations per
+// stage. Inputs are models/*.obj plus synthetic grids and textures of
+// growing size, which give the scaling curves. The profile section compares
+// vertex counts and import time of the old fixed Assimp flags, Assimp's own
+// welding and normals, and the default ImportProfile (parallel stages). The
+// memory section counts allocations, arena sizes and the resident peak of a
+// whole Model::import, including a scan-like file of many submeshes.
+//
+//   import_bench [--reps N] [--max-vertices N] [--max-texture N] [--no-gl]
+//                [--no-synthetic] [--csv file] [files...]
+//
+// Cold = the input's directory and textures dropped from the page cache
+// (posix_fadvise, Linux only; elsewhere the first run stands in for it).
+// Allocations are operator new calls (AllocCounter); stb_image mallocs are
+// not seen, nor are Assimp's own. Peak RSS needs Linux (ProcessMemory::resetPeak).
+// Run it from the directory holding models/, like VirtualMuseum.
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <stb_image.h>
+#include "Model.h"
+#include "Mesh.h"
+#include "AllocCounter.h"
+#include "JobSystem.h"
+#include "OffscreenContext.h"
+#include "ProcessMemory.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    enum Stage
+    {
+        STAGE_READ,
+        STAGE_PARSE,
+        STAGE_MATERIALS,
+        STAGE_CONVERT,
+        STAGE_POST,
+        STAGE_BOUNDS,
+        STAGE_TEXTURE_DECODE,
+        STAGE_TEXTURE_UPLOAD,
+        STAGE_MESH_UPLOAD,
+        STAGE_COUNT
+    };
+    const char *const STAGE_NAMES[STAGE_COUNT] = {"read",   "parse",      "materials",  "convert",    "post",
+                                                  "bounds", "tex decode", "tex upload", "mesh upload"};
+
+    struct StageResult
+    {
+        double ms = 0.0;
+        unsigned long long allocs = 0, allocBytes = 0;
+        bool ran = false;
+    };
+
+    struct RunResult
+    {
+        StageResult stages[STAGE_COUNT];
+        std::uint64_t fileBytes = 0;
+        std::uint64_t vertices = 0, triangles = 0; // son işlemden sonra
+        std::uint64_t rawVertices = 0;             // Assimp'in verdiği
+        std::uint64_t textureBytes = 0; // decode edilmiş piksel
+        std::vector<std::string> textures;
+    };
+
+    struct Options
+    {
+        int reps = 5;
+        int maxVertices = 1 << 20;
+        int maxTexture = 4096;
+        bool gl = true;
+        bool synthetic = true;
+        std::string csvPath;
+        std::vector<std::string> files;
+    };
+
+    // Zaman + operator new sayısı; stage'in kendisi dışında hiçbir şey ölçülmez
+    template <typename F>
+    void measure(StageResult &result, F &&stage)
+    {
+        AllocCounter::reset();
+        {
+            AllocCounter::Scope counting;
+            auto start = Clock::now();
+            stage();
+            result.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+        result.allocs = AllocCounter::count();
+        result.allocBytes = AllocCounter::bytes();
+        result.ran = true;
+    }
+
+    bool dropFromCache(const fs::path &path)
+    {
+#if defined(__linux__) && defined(POSIX_FADV_DONTNEED)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        const bool dropped = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+        close(fd);
+        return dropped;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    // Girdinin klasörü (obj + mtl) ve dokuları sayfa önbelleğinden atılır
+    bool dropInputCache(const std::string &path, const std::vector<std::string> &textures)
+    {
+        bool dropped = false;
+        std::error_code ec;
+        for (const auto &entry : fs::directory_iterator(fs::path(path).parent_path(), ec))
+            if (entry.is_regular_file(ec))
+                dropped |= dropFromCache(entry.path());
+        for (const std::string &texture : textures)
+            dropFromCache(texture);
+        return dropped;
+    }
+
+    struct DecodedTexture
+    {
+        unsigned char *pixels;
+        int width, height, components;
+    };
+
+    // Tüm stage'ler sırayla; her biri bir öncekinin çıktısını kullanır
+    bool runOnce(const std::string &path, bool gl, RunResult &result)
+    {
+        StageResult *stages = result.stages;
+
+        std::vector<char> bytes;
+        measure(stages[STAGE_READ], [&]
+                {
+                    std::ifstream in(path, std::ios::binary | std::ios::ate);
+                    bytes.resize(static_cast<std::size_t>(std::max<std::streamoff>(in.tellg(), 0)));
+                    in.seekg(0);
+                    in.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+                });
+        result.fileBytes = bytes.size();
+        std::vector<char>().swap(bytes);
+
+        // Model::import ile aynı bayraklar, varsayılan profil
+        const ImportProfile profile;
+        Assimp::Importer importer;
+        const aiScene *scene = nullptr;
+        measure(stages[STAGE_PARSE], [&]
+                { scene = importer.ReadFile(path, Model::importFlags(profile)); });
+        if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+        {
+            std::fprintf(stderr, "%s: %s\n", path.c_str(), importer.GetErrorString());
+            return false;
+        }
+
+        ModelData data;
+        data.path = path;
+        const std::string directory = path.substr(0, path.find_last_of('/'));
+        measure(stages[STAGE_MATERIALS], [&]
+                {
+                    for (unsigned int i = 0; i < scene->mNumMaterials; ++i)
+                        data.materials.push_back(Model::importMaterial(scene->mMaterials[i], directory));
+                });
+        ImportArena arena(Model::parseArenaBytes(scene)); // postProcess'ten sonra mesh'ler kendi bloklarında
+        measure(stages[STAGE_CONVERT], [&] { Model::processNode(scene->mRootNode, scene, data, arena); });
+        importer.FreeScene();
+        ImportStats stats;
+        measure(stages[STAGE_POST], [&] { Model::postProcess(data, profile, stats); });
+        measure(stages[STAGE_BOUNDS], [&] { Model::computeBounds(data); });
+        result.rawVertices = stats.verticesIn;
+
+        result.vertices = result.triangles = 0;
+        for (const MeshData &mesh : data.meshes)
+        {
+            result.vertices += mesh.vertices.size();
+            result.triangles += mesh.indices.size() / 3;
+        }
+
+        // MaterialLibrary gibi: benzersiz yol başına bir doku
+        std::set<std::string> unique;
+        for (const ImportedMaterial &material : data.materials)
+            for (const std::string *texture : {&material.diffuseTexture, &material.specularTexture})
+                if (!texture->empty())
+                    unique.insert(*texture);
+        result.textures.assign(unique.begin(), unique.end());
+
+        std::vector<DecodedTexture> decoded;
+        measure(stages[STAGE_TEXTURE_DECODE], [&]
+                {
+                    decoded.reserve(result.textures.size());
+                    for (const std::string &texture : result.textures)
+                    {
+                        DecodedTexture t{};
+                        t.pixels = stbi_load(texture.c_str(), &t.width, &t.height, &t.components, 0);
+                        if (t.pixels)
+                            decoded.push_back(t);
+                    }
+                });
+        result.textureBytes = 0;
+        for (const DecodedTexture &t : decoded)
+            result.textureBytes += static_cast<std::uint64_t>(t.width) * t.height * t.components;
+
+        if (gl)
+        {
+            // Material.cpp yükleme yolu; glFinish ile sürücü kopyası da ölçülür
+            std::vector<unsigned int> ids(decoded.size());
+            measure(stages[STAGE_TEXTURE_UPLOAD], [&]
+                    {
+                        if (!ids.empty())
+                            glGenTextures(static_cast<GLsizei>(ids.size()), ids.data());
+                        for (std::size_t i = 0; i < decoded.size(); ++i)
+                        {
+                            const DecodedTexture &t = decoded[i];
+                            GLenum format = t.components == 1 ? GL_RED : t.components == 3 ? GL_RGB : GL_RGBA;
+                            glBindTexture(GL_TEXTURE_2D, ids[i]);
+                            glTexImage2D(GL_TEXTURE_2D, 0, format, t.width, t.height, 0, format, GL_UNSIGNED_BYTE,
+                                         t.pixels);
+                            glGenerateMipmap(GL_TEXTURE_2D);
+                        }
+                        glFinish();
+                    });
+            if (!ids.empty())
+                glDeleteTextures(static_cast<GLsizei>(ids.size()), ids.data());
+
+            std::vector<Mesh> meshes;
+            measure(stages[STAGE_MESH_UPLOAD], [&]
+                    {
+                        meshes.reserve(data.meshes.size());
+                        for (MeshData &mesh : data.meshes)
+                            meshes.emplace_back(std::move(mesh), DEFAULT_MATERIAL);
+                        glFinish();
+                    });
+            for (Mesh &mesh : meshes)
+                mesh.release();
+        }
+        for (DecodedTexture &t : decoded)
+            stbi_image_free(t.pixels);
+        return true;
+    }
+
+    // Cold: önbellek boşaltılıp tek koşu. Warm: bir ısınma, sonra stage başına en iyi
+    bool benchInput(const std::string &path, const Options &opts, RunResult &cold, RunResult &warm, bool &coldValid)
+    {
+        RunResult probe;
+        if (!runOnce(path, opts.gl, probe))
+            return false;
+        coldValid = dropInputCache(path, probe.textures);
+        if (!runOnce(path, opts.gl, cold))
+            return false;
+
+        runOnce(path, opts.gl, warm);
+        for (int rep = 1; rep < opts.reps; ++rep)
+        {
+            RunResult run;
+            runOnce(path, opts.gl, run);
+            for (int s = 0; s < STAGE_COUNT; ++s)
+                if (run.stages[s].ms < warm.stages[s].ms)
+                    warm.stages[s] = run.stages[s];
+        }
+        return true;
+    }
+
+    double mbPerSecond(std::uint64_t bytes, double ms)
+    {
+        return ms > 0.0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / (ms * 1e-3) : 0.0;
+    }
+
+    // Stage'in ürettiği/tükettiği veri: dosya baytı, vertex ya da doku baytı
+    void throughput(const RunResult &r, int stage, double ms, double &mbps, double &mverts)
+    {
+        mbps = mverts = 0.0;
+        if (stage == STAGE_READ || stage == STAGE_PARSE)
+            mbps = mbPerSecond(r.fileBytes, ms);
+        else if (stage == STAGE_TEXTURE_DECODE || stage == STAGE_TEXTURE_UPLOAD)
+            mbps = mbPerSecond(r.textureBytes, ms);
+        if (stage == STAGE_PARSE || stage == STAGE_CONVERT || stage == STAGE_POST)
+            mverts = ms > 0.0 ? static_cast<double>(r.rawVertices) * 1e-6 / (ms * 1e-3) : 0.0;
+        else if (stage == STAGE_BOUNDS || stage == STAGE_MESH_UPLOAD)
+            mverts = ms > 0.0 ? static_cast<double>(r.vertices) * 1e-6 / (ms * 1e-3) : 0.0;
+    }
+
+    void printInput(const std::string &name, const RunResult &cold, const RunResult &warm, bool coldValid)
+    {
+        std::printf("\n%s: %.2f MB, %llu vertices (%llu before welding), %llu triangles, %zu textures (%.1f MB "
+                    "decoded)%s\n",
+                    name.c_str(), static_cast<double>(warm.fileBytes) / (1024.0 * 1024.0),
+                    static_cast<unsigned long long>(warm.vertices), static_cast<unsigned long long>(warm.rawVertices),
+                    static_cast<unsigned long long>(warm.triangles),
+                    warm.textures.size(), static_cast<double>(warm.textureBytes) / (1024.0 * 1024.0),
+                    coldValid ? "" : " [cold = first run, cache not dropped]");
+        std::printf("  %-12s %9s %9s %9s %9s %9s %10s\n", "stage", "cold ms", "warm ms", "MB/s", "Mvert/s", "allocs",
+                    "alloc KB");
+        double coldTotal = 0.0, warmTotal = 0.0;
+        for (int s = 0; s < STAGE_COUNT; ++s)
+        {
+            const StageResult &c = cold.stages[s];
+            const StageResult &w = warm.stages[s];
+            if (!w.ran)
+                continue;
+            coldTotal += c.ms;
+            warmTotal += w.ms;
+            double mbps, mverts;
+            throughput(warm, s, w.ms, mbps, mverts);
+            std::printf("  %-12s %9.3f %9.3f %9.1f %9.2f %9llu %10.1f\n", STAGE_NAMES[s], c.ms, w.ms, mbps, mverts,
+                        w.allocs, static_cast<double>(w.allocBytes) / 1024.0);
+        }
+        std::printf("  %-12s %9.3f %9.3f\n", "total", coldTotal, warmTotal);
+    }
+
+    void writeCsv(std::FILE *csv, const std::string &name, const char *cache, const RunResult &r)
+    {
+        if (!csv)
+            return;
+        for (int s = 0; s < STAGE_COUNT; ++s)
+        {
+            const StageResult &stage = r.stages[s];
+            if (stage.ran)
+                std::fprintf(csv, "%s,%s,%s,%.4f,%llu,%llu,%llu,%llu,%llu\n", name.c_str(), cache, STAGE_NAMES[s],
+                             stage.ms, static_cast<unsigned long long>(r.fileBytes),
+                             static_cast<unsigned long long>(r.vertices),
+                             static_cast<unsigned long long>(r.textureBytes), stage.allocs, stage.allocBytes);
+        }
+    }
+
+    // side x side vertex'lik düz ızgara; v/vt/vn'li OBJ (müze modelleri gibi),
+    // normals false ise v/vt (normal üretimi için). parts > 1: satırlar o kadar
+    // nesneye bölünür, taramalar gibi çok sayıda alt mesh
+    void writeGridObj(const fs::path &path, int side, const char *material = nullptr, bool normals = true,
+                      int parts = 1)
+    {
+        std::FILE *f = std::fopen(path.string().c_str(), "wb");
+        if (!f)
+            return;
+        if (material)
+            std::fprintf(f, "mtllib %s.mtl\nusemtl %s\n", material, material);
+        const float step = 1.0f / static_cast<float>(side - 1);
+        for (int y = 0; y < side; ++y)
+            for (int x = 0; x < side; ++x)
+                std::fprintf(f, "v %.6f %.6f %.6f\n", x * step, 0.05f * static_cast<float>((x ^ y) & 7) * step,
+                             y * step);
+        for (int y = 0; y < side; ++y)
+            for (int x = 0; x < side; ++x)
+                std::fprintf(f, "vt %.6f %.6f\n", x * step, y * step);
+        if (normals)
+            std::fprintf(f, "vn 0 1 0\n");
+        const int rowsPerPart = std::max(1, (side - 1 + parts - 1) / parts);
+        for (int y = 0; y + 1 < side; ++y)
+            for (int x = 0; x + 1 < side; ++x)
+            {
+                if (parts > 1 && x == 0 && y % rowsPerPart == 0)
+                    std::fprintf(f, "o part%d\n", y / rowsPerPart);
+                const int a = y * side + x + 1, b = a + 1, c = a + side, d = c + 1; // OBJ 1 tabanlı
+                if (normals)
+                {
+                    std::fprintf(f, "f %d/%d/1 %d/%d/1 %d/%d/1\n", a, a, c, c, b, b);
+                    std::fprintf(f, "f %d/%d/1 %d/%d/1 %d/%d/1\n", b, b, c, c, d, d);
+                }
+                else
+                {
+                    std::fprintf(f, "f %d/%d %d/%d %d/%d\n", a, a, c, c, b, b);
+                    std::fprintf(f, "f %d/%d %d/%d %d/%d\n", b, b, c, c, d, d);
+                }
+            }
+        std::fclose(f);
+    }
+
+    // Sıkıştırmasız 32 bit TGA (ağaçta PNG yazıcı yok); decode maliyeti bu yüzden alt sınır
+    void writeTga(const fs::path &path, int side)
+    {
+        std::FILE *f = std::fopen(path.string().c_str(), "wb");
+        if (!f)
+            return;
+        const unsigned char header[18] = {0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                          static_cast<unsigned char>(side & 0xFF),
+                                          static_cast<unsigned char>(side >> 8),
+                                          static_cast<unsigned char>(side & 0xFF),
+                                          static_cast<unsigned char>(side >> 8), 32, 8};
+        std::fwrite(header, 1, sizeof(header), f);
+        std::vector<unsigned char> row(static_cast<std::size_t>(side) * 4);
+        for (int y = 0; y < side; ++y)
+        {
+            for (int x = 0; x < side; ++x)
+            {
+                unsigned char *p = &row[static_cast<std::size_t>(x) * 4];
+                p[0] = static_cast<unsigned char>(x);
+                p[1] = static_cast<unsigned char>(y);
+                p[2] = static_cast<unsigned char>(x ^ y);
+                p[3] = 255;
+            }
+            std::fwrite(row.data(), 1, row.size(), f);
+        }
+        std::fclose(f);
+    }
+
+    // Ölçekleme eğrisi: boyut başına warm stage süreleri ve vertex başına ns
+    void meshScaling(const Options &opts, const fs::path &dir, std::FILE *csv)
+    {
+        std::printf("\nMesh scaling (warm, synthetic grids)\n");
+        std::printf("  %10s %9s %9s %9s %9s %9s %9s %10s %11s\n", "vertices", "file MB", "read", "parse", "convert",
+                    "bounds", "upload", "ns/vertex", "allocs/vtx");
+        for (int side = 32; side * side <= opts.maxVertices; side *= 2)
+        {
+            const fs::path path = dir / ("grid_" + std::to_string(side * side) + ".obj");
+            writeGridObj(path, side);
+            RunResult cold, warm;
+            bool coldValid = false;
+            if (!benchInput(path.string(), opts, cold, warm, coldValid))
+                continue;
+            double total = 0.0;
+            unsigned long long allocs = 0;
+            for (const StageResult &stage : warm.stages)
+            {
+                total += stage.ms;
+                allocs += stage.allocs;
+            }
+            const double vertices = static_cast<double>(std::max<std::uint64_t>(warm.vertices, 1));
+            std::printf("  %10llu %9.2f %9.3f %9.3f %9.3f %9.3f %9.3f %10.1f %11.3f\n",
+                        static_cast<unsigned long long>(warm.vertices),
+                        static_cast<double>(warm.fileBytes) / (1024.0 * 1024.0), warm.stages[STAGE_READ].ms,
+                        warm.stages[STAGE_PARSE].ms, warm.stages[STAGE_CONVERT].ms, warm.stages[STAGE_BOUNDS].ms,
+                        warm.stages[STAGE_MESH_UPLOAD].ms, total * 1e6 / vertices,
+                        static_cast<double>(allocs) / vertices);
+            writeCsv(csv, path.filename().string(), "cold", cold);
+            writeCsv(csv, path.filename().string(), "warm", warm);
+            fs::remove(path);
+        }
+    }
+
+    // Doku boyutu eğrisi: tek dokulu bir OBJ/MTL, boyut başına decode ve upload
+    void textureScaling(const Options &opts, const fs::path &dir, std::FILE *csv)
+    {
+        std::printf("\nTexture scaling (warm, synthetic RGBA TGA)\n");
+        std::printf("  %10s %9s %11s %9s %11s %9s\n", "size", "decode", "decode MB/s", "upload", "upload MB/s",
+                    "ns/texel");
+        const fs::path obj = dir / "textured.obj";
+        writeGridObj(obj, 2, "textured");
+        for (int side = 256; side <= opts.maxTexture; side *= 2)
+        {
+            const std::string texture = "texture_" + std::to_string(side) + ".tga";
+            writeTga(dir / texture, side);
+            if (std::FILE *f = std::fopen((dir / "textured.mtl").string().c_str(), "wb"))
+            {
+                std::fprintf(f, "newmtl textured\nmap_Kd %s\n", texture.c_str());
+                std::fclose(f);
+            }
+            RunResult cold, warm;
+            bool coldValid = false;
+            if (benchInput(obj.string(), opts, cold, warm, coldValid))
+            {
+                const StageResult &decode = warm.stages[STAGE_TEXTURE_DECODE];
+                const StageResult &upload = warm.stages[STAGE_TEXTURE_UPLOAD];
+                std::printf("  %5dx%-4d %9.3f %11.1f %9.3f %11.1f %9.2f\n", side, side, decode.ms,
+                            mbPerSecond(warm.textureBytes, decode.ms), upload.ms,
+                            mbPerSecond(warm.textureBytes, upload.ms),
+                            (decode.ms + upload.ms) * 1e6 / (static_cast<double>(side) * side));
+                writeCsv(csv, texture, "cold", cold);
+                writeCsv(csv, texture, "warm", warm);
+            }
+            fs::remove(dir / texture);
+        }
+        fs::remove(obj);
+        fs::remove(dir / "textured.mtl");
+    }
+
+    struct ProfileResult
+    {
+        std::uint64_t vertices = 0;
+        double ms = 0.0; // en iyi koşu
+        bool ok = false;
+    };
+
+    std::uint64_t countVertices(const ModelData &data)
+    {
+        std::uint64_t vertices = 0;
+        for (const MeshData &mesh : data.meshes)
+            vertices += mesh.vertices.size();
+        return vertices;
+    }
+
+    // Assimp bayraklarıyla tüm import (kendi son işlemimiz yok)
+    bool assimpImport(const std::string &path, unsigned int flags, std::uint64_t &vertices)
+    {
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile(path, flags);
+        if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+            return false;
+        ModelData data;
+        const std::string directory = path.substr(0, path.find_last_of('/'));
+        for (unsigned int i = 0; i < scene->mNumMaterials; ++i)
+            data.materials.push_back(Model::importMaterial(scene->mMaterials[i], directory));
+        ImportArena arena(Model::parseArenaBytes(scene));
+        Model::processNode(scene->mRootNode, scene, data, arena);
+        Model::computeBounds(data);
+        vertices = countVertices(data);
+        return true;
+    }
+
+    template <typename F>
+    ProfileResult bestOf(int reps, F &&import)
+    {
+        ProfileResult result;
+        for (int rep = 0; rep < reps; ++rep)
+        {
+            const auto start = Clock::now();
+            if (!import(result.vertices))
+                return result;
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            result.ms = rep == 0 ? ms : std::min(result.ms, ms);
+        }
+        result.ok = true;
+        return result;
+    }
+
+    // Eski sabit bayraklar (tanjantlar hesaplanıp atılıyordu, kaynak yok),
+    // Assimp'in kaynak + normal üretimi ve varsayılan profil, warm
+    void profileComparison(const Options &opts, const std::vector<std::string> &files, const fs::path &dir)
+    {
+        std::vector<std::string> inputs = files;
+        fs::path grid;
+        if (opts.synthetic)
+        {
+            int side = 32;
+            while (side * 2 * side * 2 <= std::min(opts.maxVertices, 1 << 18))
+                side *= 2;
+            grid = dir / ("grid_no_normals_" + std::to_string(side * side) + ".obj");
+            writeGridObj(grid, side, nullptr, false);
+            inputs.push_back(grid.string());
+        }
+
+        std::printf("\nImport profiles (warm, best of %d, %u threads)\n", opts.reps, JobSystem::get().threadCount());
+        std::printf("  %-28s %10s %9s %10s %9s %10s %9s %8s\n", "input", "old verts", "old ms", "assimp vt",
+                    "assimp ms", "profile vt", "prof ms", "verts");
+        const unsigned int legacy = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace;
+        const unsigned int assimpWeld = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices |
+                                        aiProcess_GenSmoothNormals;
+        for (const std::string &input : inputs)
+        {
+            const ProfileResult old = bestOf(opts.reps, [&](std::uint64_t &vertices)
+                                             { return assimpImport(input, legacy, vertices); });
+            const ProfileResult assimp = bestOf(opts.reps, [&](std::uint64_t &vertices)
+                                                { return assimpImport(input, assimpWeld, vertices); });
+            const ProfileResult profile = bestOf(opts.reps, [&](std::uint64_t &vertices)
+                                                 {
+                try
+                {
+                    vertices = countVertices(Model::import(input));
+                    return true;
+                }
+                catch (const std::exception &)
+                {
+                    return false;
+                } });
+            if (!old.ok || !assimp.ok || !profile.ok)
+            {
+                std::printf("  %-28s import failed\n", fs::path(input).filename().string().c_str());
+                continue;
+            }
+            std::printf("  %-28s %10llu %9.3f %10llu %9.3f %10llu %9.3f %7.1f%%\n",
+                        fs::path(input).filename().string().c_str(), static_cast<unsigned long long>(old.vertices),
+                        old.ms, static_cast<unsigned long long>(assimp.vertices), assimp.ms,
+                        static_cast<unsigned long long>(profile.vertices), profile.ms,
+                        100.0 * static_cast<double>(profile.vertices) /
+                            static_cast<double>(std::max<std::uint64_t>(old.vertices, 1)));
+        }
+        if (!grid.empty())
+            fs::remove(grid);
+    }
+
+    // Tüm Model::import: operator new sayısı (iş parçacıkları dahil), arena
+    // boyutları ve import süresince yerleşik bellek tepesi (başlangıca göre)
+    void importMemory(const Options &opts, const std::vector<std::string> &files, const fs::path &dir)
+    {
+        std::vector<std::string> inputs = files;
+        fs::path scan;
+        if (opts.synthetic)
+        {
+            int side = 32;
+            while (side * 2 * side * 2 <= std::min(opts.maxVertices, 1 << 18))
+                side *= 2;
+            scan = dir / ("scan_" + std::to_string(side * side) + ".obj");
+            writeGridObj(scan, side, nullptr, false, std::min(side - 1, 400));
+            inputs.push_back(scan.string());
+        }
+
+        const bool peakValid = ProcessMemory::resetPeak();
+        std::printf("\nImport memory (warm, default profile)%s\n", peakValid ? "" : " [peak RSS not resettable here]");
+        std::printf("  %-28s %7s %10s %9s %9s %10s %9s %9s %9s %9s\n", "input", "meshes", "vertices", "ms", "allocs",
+                    "allocs/msh", "alloc MB", "arena MB", "mesh MB", "peak MB");
+        for (const std::string &input : inputs)
+        {
+            try
+            {
+                Model::import(input); // dosya önbelleği ve ilk kullanım ayırmaları
+                ProcessMemory::resetPeak();
+                const std::size_t base = ProcessMemory::residentBytes();
+                ImportStats stats;
+                AllocCounter::reset();
+                ModelData data;
+                {
+                    AllocCounter::Scope counting;
+                    data = Model::import(input, ImportProfile(), &stats);
+                }
+                const std::size_t peak = ProcessMemory::peakResidentBytes();
+
+                std::size_t meshBytes = 0;
+                for (const MeshData &mesh : data.meshes)
+                    meshBytes += mesh.bytes();
+                const double mb = 1.0 / (1024.0 * 1024.0);
+                const std::size_t meshes = std::max<std::size_t>(data.meshes.size(), 1);
+                std::printf("  %-28s %7zu %10llu %9.3f %9llu %10.1f %9.2f %9.2f %9.2f ",
+                            fs::path(input).filename().string().c_str(), data.meshes.size(),
+                            static_cast<unsigned long long>(stats.verticesOut), stats.totalMs, AllocCounter::count(),
+                            static_cast<double>(AllocCounter::count()) / static_cast<double>(meshes),
+                            static_cast<double>(AllocCounter::bytes()) * mb,
+                            static_cast<double>(stats.parseArenaBytes + stats.scratchArenaBytes) * mb,
+                            static_cast<double>(meshBytes) * mb);
+                if (peakValid)
+                    std::printf("%9.2f\n", static_cast<double>(peak > base ? peak - base : 0) * mb);
+                else
+                    std::printf("%9s\n", "-");
+            }
+            catch (const std::exception &e)
+            {
+                std::printf("  %-28s %s\n", fs::path(input).filename().string().c_str(), e.what());
+            }
+        }
+        if (!scan.empty())
+            fs::remove(scan);
+    }
+
+    int run(const Options &opts)
+    {
+        std::FILE *csv = nullptr;
+        if (!opts.csvPath.empty())
+        {
+            csv = std::fopen(opts.csvPath.c_str(), "w");
+            if (!csv)
+            {
+                std::fprintf(stderr, "Cannot write %s\n", opts.csvPath.c_str());
+                return 2;
+            }
+            std::fprintf(csv, "input,cache,stage,ms,file_bytes,vertices,texture_bytes,allocs,alloc_bytes\n");
+        }
+
+        std::vector<std::string> files = opts.files;
+        if (files.empty())
+        {
+            std::error_code ec;
+            for (const auto &entry : fs::directory_iterator("models", ec))
+                if (entry.path().extension() == ".obj")
+                    files.push_back(entry.path().generic_string());
+            std::sort(files.begin(), files.end());
+        }
+        int failures = 0;
+        for (const std::string &file : files)
+        {
+            RunResult cold, warm;
+            bool coldValid = false;
+            if (!benchInput(file, opts, cold, warm, coldValid))
+            {
+                ++failures;
+                continue;
+            }
+            printInput(file, cold, warm, coldValid);
+            writeCsv(csv, file, "cold", cold);
+            writeCsv(csv, file, "warm", warm);
+        }
+
+        std::error_code ec;
+        const fs::path dir = fs::temp_directory_path(ec) / "import_bench";
+        fs::create_directories(dir, ec);
+        profileComparison(opts, files, dir);
+        importMemory(opts, files, dir);
+        if (opts.synthetic)
+        {
+            meshScaling(opts, dir, csv);
+            textureScaling(opts, dir, csv);
+        }
+        fs::remove_all(dir, ec);
+        if (csv)
+            std::fclose(csv);
+        return failures ? 1 : 0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options opts;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--reps") == 0 && i + 1 < argc)
+            opts.reps = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--max-vertices") == 0 && i + 1 < argc)
+            opts.maxVertices = std::max(1024, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--max-texture") == 0 && i + 1 < argc)
+            opts.maxTexture = std::max(256, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--no-gl") == 0)
+            opts.gl = false;
+        else if (std::strcmp(argv[i], "--no-synthetic") == 0)
+            opts.synthetic = false;
+        else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+            opts.csvPath = argv[++i];
+        else if (argv[i][0] != '-')
+            opts.files.push_back(argv[i]);
+        else
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+    }
+
+    GLFWwindow *window = nullptr;
+    if (opts.gl)
+    {
+        const char *backend = "";
+        std::string contextError;
+        window = createOffscreenContext(64, 64, backend, contextError);
+        if (!window)
+        {
+            std::fprintf(stderr, "No GL 3.3 context (%s), upload stages skipped\n", contextError.c_str());
+            opts.gl = false;
+        }
+        else
+        {
+            glfwMakeContextCurrent(window);
+            if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+            {
+                std::fprintf(stderr, "Failed to initialize GLAD\n");
+                return 2;
+            }
+            std::printf("GL: %s (%s)\n", reinterpret_cast<const char *>(glGetString(GL_RENDERER)), backend);
+        }
+    }
+
+    JobSystem::get().init(); // son işlem aşamaları parallelFor kullanır
+    const int result = run(opts);
+    JobSystem::get().shutdown();
+    if (window)
+        glfwDestroyWindow(window);
+    glfwTerminate();
+    return result;
+}
@@ -0,0 +1,152 @@
+// JobBench.cpp
+// Job system micro-benchmarks: empty-job throughput, parallelFor scaling
+// over worker counts and pinned-job round trips. Standalone (no GL).
+// Every run also checks that each job and parallelFor index ran exactly
+// once, with far more jobs in flight than the per-thread job pool holds.
+#include "JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double msSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Boş işler: zamanlama yükünün kendisi
+    void emptyJobs(int count)
+    {
+        JobSystem &jobs = JobSystem::get();
+        std::atomic<int> executed{0};
+        JobCounter counter{0};
+        auto start = Clock::now();
+        for (int i = 0; i < count; ++i)
+        {
+            jobs.run([&executed] { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.wait(counter);
+        double ms = msSince(start);
+        std::printf("  empty jobs     %8d jobs  %9.3f ms  %8.1f ns/job  %s\n", count, ms,
+                    ms * 1e6 / count, executed.load() == count ? "ok" : "LOST");
+    }
+
+    // Vertex dönüşümüne benzer bir yük
+    double transformWork(std::vector<float> &data, std::size_t grain)
+    {
+        auto start = Clock::now();
+        JobSystem::get().parallelFor(data.size(), [&data](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+                data[i] = std::sqrt(data[i] * 1.0001f + 0.5f) * 0.999f;
+        }, grain);
+        return msSince(start);
+    }
+
+    // Her indeks tam bir kez: küçük grain ile iş havuzundan çok daha fazla iş
+    void coverage(std::size_t count, std::size_t grain)
+    {
+        std::vector<std::atomic<unsigned char>> hits(count);
+        for (auto &hit : hits)
+            hit.store(0, std::memory_order_relaxed);
+        auto start = Clock::now();
+        JobSystem::get().parallelFor(count, [&hits](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+                hits[i].fetch_add(1, std::memory_order_relaxed);
+        }, grain);
+        double ms = msSince(start);
+        std::size_t missing = 0, repeated = 0;
+        for (auto &hit : hits)
+        {
+            const unsigned char n = hit.load(std::memory_order_relaxed);
+            missing += n == 0;
+            repeated += n > 1;
+        }
+        std::printf("  coverage       %8zu items grain %-5zu %9.3f ms  %s", count, grain, ms,
+                    missing || repeated ? "" : "ok\n");
+        if (missing || repeated)
+            std::printf("%zu MISSING, %zu REPEATED\n", missing, repeated);
+    }
+
+    void pinnedJobs(int count)
+    {
+        JobSystem &jobs = JobSystem::get();
+        const int threads = static_cast<int>(jobs.threadCount());
+        std::vector<int> wrongThread(threads, 0);
+        JobCounter counter{0};
+        auto start = Clock::now();
+        for (int i = 0; i < count; ++i)
+        {
+            int target = i % threads;
+            jobs.run([&wrongThread, target] {
+                if (JobSystem::currentThread() != target)
+                    wrongThread[target]++;
+            }, &counter, target);
+        }
+        jobs.wait(counter);
+        double ms = msSince(start);
+        int wrong = 0;
+        for (int w : wrongThread)
+            wrong += w;
+        std::printf("  pinned jobs    %8d jobs  %9.3f ms  %8.1f ns/job  %s\n", count, ms,
+                    ms * 1e6 / count, wrong == 0 ? "ok" : "WRONG THREAD");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t elements = 1 << 22;
+    unsigned int maxThreads = std::thread::hardware_concurrency();
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--elements") == 0 && i + 1 < argc)
+            elements = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--max-threads") == 0 && i + 1 < argc)
+            maxThreads = static_cast<unsigned int>(std::atoi(argv[++i]));
+    }
+    maxThreads = std::max(maxThreads, 2u);
+
+    // Toplam iş parçacığı (çağıran dahil): 2, 4, 8, ... ve en sonda maxThreads
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int t = 2; t < maxThreads; t *= 2)
+        threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    std::vector<float> data(elements, 1.0f);
+    std::printf("hardware threads: %u, parallelFor elements: %zu\n",
+                std::thread::hardware_concurrency(), elements);
+    double baseline = 0.0;
+    for (unsigned int threads : threadCounts)
+    {
+        JobSystem &jobs = JobSystem::get();
+        jobs.init(threads - 1);
+        std::printf("threads %u\n", jobs.threadCount());
+
+        emptyJobs(200000);
+        pinnedJobs(20000);
+        coverage(20000, 1);
+        coverage(elements, 64);
+
+        transformWork(data, 0); // ısınma
+        double best = 1e30;
+        for (int run = 0; run < 5; ++run)
+            best = std::min(best, transformWork(data, 0));
+        if (baseline == 0.0)
+            baseline = best;
+        std::printf("  parallelFor    auto grain  %9.3f ms  speedup %.2fx\n", best, baseline / best);
+        for (std::size_t grain : {std::size_t(64), std::size_t(4096), std::size_t(65536)})
+        {
+            double ms = transformWork(data, grain);
+            std::printf("  parallelFor    grain %-6zu %9.3f ms\n", grain, ms);
+        }
+        jobs.shutdown();
+    }
+    return 0;
+}
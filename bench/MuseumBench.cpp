@@ -0,0 +1,541 @@
+// MuseumBench.cpp
+// Offscreen, deterministic frame benchmark: loads the museum, plays a
+// scripted (or recorded) camera flythrough and the robot tour with a fixed
+// timestep and writes per-frame CPU/GPU times, percentiles, load time and
+// peak memory as JSON. --compare checks a result against a stored baseline.
+//
+//   museum_bench [--frames N] [--size WxH] [--deferred] [--prepass]
+//                [--camera-path file] [--out result.json]
+//                [--scene file] [--pack file] [--rooms N] [--exhibits N] [--lights N] [--seed N]
+//                [--baseline file] [--threshold pct] [--memory-threshold pct]
+//   museum_bench --compare result.json baseline.json [--threshold pct] ...
+//
+// The context is created without a window system where GLFW allows it
+// (3.4 null platform: EGL surfaceless, then OSMesa), so it runs on GPU-less
+// CI under llvmpipe; otherwise a hidden window is used. Run it from the
+// directory holding shaders/ and models/, like VirtualMuseum.
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include "Renderer.h"
+#include "RenderTarget.h"
+#include "Scene.h"
+#include "MuseumGenerator.h"
+#include "SceneFile.h"
+#include "AssetPack.h"
+#include "Robot.h"
+#include "Transform.h"
+#include "Frustum.h"
+#include "JobSystem.h"
+#include "GpuProfiler.h"
+#include "RenderCounters.h"
+#include "ProcessMemory.h"
+#include "OffscreenContext.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr double SIM_DT = 1.0 / 60.0;
+    constexpr int FRAMES_IN_FLIGHT = 2;
+    constexpr double MIN_DELTA_MS = 0.1; // bunun altındaki farklar gürültü sayılır
+
+    double msSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    struct CameraKey
+    {
+        double time;
+        glm::vec3 eye, target;
+        float fov;
+    };
+
+    // Kayıtlı yol: "zaman eye.xyz target.xyz [fov]" satırları, '#' yorum
+    bool loadCameraPath(const std::string &path, std::vector<CameraKey> &keys)
+    {
+        std::ifstream in(path);
+        if (!in)
+            return false;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+            std::istringstream fields(line);
+            CameraKey key{};
+            key.fov = 45.0f;
+            if (!(fields >> key.time >> key.eye.x >> key.eye.y >> key.eye.z >> key.target.x >> key.target.y >>
+                  key.target.z))
+                continue;
+            fields >> key.fov;
+            keys.push_back(key);
+        }
+        std::sort(keys.begin(), keys.end(), [](const CameraKey &a, const CameraKey &b) { return a.time < b.time; });
+        return !keys.empty();
+    }
+
+    CameraKey sampleCameraPath(const std::vector<CameraKey> &keys, double time)
+    {
+        if (time <= keys.front().time)
+            return keys.front();
+        if (time >= keys.back().time)
+            return keys.back();
+        auto next = std::upper_bound(keys.begin(), keys.end(), time,
+                                     [](double t, const CameraKey &k) { return t < k.time; });
+        const CameraKey &b = *next, &a = *(next - 1);
+        float f = static_cast<float>((time - a.time) / (b.time - a.time));
+        return {time, glm::mix(a.eye, b.eye, f), glm::mix(a.target, b.target, f), a.fov + (b.fov - a.fov) * f};
+    }
+
+    // Yazılı yol: sahne etrafında bir tur, yükselip alçalarak ve yaklaşıp uzaklaşarak
+    CameraKey scriptedCamera(const glm::vec3 &center, float radius, double t, double duration)
+    {
+        const double phase = t / duration;
+        const float angle = static_cast<float>(phase * 2.0 * 3.14159265358979);
+        const float distance = radius * (1.1f + 0.4f * std::cos(angle * 2.0f));
+        const float height = radius * (0.25f + 0.2f * std::sin(angle));
+        glm::vec3 eye = center + glm::vec3(std::cos(angle) * distance, height, std::sin(angle) * distance);
+        return {t, eye, center, 45.0f};
+    }
+
+    struct Summary
+    {
+        double mean = 0.0, p50 = 0.0, p95 = 0.0, p99 = 0.0, max = 0.0;
+    };
+
+    Summary summarize(std::vector<double> values)
+    {
+        Summary s;
+        if (values.empty())
+            return s;
+        std::sort(values.begin(), values.end());
+        auto percentile = [&](double p) { return values[static_cast<std::size_t>(p * (values.size() - 1) + 0.5)]; };
+        for (double v : values)
+            s.mean += v;
+        s.mean /= static_cast<double>(values.size());
+        s.p50 = percentile(0.50);
+        s.p95 = percentile(0.95);
+        s.p99 = percentile(0.99);
+        s.max = values.back();
+        return s;
+    }
+
+    void writeSummary(std::FILE *f, const char *prefix, const Summary &s)
+    {
+        std::fprintf(f, "    \"%s_mean_ms\": %.4f,\n    \"%s_p50_ms\": %.4f,\n    \"%s_p95_ms\": %.4f,\n"
+                        "    \"%s_p99_ms\": %.4f,\n    \"%s_max_ms\": %.4f",
+                     prefix, s.mean, prefix, s.p50, prefix, s.p95, prefix, s.p99, prefix, s.max);
+    }
+
+    void writeArray(std::FILE *f, const char *name, const std::vector<double> &values)
+    {
+        std::fprintf(f, "  \"%s\": [", name);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            std::fprintf(f, "%s%.4f", i ? (i % 10 ? ", " : ",\n    ") : "", values[i]);
+        std::fprintf(f, "],\n");
+    }
+
+    // Sonuç dosyasını bu program yazar: anahtarlar belgede tekil, düz arama yeter
+    bool readNumber(const std::string &json, const char *key, double &value)
+    {
+        std::string needle = std::string("\"") + key + "\":";
+        std::size_t at = json.find(needle);
+        if (at == std::string::npos)
+            return false;
+        value = std::strtod(json.c_str() + at + needle.size(), nullptr);
+        return true;
+    }
+
+    std::string readString(const std::string &json, const char *key)
+    {
+        std::string needle = std::string("\"") + key + "\": \"";
+        std::size_t at = json.find(needle);
+        if (at == std::string::npos)
+            return std::string();
+        at += needle.size();
+        return json.substr(at, json.find('"', at) - at);
+    }
+
+    bool readFile(const char *path, std::string &text)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return false;
+        std::ostringstream buffer;
+        buffer << in.rdbuf();
+        text = buffer.str();
+        return true;
+    }
+
+    std::string jsonEscape(const char *text)
+    {
+        std::string out;
+        for (; *text; ++text)
+        {
+            if (*text == '"' || *text == '\\')
+                out += '\\';
+            out += *text;
+        }
+        return out;
+    }
+
+    struct Thresholds
+    {
+        double timePct = 10.0;
+        double memoryPct = 10.0;
+    };
+
+    // 0: gerileme yok, 1: gerileme, 2: dosya okunamadı
+    int compareResults(const char *currentPath, const char *baselinePath, const Thresholds &thresholds)
+    {
+        std::string current, baseline;
+        if (!readFile(currentPath, current) || !readFile(baselinePath, baseline))
+        {
+            std::fprintf(stderr, "compare: cannot read %s or %s\n", currentPath, baselinePath);
+            return 2;
+        }
+        for (const char *key : {"config", "gl_renderer"})
+        {
+            std::string a = readString(current, key), b = readString(baseline, key);
+            if (a != b)
+                std::printf("warning: %s differs (current \"%s\", baseline \"%s\")\n", key, a.c_str(), b.c_str());
+        }
+
+        const struct
+        {
+            const char *key;
+            bool memory;
+        } metrics[] = {
+            {"cpu_p50_ms", false}, {"cpu_p95_ms", false}, {"cpu_p99_ms", false},
+            {"gpu_p50_ms", false}, {"gpu_p95_ms", false}, {"gpu_p99_ms", false},
+            {"load_ms", false},    {"peak_rss_bytes", true},
+        };
+        std::printf("%-16s %14s %14s %9s  %s\n", "metric", "baseline", "current", "change", "result");
+        int regressions = 0;
+        for (const auto &metric : metrics)
+        {
+            double a = 0.0, b = 0.0;
+            if (!readNumber(current, metric.key, a) || !readNumber(baseline, metric.key, b))
+            {
+                std::printf("%-16s %14s %14s %9s  missing\n", metric.key, "-", "-", "-");
+                continue;
+            }
+            const double limit = metric.memory ? thresholds.memoryPct : thresholds.timePct;
+            const double change = b > 0.0 ? (a - b) / b * 100.0 : 0.0;
+            const bool noise = !metric.memory && std::fabs(a - b) < MIN_DELTA_MS;
+            const bool regressed = change > limit && !noise;
+            regressions += regressed ? 1 : 0;
+            std::printf("%-16s %14.3f %14.3f %+8.1f%%  %s\n", metric.key, b, a, change,
+                        regressed ? "REGRESSION" : (change < -limit && !noise ? "improved" : "ok"));
+        }
+        std::printf("%d regression(s) (thresholds: time %.1f%%, memory %.1f%%)\n", regressions, thresholds.timePct,
+                    thresholds.memoryPct);
+        return regressions ? 1 : 0;
+    }
+
+    struct Options
+    {
+        int frames = 600, width = 1280, height = 720;
+        bool deferred = false, prepass = false;
+        std::string cameraPathFile, outPath = "bench_result.json";
+        std::vector<CameraKey> cameraKeys;
+        std::string scenePath = DEFAULT_SCENE_PATH;
+        std::string packPath; // museum_cook çıktısı; --scene verilmediyse sahne de buradan
+        bool sceneGiven = false;
+        bool generate = false; // true: sahne dosyasının modelleriyle üretilmiş müze
+        MuseumParams museum;
+    };
+
+    // GL nesneleri bu fonksiyonun sonunda, bağlam hâlâ geçerliyken silinir
+    int run(const Options &opts, const char *backend)
+    {
+        const int frames = opts.frames, width = opts.width, height = opts.height;
+        const char *glRenderer = reinterpret_cast<const char *>(glGetString(GL_RENDERER));
+        std::printf("context: %s, %s\n", backend, glRenderer ? glRenderer : "?");
+        glEnable(GL_DEPTH_TEST);
+
+        // ---------- Yükleme --------------------------------------------
+        auto loadStart = Clock::now();
+        RenderSettings settings;
+        settings.path = opts.deferred ? RenderPath::Deferred : RenderPath::Forward;
+        settings.depthPrepass = opts.prepass;
+        settings.dynamicResolution = false;
+        RenderStats stats;
+        Renderer renderer(settings, stats);
+        SceneDesc desc;
+        std::string sceneError;
+        AssetPack pack;
+        if (!opts.packPath.empty() && !pack.mount(opts.packPath, sceneError))
+        {
+            std::fprintf(stderr, "%s\n", sceneError.c_str());
+            return 2;
+        }
+        const bool fromPack = pack.isMounted() && !opts.sceneGiven;
+        if (fromPack ? !pack.loadScene(desc, sceneError) : !loadSceneFile(opts.scenePath, desc, sceneError))
+        {
+            std::fprintf(stderr, "%s\n", sceneError.c_str());
+            return 2;
+        }
+        if (opts.generate)
+            desc = generateMuseum(opts.museum, desc.models);
+        Scene scene;
+        scene.init(desc, pack.isMounted() ? &pack : nullptr);
+        pack.unmount();
+        Robot robot;
+        robot.setPath(scene.tourStops());
+        RenderTarget target;
+        target.resize(width, height);
+        glFinish();
+        const double loadMs = msSince(loadStart);
+
+        glm::vec3 center;
+        float radius;
+        scene.getSceneBounds(center, radius);
+        const double duration = frames * SIM_DT;
+
+        // Her frame'in GPU süresi: sorgular baştan ayrılır, sonuçlar en sonda okunur
+        std::vector<unsigned int> queries(static_cast<std::size_t>(frames) * 2);
+        glGenQueries(static_cast<GLsizei>(queries.size()), queries.data());
+        GLsync fences[FRAMES_IN_FLIGHT] = {nullptr};
+        std::vector<double> cpuMs(frames), gpuMs(frames);
+        std::vector<std::uint32_t> visible;
+        unsigned long long drawCalls = 0, triangles = 0, visibleModels = 0;
+
+        // ---------- Frame döngüsü --------------------------------------
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            // Kuyrukta en fazla FRAMES_IN_FLIGHT frame; bekleme CPU süresine sayılmaz
+            GLsync &fence = fences[frame % FRAMES_IN_FLIGHT];
+            if (fence)
+            {
+                glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+
+            auto cpuStart = Clock::now();
+            JobSystem::get().beginFrame();
+            const double t = frame * SIM_DT;
+            robot.update(static_cast<float>(SIM_DT));
+            robot.syncTransform();
+            TransformSystem::get().update();
+
+            CameraKey camera = opts.cameraKeys.empty() ? scriptedCamera(center, radius, t, duration)
+                                                       : sampleCameraPath(opts.cameraKeys, t);
+            FrameView view;
+            view.width = width;
+            view.height = height;
+            view.targetFramebuffer = target.framebuffer();
+            view.cameraPos = camera.eye;
+            view.view = glm::lookAt(camera.eye, camera.target, glm::vec3(0.0f, 1.0f, 0.0f));
+            view.projection = glm::perspective(glm::radians(camera.fov), float(width) / float(height), radius * 0.01f,
+                                               glm::length(camera.eye - center) + radius * 2.0f);
+            cullSpheres(Frustum::fromMatrix(view.projection * view.view), scene.getModelBounds(), visible);
+            view.visibleModels = &visible;
+            visibleModels += visible.size();
+
+            GpuProfiler::get().beginFrame();
+            glQueryCounter(queries[frame * 2], GL_TIMESTAMP);
+            renderer.render(scene, robot, view);
+            glQueryCounter(queries[frame * 2 + 1], GL_TIMESTAMP);
+            GpuProfiler::get().endFrame();
+            fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+            cpuMs[frame] = msSince(cpuStart);
+
+            RenderCounters::Frame counts = RenderCounters::endFrame();
+            drawCalls += counts.drawCalls;
+            triangles += counts.triangles;
+        }
+        glFinish();
+        for (GLsync fence : fences)
+            if (fence)
+                glDeleteSync(fence);
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            GLuint64 begin = 0, end = 0;
+            glGetQueryObjectui64v(queries[frame * 2], GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(queries[frame * 2 + 1], GL_QUERY_RESULT, &end);
+            gpuMs[frame] = end > begin ? static_cast<double>(end - begin) * 1e-6 : 0.0;
+        }
+        glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+
+        // ---------- Sonuç ----------------------------------------------
+        const Summary cpu = summarize(cpuMs), gpu = summarize(gpuMs);
+        // Forward yol MAX_SPOT_LIGHTS'tan fazlasını çizmez
+        const std::size_t lightCount = scene.getLights().size();
+        const std::size_t lightsDropped =
+            !opts.deferred && lightCount > static_cast<std::size_t>(MAX_SPOT_LIGHTS) ? lightCount - MAX_SPOT_LIGHTS : 0;
+        char museum[160];
+        std::snprintf(museum, sizeof(museum), "scene %s", opts.scenePath.c_str());
+        if (!opts.packPath.empty() && opts.sceneGiven)
+            std::snprintf(museum, sizeof(museum), "scene %s, pack %s", opts.scenePath.c_str(), opts.packPath.c_str());
+        else if (!opts.packPath.empty())
+            std::snprintf(museum, sizeof(museum), "pack %s", opts.packPath.c_str());
+        if (opts.generate)
+            std::snprintf(museum, sizeof(museum), "museum %d rooms/%d exhibits/%d lights seed %u", opts.museum.rooms,
+                          opts.museum.exhibits, opts.museum.lights, opts.museum.seed);
+        char config[384];
+        std::snprintf(config, sizeof(config), "%dx%d %s%s, %d frames, camera %s, %s", width, height,
+                      opts.deferred ? "deferred" : "forward", opts.prepass ? " + prepass" : "", frames,
+                      opts.cameraPathFile.empty() ? "scripted" : opts.cameraPathFile.c_str(), museum);
+
+        std::FILE *f = std::fopen(opts.outPath.c_str(), "w");
+        if (!f)
+        {
+            std::fprintf(stderr, "Cannot write %s\n", opts.outPath.c_str());
+            return 2;
+        }
+        std::fprintf(f, "{\n  \"version\": 1,\n  \"config\": \"%s\",\n  \"context\": \"%s\",\n",
+                     jsonEscape(config).c_str(), backend);
+        std::fprintf(f, "  \"gl_renderer\": \"%s\",\n", jsonEscape(glRenderer ? glRenderer : "").c_str());
+        std::fprintf(f, "  \"load_ms\": %.3f,\n  \"peak_rss_bytes\": %zu,\n", loadMs, ProcessMemory::peakResidentBytes());
+        std::fprintf(f, "  \"vram_estimate_bytes\": %lld,\n",
+                     static_cast<long long>(RenderCounters::textureMemory() + RenderCounters::bufferMemory()));
+        std::fprintf(f, "  \"draw_calls_per_frame\": %.1f,\n  \"triangles_per_frame\": %.1f,\n",
+                     double(drawCalls) / frames, double(triangles) / frames);
+        std::fprintf(f, "  \"exhibits\": %zu,\n  \"lights\": %zu,\n  \"lights_dropped\": %zu,\n",
+                     scene.getModelBounds().size(), lightCount, lightsDropped);
+        std::fprintf(f, "  \"visible_exhibits_per_frame\": %.1f,\n", double(visibleModels) / frames);
+        std::fprintf(f, "  \"summary\": {\n");
+        writeSummary(f, "cpu", cpu);
+        std::fprintf(f, ",\n");
+        writeSummary(f, "gpu", gpu);
+        std::fprintf(f, "\n  },\n  \"gpu_passes\": {");
+        GpuPassStats passes[MAX_GPU_PASSES];
+        int passCount = GpuProfiler::get().snapshot(passes, MAX_GPU_PASSES);
+        for (int i = 0; i < passCount; ++i)
+            std::fprintf(f, "%s\n    \"%s\": {\"avg\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f}", i ? "," : "",
+                         passes[i].name, passes[i].avgMs, passes[i].p50Ms, passes[i].p95Ms, passes[i].p99Ms);
+        std::fprintf(f, "\n  },\n");
+        writeArray(f, "frame_cpu_ms", cpuMs);
+        writeArray(f, "frame_gpu_ms", gpuMs);
+        std::fprintf(f, "  \"frames\": %d\n}\n", frames);
+        std::fclose(f);
+
+        std::printf("%s\nload %.1f ms, peak RSS %.1f MB\n", config, loadMs,
+                    ProcessMemory::peakResidentBytes() / (1024.0 * 1024.0));
+        std::printf("cpu ms: mean %.3f  p50 %.3f  p95 %.3f  p99 %.3f  max %.3f\n", cpu.mean, cpu.p50, cpu.p95, cpu.p99,
+                    cpu.max);
+        std::printf("gpu ms: mean %.3f  p50 %.3f  p95 %.3f  p99 %.3f  max %.3f\n", gpu.mean, gpu.p50, gpu.p95, gpu.p99,
+                    gpu.max);
+        if (lightsDropped)
+            std::printf("warning: forward path drew %d of %zu lights (%zu dropped); use --deferred\n",
+                        MAX_SPOT_LIGHTS, lightCount, lightsDropped);
+        std::printf("results written to %s\n", opts.outPath.c_str());
+
+        GpuProfiler::get().shutdown();
+        return 0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options opts;
+    std::string baselinePath;
+    const char *compareA = nullptr, *compareB = nullptr;
+    Thresholds thresholds;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            opts.frames = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc)
+            std::sscanf(argv[++i], "%dx%d", &opts.width, &opts.height);
+        else if (std::strcmp(argv[i], "--deferred") == 0)
+            opts.deferred = true;
+        else if (std::strcmp(argv[i], "--prepass") == 0)
+            opts.prepass = true;
+        else if (std::strcmp(argv[i], "--camera-path") == 0 && i + 1 < argc)
+            opts.cameraPathFile = argv[++i];
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            opts.outPath = argv[++i];
+        else if (std::strcmp(argv[i], "--scene") == 0 && i + 1 < argc)
+        {
+            opts.scenePath = argv[++i];
+            opts.sceneGiven = true;
+        }
+        else if (std::strcmp(argv[i], "--pack") == 0 && i + 1 < argc)
+            opts.packPath = argv[++i];
+        else if (std::strcmp(argv[i], "--rooms") == 0 && i + 1 < argc)
+        {
+            opts.generate = true;
+            opts.museum.rooms = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--exhibits") == 0 && i + 1 < argc)
+        {
+            opts.generate = true;
+            opts.museum.exhibits = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--lights") == 0 && i + 1 < argc)
+        {
+            opts.generate = true;
+            opts.museum.lights = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            opts.generate = true;
+            opts.museum.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+            baselinePath = argv[++i];
+        else if (std::strcmp(argv[i], "--compare") == 0 && i + 2 < argc)
+        {
+            compareA = argv[++i];
+            compareB = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+            thresholds.timePct = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--memory-threshold") == 0 && i + 1 < argc)
+            thresholds.memoryPct = std::atof(argv[++i]);
+        else
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+    }
+    if (compareA)
+        return compareResults(compareA, compareB, thresholds);
+    opts.width = std::max(opts.width, 16);
+    opts.height = std::max(opts.height, 16);
+    if (!opts.cameraPathFile.empty() && !loadCameraPath(opts.cameraPathFile, opts.cameraKeys))
+    {
+        std::fprintf(stderr, "Cannot read camera path %s\n", opts.cameraPathFile.c_str());
+        return 2;
+    }
+
+    const char *backend = "";
+    std::string contextError;
+    GLFWwindow *window = createOffscreenContext(opts.width, opts.height, backend, contextError);
+    if (!window)
+    {
+        std::fprintf(stderr, "No GL 3.3 context: %s\n", contextError.c_str());
+        glfwTerminate();
+        return 2;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        std::fprintf(stderr, "Failed to initialize GLAD\n");
+        return 2;
+    }
+
+    JobSystem::get().init();
+    int result = run(opts, backend);
+    JobSystem::get().shutdown();
+    if (result == 0 && !baselinePath.empty())
+        result = compareResults(opts.outPath.c_str(), baselinePath.c_str(), thresholds);
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return result;
+}
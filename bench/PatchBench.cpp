@@ -0,0 +1,446 @@
+// PatchBench.cpp
+// Pack delta updates (PackPatch.h): patch size against the full new pack,
+// diff time and apply throughput for typical curator edits on a synthetic
+// museum pack, or for two real packs.
+//
+//   patch_bench [--models N] [--textures N] [--texture-size N] [--vertices N]
+//   patch_bench old.vmpack new.vmpack
+//
+// Apply streams the patch from disk in 64 KB reads into a copy of the old
+// pack, like a kiosk would; "max alloc" is the largest single operator new
+// during apply (AllocCounter), showing memory stays bounded. Each patch is
+// also applied fed in 1-byte and odd-sized pieces (PackPatcher), which must
+// give the same pack. A pack with several thousand entries is written and
+// read back, checking every entry's hash and every model and texture.
+#include "AssetPack.h"
+#include "PackPatch.h"
+#include "AllocCounter.h"
+#include "JobSystem.h"
+#include "MuseumGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        int models = 24;
+        int textures = 24;
+        int textureSize = 1024;
+        int vertices = 40000;
+    };
+
+    struct Texture
+    {
+        std::string path;
+        int size = 0;
+        std::vector<unsigned char> pixels; // RGB
+    };
+
+    struct Museum
+    {
+        SceneDesc desc;
+        std::vector<ModelData> models;
+        std::vector<Texture> textures;
+    };
+
+    double msSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    double megabytes(std::uint64_t bytes)
+    {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+    std::uint32_t mix(std::uint32_t x)
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352dU;
+        x ^= x >> 15;
+        x *= 0x846ca68bU;
+        return x ^ (x >> 16);
+    }
+
+    // Taranmış heykel benzeri: dalgalı ızgara, gerçek veri gibi kısmen sıkışır
+    ModelData makeModel(const std::string &path, int vertices, std::uint32_t seed)
+    {
+        ModelData data;
+        data.path = path;
+        const int side = std::max(2, static_cast<int>(std::sqrt(static_cast<double>(vertices))));
+        MeshData mesh;
+        mesh.allocate(static_cast<std::size_t>(side) * side, static_cast<std::size_t>(side - 1) * (side - 1) * 6);
+        Vertex *vertex = mesh.vertices.data();
+        for (int z = 0; z < side; ++z)
+        {
+            for (int x = 0; x < side; ++x)
+            {
+                const float u = static_cast<float>(x) / (side - 1), v = static_cast<float>(z) / (side - 1);
+                const float noise = static_cast<float>(mix(seed ^ (z * side + x)) & 0xFF) / 255.0f * 0.002f;
+                vertex->Position = glm::vec3(u - 0.5f, std::sin(u * 9.0f + seed) * std::cos(v * 7.0f) * 0.2f + noise, v);
+                vertex->Normal = glm::vec3(0.0f, 1.0f, 0.0f);
+                vertex->TexCoords = glm::vec2(u, v);
+                ++vertex;
+            }
+        }
+        unsigned int *index = mesh.indices.data();
+        for (int z = 0; z + 1 < side; ++z)
+        {
+            for (int x = 0; x + 1 < side; ++x)
+            {
+                const unsigned int i = z * side + x, quad[6] = {i, i + side, i + 1, i + 1, i + side, i + side + 1};
+                index = std::copy(quad, quad + 6, index);
+            }
+        }
+        data.meshes.push_back(std::move(mesh));
+        ImportedMaterial material;
+        material.name = path + "/material";
+        data.materials.push_back(material);
+        data.bbMin = glm::vec3(-0.5f, -0.2f, 0.0f);
+        data.bbMax = glm::vec3(0.5f, 0.2f, 1.0f);
+        return data;
+    }
+
+    Texture makeTexture(const std::string &path, int size, std::uint32_t seed)
+    {
+        Texture texture{path, size, std::vector<unsigned char>(static_cast<std::size_t>(size) * size * 3)};
+        for (int y = 0; y < size; ++y)
+        {
+            for (int x = 0; x < size; ++x)
+            {
+                unsigned char *p = &texture.pixels[(static_cast<std::size_t>(y) * size + x) * 3];
+                const std::uint32_t n = mix(seed ^ ((y / 4) * size + x / 4)) & 0x1F;
+                p[0] = static_cast<unsigned char>((x * 255 / size + n) & 0xFF);
+                p[1] = static_cast<unsigned char>((y * 255 / size + n) & 0xFF);
+                p[2] = static_cast<unsigned char>((seed * 37 + n) & 0xFF);
+            }
+        }
+        return texture;
+    }
+
+    Museum makeMuseum(const Options &opts)
+    {
+        Museum museum;
+        std::vector<ModelDesc> modelDescs;
+        for (int i = 0; i < opts.models; ++i)
+        {
+            const std::string path = "models/exhibit" + std::to_string(i) + "/exhibit.obj";
+            museum.models.push_back(makeModel(path, opts.vertices, static_cast<std::uint32_t>(i)));
+            modelDescs.push_back({path, "Exhibit " + std::to_string(i), ImportProfile()});
+            if (i < opts.textures)
+            {
+                const std::string texture = "models/exhibit" + std::to_string(i) + "/diffuse.png";
+                museum.models.back().materials[0].diffuseTexture = texture;
+                museum.textures.push_back(makeTexture(texture, opts.textureSize, static_cast<std::uint32_t>(i)));
+            }
+        }
+        MuseumParams params;
+        params.exhibits = opts.models * 4;
+        museum.desc = generateMuseum(params, modelDescs);
+        return museum;
+    }
+
+    bool writePack(const Museum &museum, const std::string &path, std::string &error)
+    {
+        PackWriter writer;
+        writer.addScene(museum.desc);
+        for (const ModelData &model : museum.models)
+            writer.addModel(model);
+        for (const Texture &texture : museum.textures)
+            writer.addTexture(texture.path, texture.pixels.data(), texture.size, texture.size, 3);
+        PackStats stats;
+        return writer.write(path, true, stats, error);
+    }
+
+    bool sameFile(const std::string &a, const std::string &b)
+    {
+        std::ifstream fa(a, std::ios::binary), fb(b, std::ios::binary);
+        std::vector<char> ba((std::istreambuf_iterator<char>(fa)), std::istreambuf_iterator<char>());
+        std::vector<char> bb((std::istreambuf_iterator<char>(fb)), std::istreambuf_iterator<char>());
+        return ba == bb;
+    }
+
+    void printHeader()
+    {
+        std::printf("%-16s %10s %10s %7s %14s %9s %9s %11s %10s\n", "scenario", "new pack", "patch", "ratio",
+                    "reused/changed", "diff ms", "apply ms", "apply MB/s", "max alloc");
+    }
+
+    std::uint64_t fnv1a(const std::vector<unsigned char> &bytes)
+    {
+        std::uint64_t hash = 1469598103934665603ull;
+        for (unsigned char b : bytes)
+        {
+            hash ^= b;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // İş havuzundan çok daha fazla girdi: PackWriter'ın paralel özet ve
+    // sıkıştırma işleri her girdiyi tam bir kez işlemeli
+    bool largePack(const fs::path &dir)
+    {
+        const int models = 2500, textures = 600, textureSize = 16;
+        std::vector<ModelData> sources;
+        std::vector<Texture> images;
+        PackWriter writer;
+        for (int i = 0; i < models; ++i)
+        {
+            sources.push_back(makeModel("models/small" + std::to_string(i) + "/small.obj", 16,
+                                        static_cast<std::uint32_t>(i)));
+            writer.addModel(sources.back());
+        }
+        for (int i = 0; i < textures; ++i)
+        {
+            images.push_back(makeTexture("textures/small" + std::to_string(i) + ".png", textureSize,
+                                         static_cast<std::uint32_t>(i)));
+            writer.addTexture(images.back().path, images.back().pixels.data(), textureSize, textureSize, 3);
+        }
+        const std::string path = (dir / "large.vmpack").string();
+        PackStats stats;
+        std::string error;
+        AssetPack pack;
+        if (!writer.write(path, true, stats, error) || !pack.mount(path, error))
+        {
+            std::fprintf(stderr, "large pack: %s\n", error.c_str());
+            return false;
+        }
+
+        std::size_t badHashes = 0, badModels = 0, badTextures = 0;
+        std::vector<unsigned char> bytes;
+        for (std::size_t i = 0; i < pack.entryCount(); ++i)
+        {
+            const PackEntry &entry = pack.entry(i);
+            bytes.resize(static_cast<std::size_t>(entry.rawSize));
+            if (!pack.read(entry, bytes.data(), error) || fnv1a(bytes) != entry.hash)
+                ++badHashes;
+        }
+        for (const ModelData &source : sources)
+        {
+            ModelData loaded;
+            bool same = pack.loadModel(source.path, loaded, error) && loaded.meshes.size() == source.meshes.size();
+            for (std::size_t m = 0; same && m < loaded.meshes.size(); ++m)
+                same = sameBytes(loaded.meshes[m].vertices, source.meshes[m].vertices) &&
+                       sameBytes(loaded.meshes[m].indices, source.meshes[m].indices);
+            badModels += !same;
+        }
+        for (const Texture &image : images)
+        {
+            TextureData loaded;
+            badTextures += !pack.loadTexture(image.path, loaded, error) || loaded.width != textureSize ||
+                           std::memcmp(loaded.pixels, image.pixels.data(), image.pixels.size()) != 0;
+        }
+        const bool ok = !badHashes && !badModels && !badTextures;
+        std::printf("large pack: %zu entries, %d models, %d textures: ", pack.entryCount(), models, textures);
+        if (ok)
+            std::printf("all read back\n");
+        else
+            std::printf("%zu BAD HASHES, %zu BAD MODELS, %zu BAD TEXTURES\n", badHashes, badModels, badTextures);
+        return ok;
+    }
+
+    // Yamayı bellekten 1 baytlık ya da tek sayılı, değişen boylarda parçalarla besle
+    bool applyInPieces(const std::string &packPath, const std::string &patchPath, bool singleBytes,
+                       std::string &error)
+    {
+        static const std::size_t ODD_SIZES[] = {1, 3, 7, 13, 61, 509, 4093};
+        std::ifstream in(patchPath, std::ios::binary);
+        const std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        PackPatcher patcher;
+        if (!patcher.begin(packPath, error))
+            return false;
+        std::size_t at = 0;
+        for (std::size_t n = 0; at < bytes.size(); ++n)
+        {
+            const std::size_t piece = singleBytes ? 1 : ODD_SIZES[n % (sizeof(ODD_SIZES) / sizeof(ODD_SIZES[0]))];
+            const std::size_t size = std::min(bytes.size() - at, piece);
+            if (!patcher.feed(reinterpret_cast<const unsigned char *>(bytes.data()) + at, size, error))
+                return false;
+            at += size;
+        }
+        return patcher.finish(error);
+    }
+
+    // Yama üret, eski paketin kopyasına uygula, sonucu yeni paketle karşılaştır
+    bool measure(const char *name, const std::string &oldPack, const std::string &newPack, const fs::path &dir)
+    {
+        const std::string patch = (dir / "update.vmpatch").string();
+        const std::string work = (dir / "kiosk.vmpack").string();
+        std::string error;
+        PatchStats stats;
+        auto diffStart = Clock::now();
+        if (!createPackPatch(oldPack, newPack, patch, stats, error))
+        {
+            std::fprintf(stderr, "%s: %s\n", name, error.c_str());
+            return false;
+        }
+        const double diffMs = msSince(diffStart);
+
+        std::error_code ec;
+        fs::copy_file(oldPack, work, fs::copy_options::overwrite_existing, ec);
+        AllocCounter::reset();
+        AllocCounter::enable();
+        auto applyStart = Clock::now();
+        const bool applied = applyPackPatch(work, patch, error);
+        const double applyMs = msSince(applyStart);
+        AllocCounter::disable();
+        if (!applied)
+        {
+            std::fprintf(stderr, "%s: apply failed: %s\n", name, error.c_str());
+            return false;
+        }
+        const bool identical = sameFile(work, newPack);
+        bool pieces = true;
+        for (bool singleBytes : {true, false})
+        {
+            fs::copy_file(oldPack, work, fs::copy_options::overwrite_existing, ec);
+            if (!applyInPieces(work, patch, singleBytes, error) || !sameFile(work, newPack))
+            {
+                std::fprintf(stderr, "%s: apply in %s pieces failed: %s\n", name, singleBytes ? "1-byte" : "odd-sized",
+                             error.c_str());
+                pieces = false;
+            }
+        }
+        char reuse[32];
+        std::snprintf(reuse, sizeof(reuse), "%zu/%zu", stats.payloadsReused, stats.payloadsChunked);
+        std::printf("%-16s %8.2f MB %7.3f MB %6.2f%% %14s %9.1f %9.1f %11.0f %7zu KB%s%s\n", name,
+                    megabytes(stats.newSize), megabytes(stats.patchSize),
+                    100.0 * static_cast<double>(stats.patchSize) / static_cast<double>(stats.newSize), reuse, diffMs,
+                    applyMs, megabytes(stats.newSize) / (applyMs * 1e-3), AllocCounter::largest() / 1024,
+                    identical ? "" : "  MISMATCH", pieces ? "" : "  PIECES MISMATCH");
+        return identical && pieces;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options opts;
+    std::vector<std::string> packs;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--models") == 0 && i + 1 < argc)
+            opts.models = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--textures") == 0 && i + 1 < argc)
+            opts.textures = std::max(0, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--texture-size") == 0 && i + 1 < argc)
+            opts.textureSize = std::max(16, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--vertices") == 0 && i + 1 < argc)
+            opts.vertices = std::max(4, std::atoi(argv[++i]));
+        else if (argv[i][0] != '-')
+            packs.push_back(argv[i]);
+        else
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+    }
+    JobSystem::get().init();
+
+    std::error_code ec;
+    const fs::path dir = fs::temp_directory_path(ec) / "patch_bench";
+    fs::create_directories(dir, ec);
+    bool ok = true;
+    if (packs.size() == 2)
+    {
+        printHeader();
+        ok = measure("packs", packs[0], packs[1], dir);
+        fs::remove_all(dir, ec);
+        return ok ? 0 : 1;
+    }
+
+    const Museum base = makeMuseum(opts);
+    const std::string basePack = (dir / "base.vmpack").string();
+    const std::string newPack = (dir / "new.vmpack").string();
+    std::string error;
+    if (!writePack(base, basePack, error))
+    {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 2;
+    }
+    std::printf("%d models x %d vertices, %d textures %dx%d\n", opts.models, opts.vertices, opts.textures,
+                opts.textureSize, opts.textureSize);
+    printHeader();
+
+    struct Scenario
+    {
+        const char *name;
+        void (*edit)(Museum &museum);
+    };
+    const Scenario scenarios[] = {
+        {"unchanged", [](Museum &) {}},
+        {"exhibit moved", [](Museum &m)
+         { m.desc.exhibits[0].position += glm::vec2(0.5f, 0.0f); }},
+        {"texture retouch", [](Museum &m)
+         {
+             if (m.textures.empty())
+                 return;
+             Texture &t = m.textures[0];
+             for (int y = t.size / 4; y < t.size / 4 + t.size / 16; ++y)
+                 for (int x = 0; x < t.size / 16 * 3; ++x)
+                     t.pixels[static_cast<std::size_t>(y) * t.size * 3 + x] ^= 0x40;
+         }},
+        {"mesh fix", [](Museum &m)
+         {
+             const ArrayView<Vertex> v = m.models[0].meshes[0].vertices;
+             for (std::size_t i = v.size() / 2; i < v.size() / 2 + 200 && i < v.size(); ++i)
+                 v[i].Position.y += 0.01f;
+         }},
+        {"exhibit added", [](Museum &m)
+         {
+             const std::string path = "models/new_exhibit/exhibit.obj";
+             m.models.push_back(makeModel(path, 20000, 999));
+             m.desc.models.push_back({path, "New exhibit", ImportProfile()});
+             ExhibitDesc exhibit = m.desc.exhibits[0];
+             exhibit.model = static_cast<std::uint32_t>(m.desc.models.size() - 1);
+             m.desc.exhibits.push_back(exhibit);
+         }},
+        {"all retextured", [](Museum &m)
+         {
+             for (std::size_t i = 0; i < m.textures.size(); ++i)
+                 m.textures[i] = makeTexture(m.textures[i].path, m.textures[i].size, static_cast<std::uint32_t>(i + 500));
+         }},
+    };
+    for (const Scenario &scenario : scenarios)
+    {
+        Museum edited = base;
+        scenario.edit(edited);
+        if (!writePack(edited, newPack, error))
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 2;
+        }
+        ok &= measure(scenario.name, basePack, newPack, dir);
+    }
+    ok &= largePack(dir);
+
+    // Bütünlük: bozuk yama ve yanlış taban paket reddedilmeli, paket olduğu gibi kalmalı
+    const std::string patch = (dir / "update.vmpatch").string();
+    const std::string work = (dir / "kiosk.vmpack").string();
+    fs::copy_file(basePack, work, fs::copy_options::overwrite_existing, ec);
+    {
+        std::fstream f(patch, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(static_cast<std::streamoff>(fs::file_size(patch, ec) / 2));
+        f.put('\x5A');
+    }
+    const bool corruptRejected = !applyPackPatch(work, patch, error) && sameFile(work, basePack);
+    std::printf("corrupt patch: %s (%s)\n", corruptRejected ? "rejected, pack untouched" : "NOT REJECTED",
+                error.c_str());
+    error.clear();
+    const bool wrongBaseRejected = !applyPackPatch(newPack, patch, error);
+    std::printf("wrong base pack: %s (%s)\n", wrongBaseRejected ? "rejected" : "NOT REJECTED", error.c_str());
+
+    fs::remove_all(dir, ec);
+    return ok && corruptRejected && wrongBaseRejected ? 0 : 1;
+}
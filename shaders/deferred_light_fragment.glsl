@@ -0,0 +1,89 @@
+#version 330 core
+// Deferred ışık geçişi: her spot ışığı için ekran-uzayı dikdörtgeninde (scissor)
+// bir tam ekran üçgen çizilir, sonuçlar additive blend ile toplanır.
+// Aydınlatma formülü fragment.glsl ile aynı kalmalı.
+struct SpotLight {
+    vec3 position;
+    float cutOff;
+    vec3 direction;
+    float outerCutOff;
+    vec3 ambient;
+    float constant;
+    vec3 diffuse;
+    float linear;
+    vec3 specular;
+    float quadratic;
+};
+#define MAX_SPOT_LIGHTS 64
+
+layout(std140) uniform LightBlock {
+    int numSpotLights;
+    SpotLight spotLights[MAX_SPOT_LIGHTS];
+};
+
+out vec4 FragColor;
+
+uniform sampler2D gAlbedoSpec;
+uniform sampler2D gNormalShininess;
+uniform sampler2D gDepth;
+uniform mat4 invViewProj;
+uniform vec3 viewPos;
+uniform vec2 viewportSize; // G-buffer'ın kullanılan kısmı (dinamik çözünürlük)
+uniform int lightIndex; // < 0: geometri piksellerini siyaha sıfırla
+
+vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * signNotZero(n.xy);
+    return normalize(n);
+}
+
+vec3 CalculateSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir,
+                        vec3 albedo, float specMask, float shininess) {
+    vec3 lightDir = normalize(light.position - fragPos);
+    float theta = dot(lightDir, normalize(-light.direction));
+    float epsilon = (light.cutOff - light.outerCutOff);
+    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
+
+    vec3 ambient = light.ambient * albedo;
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = light.diffuse * diff * albedo;
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    vec3 specular = light.specular * spec * specMask;
+
+    diff *= intensity;
+    specular *= intensity;
+    ambient *= intensity;
+
+    return (ambient + diffuse + specular) / (light.constant + light.linear * length(light.position - fragPos) + light.quadratic * (length(light.position - fragPos) * length(light.position - fragPos)));
+}
+
+void main() {
+    ivec2 px = ivec2(gl_FragCoord.xy);
+    float depth = texelFetch(gDepth, px, 0).r;
+    if (depth >= 1.0)
+        discard; // arka plan: temizleme rengi kalır
+    if (lightIndex < 0) {
+        FragColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+
+    // Derinlikten dünya pozisyonu
+    vec2 uv = (vec2(px) + 0.5) / viewportSize;
+    vec4 world = invViewProj * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+    vec3 fragPos = world.xyz / world.w;
+
+    vec4 albedoSpec = texelFetch(gAlbedoSpec, px, 0);
+    vec4 normalShininess = texelFetch(gNormalShininess, px, 0);
+    vec3 norm = octDecode(normalShininess.xy);
+    vec3 viewDir = normalize(viewPos - fragPos);
+
+    vec3 result = CalculateSpotLight(spotLights[lightIndex], norm, fragPos, viewDir,
+                                     albedoSpec.rgb, albedoSpec.a, normalShininess.z);
+    FragColor = vec4(result, 1.0);
+}
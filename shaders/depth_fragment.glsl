@@ -0,0 +1,4 @@
+#version 330 core
+// Sadece derinlik yazılır
+void main() {
+}
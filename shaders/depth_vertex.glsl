@@ -0,0 +1,21 @@
+#version 330 core
+layout(location = 0) in vec3 aPos;
+
+// vertex.glsl ile aynı dönüşüm zinciri: GL_EQUAL testinin tutması için
+// gl_Position iki programda da birebir aynı hesaplanmalı
+uniform samplerBuffer transforms;
+uniform int transformIndex;
+uniform mat4 view;
+uniform mat4 projection;
+
+invariant gl_Position;
+
+void main() {
+    int base = transformIndex * 7;
+    mat4 model = mat4(texelFetch(transforms, base),
+                      texelFetch(transforms, base + 1),
+                      texelFetch(transforms, base + 2),
+                      texelFetch(transforms, base + 3));
+    vec4 worldPos = model * vec4(aPos, 1.0);
+    gl_Position = projection * view * worldPos;
+}
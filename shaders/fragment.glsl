@@ -1,17 +1,23 @@
 #version 330 core
+// std140: Lights.h içindeki SpotLight ile birebir aynı düzen
 struct SpotLight {
     vec3 position;
-    vec3 direction;
     float cutOff;
+    vec3 direction;
     float outerCutOff;
     vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
     float constant;
+    vec3 diffuse;
     float linear;
+    vec3 specular;
     float quadratic;
 };
-#define MAX_SPOT_LIGHTS 5
+#define MAX_SPOT_LIGHTS 64
+
+struct Material {
+    vec3 diffuseColor;
+    float shininess;
+};
 
 in VS_OUT {
     vec3 FragPos;
@@ -22,8 +28,12 @@ in VS_OUT {
 out vec4 FragColor;
 
 uniform sampler2D texture_diffuse1;
-uniform SpotLight spotLights[MAX_SPOT_LIGHTS];
-uniform int numSpotLights;
+uniform sampler2D texture_specular1;
+uniform Material material;
+layout(std140) uniform LightBlock {
+    int numSpotLights;
+    SpotLight spotLights[MAX_SPOT_LIGHTS];
+};
 uniform vec3 viewPos;
 
 vec3 CalculateSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
@@ -32,15 +42,19 @@ vec3 CalculateSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir
     float epsilon = (light.cutOff - light.outerCutOff);
     float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
 
+    // Haritası olmayan slotlara 1x1 beyaz doku bağlı
+    vec3 albedo = material.diffuseColor * vec3(texture(texture_diffuse1, fs_in.TexCoords));
+    float specMask = texture(texture_specular1, fs_in.TexCoords).r;
+
     // ambient
-    vec3 ambient = light.ambient * vec3(texture(texture_diffuse1, fs_in.TexCoords));
+    vec3 ambient = light.ambient * albedo;
     // diffuse 
     float diff = max(dot(normal, lightDir), 0.0);
-    vec3 diffuse = light.diffuse * diff * vec3(texture(texture_diffuse1, fs_in.TexCoords));
+    vec3 diffuse = light.diffuse * diff * albedo;
     // specular
     vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
-    vec3 specular = light.specular * spec;
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    vec3 specular = light.specular * spec * specMask;
 
     diff *= intensity;
     specular *= intensity;
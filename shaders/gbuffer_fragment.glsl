@@ -0,0 +1,36 @@
+#version 330 core
+// Deferred geometry pass: vertex.glsl ile birlikte kullanılır
+struct Material {
+    vec3 diffuseColor;
+    float shininess;
+};
+
+in VS_OUT {
+    vec3 FragPos;
+    vec3 Normal;
+    vec2 TexCoords;
+} fs_in;
+
+layout(location = 0) out vec4 gAlbedoSpec;
+layout(location = 1) out vec4 gNormalShininess;
+
+uniform sampler2D texture_diffuse1;
+uniform sampler2D texture_specular1;
+uniform Material material;
+
+vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+// Octahedral normal kodlaması (2 kanal)
+vec2 octEncode(vec3 n) {
+    n /= (abs(n.x) + abs(n.y) + abs(n.z));
+    return n.z >= 0.0 ? n.xy : (1.0 - abs(n.yx)) * signNotZero(n.xy);
+}
+
+void main() {
+    vec3 albedo = material.diffuseColor * vec3(texture(texture_diffuse1, fs_in.TexCoords));
+    float specMask = texture(texture_specular1, fs_in.TexCoords).r;
+    gAlbedoSpec = vec4(albedo, specMask);
+    gNormalShininess = vec4(octEncode(normalize(fs_in.Normal)), material.shininess, 0.0);
+}
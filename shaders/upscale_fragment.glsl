@@ -0,0 +1,27 @@
+#version 330 core
+// Dinamik çözünürlük: sahne hedefinin sol-alt (uvScale) kısmını ekrana büyütür.
+// sharpen: bilinear örneğin üzerine 5 noktalı unsharp mask.
+in vec2 TexCoords;
+out vec4 FragColor;
+
+uniform sampler2D source;
+uniform vec2 uvScale;   // kullanılan bölge / texture boyutu
+uniform vec2 texelSize; // 1 / texture boyutu
+uniform bool sharpen;
+uniform float sharpness;
+
+vec3 tap(vec2 uv) {
+    // Kullanılmayan bölgeden renk sızmasın
+    return texture(source, clamp(uv, texelSize * 0.5, uvScale - texelSize * 0.5)).rgb;
+}
+
+void main() {
+    vec2 uv = TexCoords * uvScale;
+    vec3 color = tap(uv);
+    if (sharpen) {
+        vec3 blur = (tap(uv + vec2(texelSize.x, 0.0)) + tap(uv - vec2(texelSize.x, 0.0)) +
+                     tap(uv + vec2(0.0, texelSize.y)) + tap(uv - vec2(0.0, texelSize.y))) * 0.25;
+        color = max(color + (color - blur) * sharpness, vec3(0.0));
+    }
+    FragColor = vec4(color, 1.0);
+}
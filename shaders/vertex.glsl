@@ -3,7 +3,10 @@ layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec2 aTexCoords;
 
-uniform mat4 model;
+// Her çizim için 7 texel: model matrisi (4) + CPU'da hesaplanmış normal matrisi (3)
+uniform samplerBuffer transforms;
+uniform int transformIndex;
+uniform bool legacyNormalMatrix; // karşılaştırma için eski vertex başına inverse
 uniform mat4 view;
 uniform mat4 projection;
 
@@ -13,9 +16,26 @@ out VS_OUT {
     vec2 TexCoords;
 } vs_out;
 
+// depth_vertex.glsl ile aynı ifade: pre-pass sonrası GL_EQUAL testi için
+invariant gl_Position;
+
 void main() {
-    vs_out.FragPos = vec3(model * vec4(aPos, 1.0));
-    vs_out.Normal = mat3(transpose(inverse(model))) * aNormal;
+    int base = transformIndex * 7;
+    mat4 model = mat4(texelFetch(transforms, base),
+                      texelFetch(transforms, base + 1),
+                      texelFetch(transforms, base + 2),
+                      texelFetch(transforms, base + 3));
+    mat3 normalMatrix;
+    if (legacyNormalMatrix)
+        normalMatrix = mat3(transpose(inverse(model)));
+    else
+        normalMatrix = mat3(texelFetch(transforms, base + 4).xyz,
+                            texelFetch(transforms, base + 5).xyz,
+                            texelFetch(transforms, base + 6).xyz);
+
+    vec4 worldPos = model * vec4(aPos, 1.0);
+    vs_out.FragPos = vec3(worldPos);
+    vs_out.Normal = normalMatrix * aNormal;
     vs_out.TexCoords = aTexCoords;
-    gl_Position = projection * view * vec4(vs_out.FragPos, 1.0);
+    gl_Position = projection * view * worldPos;
 }
@@ -0,0 +1,152 @@
+// AllocCounter.cpp
+#include "AllocCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // Statik başlatma sırasından bağımsız olmalı: sabit başlatılan atomikler
+    std::atomic<int> users{0}; // enable() - disable()
+    std::atomic<unsigned long long> allocations{0};
+    std::atomic<unsigned long long> allocatedBytes{0};
+    std::atomic<std::size_t> largestAllocation{0};
+
+    void note(std::size_t size)
+    {
+        if (users.load(std::memory_order_relaxed) <= 0)
+            return;
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        std::size_t seen = largestAllocation.load(std::memory_order_relaxed);
+        while (size > seen && !largestAllocation.compare_exchange_weak(seen, size, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void *allocate(std::size_t size)
+    {
+        note(size);
+        void *p = std::malloc(size ? size : 1);
+        if (!p)
+            throw std::bad_alloc();
+        return p;
+    }
+
+    void *allocateAligned(std::size_t size, std::size_t align)
+    {
+        note(size);
+        if (size == 0)
+            size = 1;
+#if defined(_MSC_VER)
+        void *p = _aligned_malloc(size, align);
+#else
+        // aligned_alloc: boyut hizalamanın katı olmalı
+        void *p = std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+        if (!p)
+            throw std::bad_alloc();
+        return p;
+    }
+
+    void freeAligned(void *p)
+    {
+#if defined(_MSC_VER)
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+void AllocCounter::enable()
+{
+    users.fetch_add(1);
+}
+
+void AllocCounter::disable()
+{
+    // Eşsiz disable() sayacı eksiye düşürmesin
+    int n = users.load();
+    while (n > 0 && !users.compare_exchange_weak(n, n - 1))
+    {
+    }
+}
+
+bool AllocCounter::enabled()
+{
+    return users.load() > 0;
+}
+
+unsigned long long AllocCounter::count()
+{
+    return allocations.load();
+}
+
+unsigned long long AllocCounter::bytes()
+{
+    return allocatedBytes.load();
+}
+
+std::size_t AllocCounter::largest()
+{
+    return largestAllocation.load();
+}
+
+void AllocCounter::reset()
+{
+    allocations.store(0);
+    allocatedBytes.store(0);
+    largestAllocation.store(0);
+}
+
+// ---------------------------------------------------------------------------
+// Global replacements
+// ---------------------------------------------------------------------------
+void *operator new(std::size_t size) { return allocate(size); }
+void *operator new[](std::size_t size) { return allocate(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new(std::size_t size, std::align_val_t align)
+{
+    return allocateAligned(size, static_cast<std::size_t>(align));
+}
+
+void *operator new[](std::size_t size, std::align_val_t align)
+{
+    return allocateAligned(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { freeAligned(p); }
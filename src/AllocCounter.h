@@ -0,0 +1,37 @@
+// AllocCounter.h
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+#include <cstddef>
+
+// Global operator new/delete are replaced (AllocCounter.cpp) with malloc
+// wrappers that count calls from every thread while counting is enabled.
+// Used by --alloc-check to prove the steady-state frame doesn't allocate;
+// C allocations (malloc in drivers, ImGui's MemAlloc) are not seen.
+class AllocCounter
+{
+public:
+    // Reference counted: counting runs until every enable() has had its
+    // disable(), so the perf HUD and --alloc-check can both hold it
+    static void enable();
+    static void disable();
+    static bool enabled();
+
+    // enable() for the lifetime of the object
+    class Scope
+    {
+    public:
+        Scope() { enable(); }
+        ~Scope() { disable(); }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+    };
+
+    // Since the last reset
+    static unsigned long long count();
+    static unsigned long long bytes();
+    static std::size_t largest();
+    static void reset();
+};
+
+#endif // ALLOCCOUNTER_H
@@ -0,0 +1,554 @@
+// AssetPack.cpp
+#include "AssetPack.h"
+#include "JobSystem.h"
+#include "Lz4.h"
+#include "SceneFile.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+namespace
+{
+    constexpr char MAGIC[4] = {'V', 'M', 'P', 'K'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::uint32_t ENDIAN_TAG = 0x01020304;
+    constexpr std::uint32_t MATERIAL_DIFFUSE_COLOR = 1u << 0;
+
+    struct Header
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t entryCount;
+        std::uint64_t tocOffset;
+        std::uint64_t namesOffset;
+        std::uint64_t namesSize;
+        std::uint64_t fileSize;
+    };
+
+    // PACK_MODEL içeriği: ModelRecord, MeshRecord[], MaterialRecord[], dizgeler
+    struct ModelRecord
+    {
+        float bbMin[3], bbMax[3];
+        std::uint32_t meshCount, materialCount, stringsSize;
+    };
+    struct MeshRecord
+    {
+        std::uint32_t vertexCount, indexCount, materialIndex;
+    };
+    struct MaterialRecord
+    {
+        std::uint32_t diffuseTexture, specularTexture, name; // dizge ofseti, 0 = boş
+        float diffuseColor[3];
+        float shininess;
+        std::uint32_t flags;
+    };
+
+    static_assert(sizeof(PackEntry) == 64, "PackEntry is a file record");
+
+    // write()'ın işleri: binlerce girdi gruplanır, iş sayısı sınırlı kalır
+    constexpr std::size_t MAX_WRITE_JOBS = 256;
+
+    std::size_t writeGrain(std::size_t count)
+    {
+        return std::max<std::size_t>(1, (count + MAX_WRITE_JOBS - 1) / MAX_WRITE_JOBS);
+    }
+
+    std::uint64_t fnv1a(const unsigned char *bytes, std::size_t size)
+    {
+        std::uint64_t hash = 1469598103934665603ull;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::string meshEntry(const std::string &model, std::size_t mesh, const char *stream)
+    {
+        return model + "#" + std::to_string(mesh) + "." + stream;
+    }
+
+    std::uint64_t alignUp(std::uint64_t value)
+    {
+        return (value + PACK_ALIGNMENT - 1) & ~std::uint64_t(PACK_ALIGNMENT - 1);
+    }
+
+    template <typename T>
+    void append(std::vector<unsigned char> &out, const T *records, std::size_t count)
+    {
+        const std::size_t at = out.size();
+        out.resize(at + count * sizeof(T));
+        if (count)
+            std::memcpy(out.data() + at, records, count * sizeof(T));
+    }
+}
+
+// ---------- Okuma ---------------------------------------------------------
+
+bool AssetPack::mount(const std::string &packPath, std::string &error)
+{
+    unmount();
+    if (!file.open(packPath, error))
+        return false;
+    const unsigned char *data = file.data();
+    const std::size_t size = file.size();
+
+    Header header;
+    if (size < sizeof(header))
+        error = "truncated header";
+    else
+    {
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+            error = "not an asset pack";
+        else if (header.byteOrder != ENDIAN_TAG)
+            error = "cooked for another byte order";
+        else if (header.version != VERSION)
+            error = "version " + std::to_string(header.version) + ", expected " + std::to_string(VERSION);
+        else if (header.fileSize != size)
+            error = "size mismatch (truncated file?)";
+        else if (header.tocOffset > size || (size - header.tocOffset) / sizeof(PackEntry) < header.entryCount)
+            error = "table of contents out of bounds";
+        else if (header.namesOffset > size || size - header.namesOffset < header.namesSize)
+            error = "name strings out of bounds";
+    }
+    if (error.empty())
+    {
+        entries.resize(header.entryCount);
+        if (header.entryCount)
+            std::memcpy(entries.data(), data + header.tocOffset, entries.size() * sizeof(PackEntry));
+        names = reinterpret_cast<const char *>(data + header.namesOffset);
+        namesSize = static_cast<std::size_t>(header.namesSize);
+
+        for (std::size_t i = 0; i < entries.size() && error.empty(); ++i)
+        {
+            const PackEntry &e = entries[i];
+            if (std::uint64_t(e.name) + e.nameLength > namesSize)
+                error = "entry " + std::to_string(i) + ": name out of bounds";
+            else if (e.offset > size || size - e.offset < e.storedSize)
+                error = entryName(e) + ": payload out of bounds";
+            else if (e.codec > PACK_LZ4 || (e.codec == PACK_RAW && e.storedSize != e.rawSize))
+                error = entryName(e) + ": bad codec";
+            else if (i > 0 && entryName(entries[i - 1]) >= entryName(e))
+                error = entryName(e) + ": table of contents not sorted";
+        }
+    }
+    if (!error.empty())
+    {
+        error = packPath + ": " + error;
+        unmount();
+        return false;
+    }
+    path = packPath;
+    return true;
+}
+
+void AssetPack::unmount()
+{
+    file.close();
+    entries.clear();
+    names = nullptr;
+    namesSize = 0;
+    path.clear();
+}
+
+std::string AssetPack::entryName(const PackEntry &entry) const
+{
+    return std::string(names + entry.name, entry.nameLength);
+}
+
+const PackEntry *AssetPack::find(const std::string &name) const
+{
+    auto it = std::lower_bound(entries.begin(), entries.end(), name, [this](const PackEntry &e, const std::string &key)
+                               { return key.compare(0, std::string::npos, names + e.name, e.nameLength) > 0; });
+    if (it == entries.end() || name.compare(0, std::string::npos, names + it->name, it->nameLength) != 0)
+        return nullptr;
+    return &*it;
+}
+
+bool AssetPack::read(const PackEntry &entry, void *dst, std::string &error) const
+{
+    if (entry.codec == PACK_RAW)
+    {
+        if (entry.rawSize)
+            std::memcpy(dst, payload(entry), static_cast<std::size_t>(entry.rawSize));
+        return true;
+    }
+    if (!lz4Decompress(payload(entry), static_cast<std::size_t>(entry.storedSize), static_cast<unsigned char *>(dst),
+                       static_cast<std::size_t>(entry.rawSize)))
+    {
+        error = entryName(entry) + ": corrupt compressed payload";
+        return false;
+    }
+    return true;
+}
+
+bool AssetPack::loadModel(const std::string &modelPath, ModelData &data, std::string &error) const
+{
+    const PackEntry *entry = find(modelPath);
+    if (!entry || entry->kind != PACK_MODEL)
+    {
+        error = modelPath + ": not in pack";
+        return false;
+    }
+    std::vector<unsigned char> record(static_cast<std::size_t>(entry->rawSize));
+    if (!read(*entry, record.data(), error))
+        return false;
+
+    ModelRecord model;
+    std::size_t at = sizeof(model);
+    if (record.size() < at)
+    {
+        error = modelPath + ": truncated model record";
+        return false;
+    }
+    std::memcpy(&model, record.data(), sizeof(model));
+    const std::uint64_t expected = sizeof(ModelRecord) + std::uint64_t(model.meshCount) * sizeof(MeshRecord) +
+                                   std::uint64_t(model.materialCount) * sizeof(MaterialRecord) + model.stringsSize;
+    if (expected != record.size() || model.stringsSize == 0 || record.back() != '\0')
+    {
+        error = modelPath + ": malformed model record";
+        return false;
+    }
+    std::vector<MeshRecord> meshes(model.meshCount);
+    if (model.meshCount)
+        std::memcpy(meshes.data(), record.data() + at, meshes.size() * sizeof(MeshRecord));
+    at += meshes.size() * sizeof(MeshRecord);
+    std::vector<MaterialRecord> materials(model.materialCount);
+    if (model.materialCount)
+        std::memcpy(materials.data(), record.data() + at, materials.size() * sizeof(MaterialRecord));
+    at += materials.size() * sizeof(MaterialRecord);
+    const char *strings = reinterpret_cast<const char *>(record.data() + at);
+    bool badString = false;
+    auto string = [&](std::uint32_t offset)
+    {
+        if (offset >= model.stringsSize)
+        {
+            badString = true;
+            return std::string();
+        }
+        return std::string(strings + offset);
+    };
+
+    data = ModelData();
+    data.path = modelPath;
+    data.bbMin = glm::vec3(model.bbMin[0], model.bbMin[1], model.bbMin[2]);
+    data.bbMax = glm::vec3(model.bbMax[0], model.bbMax[1], model.bbMax[2]);
+    data.materials.reserve(materials.size());
+    for (const MaterialRecord &m : materials)
+    {
+        ImportedMaterial material;
+        material.diffuseTexture = string(m.diffuseTexture);
+        material.specularTexture = string(m.specularTexture);
+        material.name = string(m.name);
+        material.hasDiffuseColor = (m.flags & MATERIAL_DIFFUSE_COLOR) != 0;
+        material.diffuseColor = glm::vec3(m.diffuseColor[0], m.diffuseColor[1], m.diffuseColor[2]);
+        material.shininess = m.shininess;
+        data.materials.push_back(std::move(material));
+    }
+    if (badString)
+    {
+        error = modelPath + ": string offset out of range";
+        return false;
+    }
+
+    // Diziler ara tampon olmadan doğrudan mesh'in tek bloğuna açılır
+    data.meshes.resize(meshes.size());
+    for (std::size_t i = 0; i < meshes.size(); ++i)
+    {
+        MeshData &mesh = data.meshes[i];
+        const PackEntry *vertices = find(meshEntry(modelPath, i, "vertices"));
+        const PackEntry *indices = find(meshEntry(modelPath, i, "indices"));
+        if (!vertices || vertices->kind != PACK_VERTICES || !indices || indices->kind != PACK_INDICES)
+        {
+            error = meshEntry(modelPath, i, "*") + ": missing";
+            return false;
+        }
+        if (vertices->params[0] != sizeof(Vertex))
+        {
+            error = modelPath + ": cooked with a " + std::to_string(vertices->params[0]) + "-byte vertex, expected " +
+                    std::to_string(sizeof(Vertex));
+            return false;
+        }
+        if (vertices->rawSize != std::uint64_t(meshes[i].vertexCount) * sizeof(Vertex) ||
+            indices->rawSize != std::uint64_t(meshes[i].indexCount) * sizeof(unsigned int))
+        {
+            error = meshEntry(modelPath, i, "*") + ": size does not match the model record";
+            return false;
+        }
+        mesh.allocate(meshes[i].vertexCount, meshes[i].indexCount);
+        if (!read(*vertices, mesh.vertices.data(), error) || !read(*indices, mesh.indices.data(), error))
+            return false;
+        mesh.materialIndex = meshes[i].materialIndex;
+    }
+    return true;
+}
+
+bool AssetPack::loadTexture(const std::string &texturePath, TextureData &texture, std::string &error) const
+{
+    const PackEntry *entry = find(texturePath);
+    if (!entry || entry->kind != PACK_TEXTURE)
+    {
+        error = texturePath + ": not in pack";
+        return false;
+    }
+    texture.width = static_cast<int>(entry->params[0]);
+    texture.height = static_cast<int>(entry->params[1]);
+    texture.components = static_cast<int>(entry->params[2]);
+    if (std::uint64_t(entry->params[0]) * entry->params[1] * entry->params[2] != entry->rawSize ||
+        texture.components < 1 || texture.components > 4)
+    {
+        error = texturePath + ": bad texture dimensions";
+        return false;
+    }
+    texture.storage.clear();
+    if (entry->codec == PACK_RAW)
+    {
+        texture.pixels = payload(*entry);
+        return true;
+    }
+    texture.storage.resize(static_cast<std::size_t>(entry->rawSize));
+    texture.pixels = texture.storage.data();
+    return read(*entry, texture.storage.data(), error);
+}
+
+bool AssetPack::loadScene(SceneDesc &desc, std::string &error) const
+{
+    const PackEntry *entry = find(PACK_SCENE_ENTRY);
+    if (!entry || entry->kind != PACK_SCENE)
+    {
+        error = path + ": no scene in pack";
+        return false;
+    }
+    if (entry->codec == PACK_RAW)
+        return readSceneBinary(payload(*entry), static_cast<std::size_t>(entry->rawSize), desc, error);
+    std::vector<unsigned char> bytes(static_cast<std::size_t>(entry->rawSize));
+    return read(*entry, bytes.data(), error) && readSceneBinary(bytes.data(), bytes.size(), desc, error);
+}
+
+// ---------- Yazma ---------------------------------------------------------
+
+void PackWriter::add(const std::string &name, PackKind kind, std::vector<unsigned char> bytes,
+                     std::initializer_list<std::uint32_t> params)
+{
+    Pending entry{name, kind, {0, 0, 0, 0}, std::move(bytes)};
+    std::copy_n(params.begin(), std::min<std::size_t>(params.size(), 4), entry.params);
+    pending.push_back(std::move(entry));
+}
+
+void PackWriter::addScene(const SceneDesc &desc)
+{
+    add(PACK_SCENE_ENTRY, PACK_SCENE, compileScene(desc));
+}
+
+void PackWriter::addModel(const ModelData &data)
+{
+    std::vector<char> strings(1, '\0');
+    auto string = [&strings](const std::string &str) -> std::uint32_t
+    {
+        if (str.empty())
+            return 0;
+        const std::uint32_t offset = static_cast<std::uint32_t>(strings.size());
+        strings.insert(strings.end(), str.begin(), str.end());
+        strings.push_back('\0');
+        return offset;
+    };
+
+    ModelRecord model{{data.bbMin.x, data.bbMin.y, data.bbMin.z},
+                      {data.bbMax.x, data.bbMax.y, data.bbMax.z},
+                      static_cast<std::uint32_t>(data.meshes.size()),
+                      static_cast<std::uint32_t>(data.materials.size()),
+                      0};
+    std::vector<MeshRecord> meshes;
+    meshes.reserve(data.meshes.size());
+    for (std::size_t i = 0; i < data.meshes.size(); ++i)
+    {
+        const MeshData &mesh = data.meshes[i];
+        meshes.push_back({static_cast<std::uint32_t>(mesh.vertices.size()),
+                          static_cast<std::uint32_t>(mesh.indices.size()), mesh.materialIndex});
+
+        std::vector<unsigned char> vertices, indices;
+        append(vertices, mesh.vertices.data(), mesh.vertices.size());
+        append(indices, mesh.indices.data(), mesh.indices.size());
+        add(meshEntry(data.path, i, "vertices"), PACK_VERTICES, std::move(vertices),
+            {static_cast<std::uint32_t>(sizeof(Vertex))});
+        add(meshEntry(data.path, i, "indices"), PACK_INDICES, std::move(indices));
+    }
+    std::vector<MaterialRecord> materials;
+    materials.reserve(data.materials.size());
+    for (const ImportedMaterial &m : data.materials)
+    {
+        materials.push_back({string(m.diffuseTexture), string(m.specularTexture), string(m.name),
+                             {m.diffuseColor.x, m.diffuseColor.y, m.diffuseColor.z}, m.shininess,
+                             m.hasDiffuseColor ? MATERIAL_DIFFUSE_COLOR : 0u});
+    }
+    model.stringsSize = static_cast<std::uint32_t>(strings.size());
+
+    std::vector<unsigned char> record;
+    append(record, &model, 1);
+    append(record, meshes.data(), meshes.size());
+    append(record, materials.data(), materials.size());
+    append(record, strings.data(), strings.size());
+    add(data.path, PACK_MODEL, std::move(record));
+}
+
+void PackWriter::addTexture(const std::string &texturePath, const unsigned char *pixels, int width, int height,
+                            int components)
+{
+    std::vector<unsigned char> bytes(pixels, pixels + static_cast<std::size_t>(width) * height * components);
+    add(texturePath, PACK_TEXTURE, std::move(bytes),
+        {static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height),
+         static_cast<std::uint32_t>(components)});
+}
+
+bool PackWriter::write(const std::string &outPath, bool compress, PackStats &stats, std::string &error)
+{
+    stats = PackStats();
+    std::sort(pending.begin(), pending.end(), [](const Pending &a, const Pending &b)
+              { return a.name < b.name; });
+    for (std::size_t i = 1; i < pending.size(); ++i)
+    {
+        if (pending[i].name == pending[i - 1].name)
+        {
+            error = "duplicate pack entry " + pending[i].name;
+            return false;
+        }
+    }
+
+    // 1) Özetler paralel; aynı özet + aynı baytlar tek yük
+    const std::size_t count = pending.size();
+    std::vector<PackEntry> entries(count);
+    JobSystem::get().parallelFor(count, [&](std::size_t begin, std::size_t end)
+                                 {
+        for (std::size_t i = begin; i < end; ++i)
+            entries[i].hash = fnv1a(pending[i].bytes.data(), pending[i].bytes.size()); }, writeGrain(count));
+
+    std::vector<std::size_t> payloadOf(count); // entry -> payload sırası
+    std::vector<std::size_t> payloads;          // payload -> ilk entry
+    std::unordered_multimap<std::uint64_t, std::size_t> byHash;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::vector<unsigned char> &bytes = pending[i].bytes;
+        stats.rawBytes += bytes.size();
+        std::size_t found = payloads.size();
+        auto range = byHash.equal_range(entries[i].hash);
+        for (auto it = range.first; it != range.second && found == payloads.size(); ++it)
+        {
+            const std::vector<unsigned char> &other = pending[payloads[it->second]].bytes;
+            if (other.size() == bytes.size() && (bytes.empty() || std::memcmp(other.data(), bytes.data(), bytes.size()) == 0))
+                found = it->second;
+        }
+        if (found == payloads.size())
+        {
+            byHash.emplace(entries[i].hash, payloads.size());
+            payloads.push_back(i);
+            stats.uniqueBytes += bytes.size();
+        }
+        payloadOf[i] = found;
+    }
+
+    // 2) Sıkıştırma paralel; en az 1/8 kazandırmayan yük ham kalır
+    std::vector<std::vector<unsigned char>> packed(payloads.size());
+    std::vector<PackCodec> codecs(payloads.size(), PACK_RAW);
+    if (compress)
+    {
+        JobSystem::get().parallelFor(payloads.size(), [&](std::size_t begin, std::size_t end)
+                                     {
+            for (std::size_t p = begin; p < end; ++p)
+            {
+                const std::vector<unsigned char> &raw = pending[payloads[p]].bytes;
+                std::vector<unsigned char> out(lz4CompressBound(raw.size()));
+                const std::size_t size = lz4Compress(raw.data(), raw.size(), out.data(), out.size());
+                if (size && size <= raw.size() - raw.size() / 8)
+                {
+                    out.resize(size);
+                    packed[p] = std::move(out);
+                    codecs[p] = PACK_LZ4;
+                }
+            } }, writeGrain(payloads.size()));
+    }
+
+    // 3) Yerleşim: başlık, TOC, adlar, sonra sayfa hizalı yükler
+    std::vector<char> names;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        entries[i].name = static_cast<std::uint32_t>(names.size());
+        entries[i].nameLength = static_cast<std::uint32_t>(pending[i].name.size());
+        names.insert(names.end(), pending[i].name.begin(), pending[i].name.end());
+    }
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = ENDIAN_TAG;
+    header.entryCount = static_cast<std::uint32_t>(count);
+    header.tocOffset = sizeof(Header);
+    header.namesOffset = header.tocOffset + count * sizeof(PackEntry);
+    header.namesSize = names.size();
+
+    std::vector<std::uint64_t> offsets(payloads.size());
+    std::uint64_t end = header.namesOffset + header.namesSize;
+    for (std::size_t p = 0; p < payloads.size(); ++p)
+    {
+        const std::size_t size = codecs[p] == PACK_LZ4 ? packed[p].size() : pending[payloads[p]].bytes.size();
+        offsets[p] = alignUp(end);
+        end = offsets[p] + size;
+        stats.storedBytes += size;
+        stats.compressed += codecs[p] == PACK_LZ4;
+    }
+    header.fileSize = end;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::size_t p = payloadOf[i];
+        PackEntry &e = entries[i];
+        e.offset = offsets[p];
+        e.rawSize = pending[i].bytes.size();
+        e.codec = codecs[p];
+        e.storedSize = e.codec == PACK_LZ4 ? packed[p].size() : e.rawSize;
+        e.kind = pending[i].kind;
+        std::copy_n(pending[i].params, 4, e.params);
+    }
+
+    // 4) Geçici dosyaya yaz, sonra eskisinin üstüne taşı
+    const std::string tempPath = outPath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        static const char zeros[PACK_ALIGNMENT] = {};
+        std::uint64_t written = 0;
+        auto put = [&](const void *bytes, std::uint64_t size)
+        {
+            out.write(static_cast<const char *>(bytes), static_cast<std::streamsize>(size));
+            written += size;
+        };
+        put(&header, sizeof(header));
+        put(entries.data(), entries.size() * sizeof(PackEntry));
+        put(names.data(), names.size());
+        for (std::size_t p = 0; p < payloads.size(); ++p)
+        {
+            put(zeros, offsets[p] - written);
+            const std::vector<unsigned char> &bytes = codecs[p] == PACK_LZ4 ? packed[p] : pending[payloads[p]].bytes;
+            put(bytes.data(), bytes.size());
+        }
+        if (!out.flush())
+        {
+            error = "cannot write " + tempPath;
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, outPath, ec);
+    if (ec)
+    {
+        error = "cannot replace " + outPath + ": " + ec.message();
+        return false;
+    }
+
+    stats.entries = count;
+    stats.payloads = payloads.size();
+    stats.fileBytes = header.fileSize;
+    pending.clear();
+    return true;
+}
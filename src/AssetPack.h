@@ -0,0 +1,136 @@
+// AssetPack.h
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+#include "Model.h"
+#include "SceneDesc.h"
+
+// Cooked asset pack (.vmpack), written by museum_cook:
+//   header | table of contents (sorted by name) | name strings | payloads
+// Every payload starts on a PACK_ALIGNMENT boundary and is stored raw or
+// LZ4 compressed. Entries with identical content (same FNV-1a hash and
+// bytes) share one payload. Names are the paths the loose files had, so a
+// scene loads from a pack or from models/ without change:
+//   <model path>                 PACK_MODEL: bounds, materials, mesh list
+//   <model path>#<i>.vertices    PACK_VERTICES: Vertex[] of mesh i
+//   <model path>#<i>.indices     PACK_INDICES: uint32[] of mesh i
+//   <texture path>               PACK_TEXTURE: decoded 8-bit pixels
+//   #scene                       PACK_SCENE: compiled scene (SceneFile.h)
+
+constexpr std::size_t PACK_ALIGNMENT = 4096;
+constexpr const char *PACK_SCENE_ENTRY = "#scene";
+
+enum PackKind : std::uint32_t
+{
+    PACK_SCENE = 1,
+    PACK_MODEL = 2,
+    PACK_VERTICES = 3,
+    PACK_INDICES = 4,
+    PACK_TEXTURE = 5
+};
+
+enum PackCodec : std::uint32_t
+{
+    PACK_RAW = 0,
+    PACK_LZ4 = 1
+};
+
+struct PackEntry
+{
+    std::uint64_t hash;       // FNV-1a of the raw bytes
+    std::uint64_t offset;     // payload, from the start of the file
+    std::uint64_t storedSize; // bytes in the file
+    std::uint64_t rawSize;    // bytes after decoding
+    std::uint32_t name;       // offset into the name strings
+    std::uint32_t nameLength;
+    std::uint32_t kind;
+    std::uint32_t codec;
+    std::uint32_t params[4]; // texture: width, height, components; vertices: stride
+};
+
+// Pixels of a PACK_TEXTURE entry. Raw entries point into the mapping (valid
+// while the pack stays mounted), compressed ones are decoded into storage.
+struct TextureData
+{
+    int width = 0, height = 0, components = 0;
+    const unsigned char *pixels = nullptr;
+    std::vector<unsigned char> storage;
+};
+
+class AssetPack
+{
+public:
+    // Maps the file and validates the header and every TOC entry
+    bool mount(const std::string &path, std::string &error);
+    void unmount();
+    bool isMounted() const { return file.isOpen(); }
+    const std::string &getPath() const { return path; }
+    const unsigned char *data() const { return file.data(); }
+    std::size_t fileSize() const { return file.size(); }
+
+    std::size_t entryCount() const { return entries.size(); }
+    const PackEntry &entry(std::size_t index) const { return entries[index]; }
+    std::string entryName(const PackEntry &entry) const;
+    const PackEntry *find(const std::string &name) const;
+
+    // Stored bytes inside the mapping (the content itself when codec is PACK_RAW)
+    const unsigned char *payload(const PackEntry &entry) const { return file.data() + entry.offset; }
+    // Copies or decompresses the entry into dst, which holds entry.rawSize bytes
+    bool read(const PackEntry &entry, void *dst, std::string &error) const;
+
+    // CPU side only, safe from several jobs at once
+    bool loadModel(const std::string &path, ModelData &data, std::string &error) const;
+    bool loadTexture(const std::string &path, TextureData &texture, std::string &error) const;
+    bool loadScene(SceneDesc &desc, std::string &error) const;
+
+private:
+    MappedFile file;
+    std::string path;
+    std::vector<PackEntry> entries; // TOC kopyası, ada göre sıralı
+    const char *names = nullptr;
+    std::size_t namesSize = 0;
+};
+
+struct PackStats
+{
+    std::size_t entries = 0;
+    std::size_t payloads = 0;     // after deduplication
+    std::size_t compressed = 0;   // payloads stored as PACK_LZ4
+    std::uint64_t rawBytes = 0;   // all entries, before deduplication
+    std::uint64_t uniqueBytes = 0;
+    std::uint64_t storedBytes = 0;
+    std::uint64_t fileBytes = 0;
+};
+
+// Collects entries in memory; write() hashes and compresses them in jobs
+class PackWriter
+{
+public:
+    void add(const std::string &name, PackKind kind, std::vector<unsigned char> bytes,
+             std::initializer_list<std::uint32_t> params = {});
+    void addScene(const SceneDesc &desc);
+    void addModel(const ModelData &data);
+    void addTexture(const std::string &path, const unsigned char *pixels, int width, int height, int components);
+
+    // compress == false stores everything raw. The file is written next to
+    // path and renamed over it, so a mounted old pack is never half-written.
+    bool write(const std::string &path, bool compress, PackStats &stats, std::string &error);
+
+private:
+    struct Pending
+    {
+        std::string name;
+        PackKind kind;
+        std::uint32_t params[4];
+        std::vector<unsigned char> bytes;
+    };
+    std::vector<Pending> pending;
+};
+
+#endif // ASSETPACK_H
@@ -0,0 +1,48 @@
+// CommandQueue.cpp
+#include "CommandQueue.h"
+#include "Robot.h"
+
+void CommandQueue::push(SimCommand &&command)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.push_back(std::move(command));
+}
+
+void CommandQueue::teleportRobot(const glm::vec3 &position)
+{
+    SimCommand command;
+    command.type = SimCommand::Type::TeleportRobot;
+    command.position = position;
+    push(std::move(command));
+}
+
+void CommandQueue::setRobotPath(const std::vector<glm::vec3> &path)
+{
+    SimCommand command;
+    command.type = SimCommand::Type::SetRobotPath;
+    command.path = path;
+    push(std::move(command));
+}
+
+void CommandQueue::apply(Robot &robot)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending.empty())
+            return;
+        executing.swap(pending);
+    }
+    for (SimCommand &command : executing)
+    {
+        switch (command.type)
+        {
+        case SimCommand::Type::TeleportRobot:
+            robot.teleport(command.position);
+            break;
+        case SimCommand::Type::SetRobotPath:
+            robot.setPath(command.path);
+            break;
+        }
+    }
+    executing.clear();
+}
@@ -0,0 +1,43 @@
+// CommandQueue.h
+#ifndef COMMANDQUEUE_H
+#define COMMANDQUEUE_H
+
+#include <mutex>
+#include <vector>
+#include <glm/glm.hpp>
+
+class Robot;
+
+// A change requested by the UI, applied to the simulation state before the
+// next sim step instead of writing into it while a frame is being built
+struct SimCommand
+{
+    enum class Type
+    {
+        TeleportRobot,
+        SetRobotPath
+    };
+    Type type = Type::TeleportRobot;
+    glm::vec3 position{0.0f};
+    std::vector<glm::vec3> path;
+};
+
+class CommandQueue
+{
+public:
+    // Any thread
+    void teleportRobot(const glm::vec3 &position);
+    void setRobotPath(const std::vector<glm::vec3> &path);
+
+    // Simulation thread: applies and clears everything queued so far
+    void apply(Robot &robot);
+
+private:
+    std::mutex mutex;
+    std::vector<SimCommand> pending;
+    std::vector<SimCommand> executing; // kapasite frame'ler arası korunur
+
+    void push(SimCommand &&command);
+};
+
+#endif // COMMANDQUEUE_H
@@ -0,0 +1,57 @@
+// DynamicResolution.cpp
+#include "DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+
+float DynamicResolution::quantize(float s) const
+{
+    s = std::floor(s / step + 1e-3f) * step;
+    return std::clamp(s, minScale, maxScale);
+}
+
+void DynamicResolution::reset()
+{
+    current = maxScale;
+    underBudget = 0;
+    settle = 0;
+}
+
+float DynamicResolution::update(float gpuMs, float targetMs)
+{
+    current = std::clamp(current, minScale, maxScale);
+    if (gpuMs <= 0.0f || targetMs <= 0.0f)
+        return current;
+    if (settle > 0)
+    {
+        --settle;
+        return current;
+    }
+
+    if (gpuMs > targetMs)
+    {
+        // Maliyet piksel sayısıyla (ölçeğin karesi) orantılı kabul edilir
+        float wanted = quantize(current * std::sqrt(targetMs / gpuMs));
+        if (wanted >= current)
+            wanted = std::max(minScale, current - step);
+        if (wanted != current)
+        {
+            current = wanted;
+            settle = settleFrames;
+        }
+        underBudget = 0;
+    }
+    else if (gpuMs < targetMs * growThreshold && current < maxScale)
+    {
+        if (++underBudget >= growFrames)
+        {
+            current = std::min(maxScale, current + step);
+            underBudget = 0;
+            settle = settleFrames;
+        }
+    }
+    else
+    {
+        underBudget = 0;
+    }
+    return current;
+}
@@ -0,0 +1,33 @@
+// DynamicResolution.h
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+// Picks the render scale (per axis) from measured GPU frame time.
+// Drops quickly when over budget, grows one step at a time only after the
+// frame has stayed well under budget for a while (hysteresis), so the scale
+// does not oscillate around the target.
+class DynamicResolution
+{
+public:
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+    float step = 0.05f;          // ölçek bu adımlara yuvarlanır
+    float growThreshold = 0.80f; // hedefin bu oranının altında kalırsa büyü
+    int growFrames = 30;         // ...bu kadar ardışık frame boyunca
+    int settleFrames = 6;        // değişiklikten sonra ölçümler eski ölçeğe ait (sorgu gecikmesi)
+
+    // gpuMs: last measured GPU time, targetMs: budget. Returns the new scale.
+    float update(float gpuMs, float targetMs);
+    void reset();
+
+    float scale() const { return current; }
+
+private:
+    float current = 1.0f;
+    int underBudget = 0;
+    int settle = 0;
+
+    float quantize(float s) const;
+};
+
+#endif // DYNAMICRESOLUTION_H
@@ -0,0 +1,261 @@
+// FileWatcher.cpp
+#include "FileWatcher.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    std::string normalPath(const fs::path &path)
+    {
+        std::string normal = path.lexically_normal().generic_string();
+        while (normal.size() > 1 && normal.back() == '/')
+            normal.pop_back();
+        return normal;
+    }
+
+#if !defined(__linux__)
+    constexpr std::chrono::milliseconds POLL_INTERVAL{500};
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+    stop();
+}
+
+bool FileWatcher::start(const std::vector<std::string> &directories, std::chrono::milliseconds debounceTime,
+                        std::function<void()> batchCallback, std::string &error)
+{
+    stop();
+    roots.clear();
+    std::error_code ec;
+    for (const std::string &directory : directories)
+    {
+        const std::string root = normalPath(directory);
+        if (fs::is_directory(root, ec) && std::find(roots.begin(), roots.end(), root) == roots.end())
+            roots.push_back(root);
+    }
+    if (roots.empty())
+    {
+        error = "no directory to watch";
+        return false;
+    }
+    debounce = debounceTime;
+    onBatch = std::move(batchCallback);
+    collecting.clear();
+
+#if defined(__linux__)
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    wakeFd = eventfd(0, EFD_CLOEXEC);
+    if (inotifyFd < 0 || wakeFd < 0)
+    {
+        error = std::string("inotify: ") + std::strerror(errno);
+        stop();
+        return false;
+    }
+    for (const std::string &root : roots)
+        addTree(root);
+    running = true;
+    thread = std::thread(&FileWatcher::runInotify, this);
+#else
+    stamps.clear();
+    scan(false); // mevcut dosyaların zamanları referans
+    running = true;
+    thread = std::thread(&FileWatcher::runPolling, this);
+#endif
+    return true;
+}
+
+void FileWatcher::stop()
+{
+    running = false;
+#if defined(__linux__)
+    if (wakeFd >= 0)
+    {
+        const std::uint64_t one = 1;
+        (void)!write(wakeFd, &one, sizeof(one));
+    }
+#else
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+    }
+    stopSignal.notify_all();
+#endif
+    if (thread.joinable())
+        thread.join();
+#if defined(__linux__)
+    if (inotifyFd >= 0)
+        close(inotifyFd);
+    if (wakeFd >= 0)
+        close(wakeFd);
+    inotifyFd = wakeFd = -1;
+    watches.clear();
+#endif
+}
+
+bool FileWatcher::take(std::vector<std::string> &out, Clock::time_point &firstEvent)
+{
+    out.clear();
+    if (!ready.load(std::memory_order_relaxed))
+        return false;
+    std::lock_guard<std::mutex> lock(mutex);
+    out.swap(published);
+    firstEvent = publishedStart;
+    ready.store(false, std::memory_order_relaxed);
+    return !out.empty();
+}
+
+void FileWatcher::note(const std::string &path)
+{
+    const Clock::time_point now = Clock::now();
+    if (collecting.empty())
+        collectStart = now;
+    lastEvent = now;
+    if (std::find(collecting.begin(), collecting.end(), path) == collecting.end())
+        collecting.push_back(path);
+}
+
+std::chrono::milliseconds FileWatcher::flush()
+{
+    if (collecting.empty())
+        return std::chrono::milliseconds(-1);
+    const Clock::duration quiet = Clock::now() - lastEvent;
+    if (quiet < debounce)
+        return std::max(std::chrono::milliseconds(1),
+                        std::chrono::ceil<std::chrono::milliseconds>(debounce - quiet));
+
+    {
+        // Önceki parti henüz alınmadıysa birleştir
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!ready.load(std::memory_order_relaxed))
+        {
+            published.clear();
+            publishedStart = collectStart;
+        }
+        for (std::string &path : collecting)
+            if (std::find(published.begin(), published.end(), path) == published.end())
+                published.push_back(std::move(path));
+        ready.store(true, std::memory_order_relaxed);
+    }
+    collecting.clear();
+    if (onBatch)
+        onBatch();
+    return std::chrono::milliseconds(-1);
+}
+
+#if defined(__linux__)
+
+void FileWatcher::addTree(const std::string &directory)
+{
+    // Alt dizinler ayrı ayrı izlenir (inotify özyinelemeli değil)
+    const int wd = inotify_add_watch(inotifyFd, directory.c_str(),
+                                     IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+    if (wd < 0)
+        return;
+    watches[wd] = directory;
+    std::error_code ec;
+    for (const auto &entry : fs::directory_iterator(directory, ec))
+        if (entry.is_directory(ec) && !entry.is_symlink(ec))
+            addTree(normalPath(entry.path()));
+}
+
+void FileWatcher::runInotify()
+{
+    alignas(inotify_event) char buffer[16 * 1024];
+    while (running)
+    {
+        const std::chrono::milliseconds wait = flush();
+        pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        const int events = poll(fds, 2, wait.count() < 0 ? -1 : static_cast<int>(wait.count()));
+        if (events < 0 && errno != EINTR)
+            break;
+        if (events <= 0)
+            continue;
+        if (fds[1].revents)
+            break;
+
+        for (;;)
+        {
+            const ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+            if (length <= 0)
+                break;
+            for (const char *p = buffer; p < buffer + length;)
+            {
+                const inotify_event *event = reinterpret_cast<const inotify_event *>(p);
+                p += sizeof(inotify_event) + event->len;
+
+                auto it = watches.find(event->wd);
+                if (it == watches.end())
+                    continue;
+                if (event->mask & IN_IGNORED)
+                {
+                    watches.erase(it);
+                    continue;
+                }
+                if (event->len == 0)
+                    continue;
+                const std::string path = it->second + "/" + event->name;
+                if (event->mask & IN_ISDIR)
+                {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                        addTree(path);
+                }
+                else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                    note(path); // IN_CREATE tek başına değil: yazma bitince
+            }
+        }
+    }
+}
+
+#else
+
+void FileWatcher::scan(bool report)
+{
+    std::error_code ec;
+    for (const std::string &root : roots)
+    {
+        for (fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end;
+             it != end; it.increment(ec))
+        {
+            if (ec || !it->is_regular_file(ec))
+                continue;
+            const fs::file_time_type stamp = it->last_write_time(ec);
+            if (ec)
+                continue;
+            const std::string path = normalPath(it->path());
+            auto found = stamps.find(path);
+            if (found != stamps.end() && found->second == stamp)
+                continue;
+            stamps[path] = stamp;
+            if (report)
+                note(path);
+        }
+    }
+}
+
+void FileWatcher::runPolling()
+{
+    while (running)
+    {
+        const std::chrono::milliseconds pending = flush();
+        {
+            std::unique_lock<std::mutex> lock(stopMutex);
+            stopSignal.wait_for(lock, pending.count() < 0 ? POLL_INTERVAL : std::min(pending, POLL_INTERVAL),
+                                [this] { return !running; });
+        }
+        if (running)
+            scan(true);
+    }
+}
+
+#endif
@@ -0,0 +1,82 @@
+// FileWatcher.h
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Reports files written under a set of directories (recursively), from a
+// background thread. Linux uses inotify and sleeps until something happens;
+// elsewhere the tree is scanned for new modification times twice a second.
+// Events are debounced: a batch is published once no file has changed for
+// the debounce interval, so an editor's save (temp file, rename, touch)
+// becomes one entry. Paths are lexically normal with '/' separators, the
+// way they were given ("shaders/fragment.glsl").
+class FileWatcher
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    FileWatcher() = default;
+    ~FileWatcher();
+    FileWatcher(const FileWatcher &) = delete;
+    FileWatcher &operator=(const FileWatcher &) = delete;
+
+    // onBatch runs on the watcher thread after a batch is published
+    bool start(const std::vector<std::string> &directories, std::chrono::milliseconds debounce,
+               std::function<void()> onBatch, std::string &error);
+    void stop();
+    bool isRunning() const { return thread.joinable(); }
+
+    // Any thread; one relaxed load, nothing else
+    bool hasChanges() const { return ready.load(std::memory_order_relaxed); }
+    // Moves the published paths into out (cleared first); firstEvent is when
+    // the earliest of them changed. False if there was nothing.
+    bool take(std::vector<std::string> &out, Clock::time_point &firstEvent);
+
+private:
+    std::vector<std::string> roots;
+    std::chrono::milliseconds debounce{100};
+    std::function<void()> onBatch;
+    std::thread thread;
+    std::atomic<bool> running{false};
+
+    // Toplanan (henüz yayınlanmamış) değişiklikler: sadece izleyici thread'i
+    std::vector<std::string> collecting;
+    Clock::time_point collectStart, lastEvent;
+
+    // Yayınlanan parti
+    std::mutex mutex;
+    std::vector<std::string> published;
+    Clock::time_point publishedStart;
+    std::atomic<bool> ready{false};
+
+    void note(const std::string &path);
+    // Publishes the batch if it has been quiet long enough; returns the
+    // time left until it will be, or -1 ms when nothing is collected
+    std::chrono::milliseconds flush();
+
+#if defined(__linux__)
+    int inotifyFd = -1;
+    int wakeFd = -1; // eventfd: stop() uyandırır
+    std::unordered_map<int, std::string> watches; // wd -> dizin
+    void addTree(const std::string &directory);
+    void runInotify();
+#else
+    std::unordered_map<std::string, std::filesystem::file_time_type> stamps;
+    std::mutex stopMutex;
+    std::condition_variable stopSignal;
+    void scan(bool report);
+    void runPolling();
+#endif
+};
+
+#endif // FILEWATCHER_H
@@ -0,0 +1,44 @@
+// FixedStep.cpp
+#include "FixedStep.h"
+#include <algorithm>
+
+FixedStep::FixedStep(double rateHz, int max)
+    : maxSteps(std::max(max, 1))
+{
+    setRate(rateHz);
+}
+
+void FixedStep::setRate(double rateHz)
+{
+    rateHz = std::max(rateHz, 1.0);
+    if (rateHz == hz && step == 1.0 / hz)
+        return;
+    // Biriken süre yeni adım cinsinden korunur
+    double fraction = accumulator / step;
+    hz = rateHz;
+    step = 1.0 / hz;
+    accumulator = std::min(fraction, 0.999) * step;
+}
+
+int FixedStep::advance(double frameSeconds)
+{
+    frameSeconds = std::max(frameSeconds, 0.0);
+    double limit = maxSteps * step;
+    if (accumulator + frameSeconds > limit)
+    {
+        dropped += accumulator + frameSeconds - limit;
+        frameSeconds = limit - accumulator;
+    }
+    accumulator += frameSeconds;
+
+    int n = 0;
+    while (accumulator >= step && n < maxSteps)
+    {
+        accumulator -= step;
+        ++n;
+    }
+    // Kayan nokta artığı: bir sonraki adıma taşmasın
+    accumulator = std::min(accumulator, step * 0.999999);
+    steps += n;
+    return n;
+}
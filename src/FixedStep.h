@@ -0,0 +1,45 @@
+// FixedStep.h
+#ifndef FIXEDSTEP_H
+#define FIXEDSTEP_H
+
+// Fixed-rate simulation clock. Frame time is accumulated and consumed in
+// whole steps; the remainder gives the interpolation factor between the
+// previous and the current sim state. Frame time beyond maxSteps steps is
+// dropped so a long hitch can't snowball (spiral of death).
+class FixedStep
+{
+public:
+    explicit FixedStep(double hz = 60.0, int maxSteps = 8);
+
+    void setRate(double hz);
+    double rate() const { return hz; }
+    double dt() const { return step; }
+
+    // Adds one frame's wall time, returns the number of steps to run now
+    int advance(double frameSeconds);
+    // advance() + stepFn(dt) for each step: the main loop's sim update, also
+    // driven by --headless-sim with random frame times
+    template <typename StepFn>
+    int tick(double frameSeconds, StepFn &&stepFn)
+    {
+        int n = advance(frameSeconds);
+        for (int i = 0; i < n; ++i)
+            stepFn(static_cast<float>(step));
+        return n;
+    }
+    // Position between the last two sim states, [0, 1)
+    float alpha() const { return static_cast<float>(accumulator / step); }
+
+    unsigned long long totalSteps() const { return steps; }
+    double droppedSeconds() const { return dropped; }
+
+private:
+    double hz = 60.0;
+    double step = 1.0 / 60.0;
+    int maxSteps = 8;
+    double accumulator = 0.0;
+    unsigned long long steps = 0;
+    double dropped = 0.0;
+};
+
+#endif // FIXEDSTEP_H
@@ -0,0 +1,30 @@
+// FrameArena.cpp
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+
+FrameArena::FrameArena(std::size_t capacity)
+    : memory(new unsigned char[capacity]), size(capacity)
+{
+}
+
+void *FrameArena::allocate(std::size_t bytes, std::size_t align)
+{
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(memory.get());
+    std::size_t current = offset.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        std::uintptr_t aligned = (base + current + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+        std::size_t next = static_cast<std::size_t>(aligned - base) + bytes;
+        if (next > size)
+            return nullptr;
+        if (offset.compare_exchange_weak(current, next, std::memory_order_relaxed))
+            return reinterpret_cast<void *>(aligned);
+    }
+}
+
+void FrameArena::reset()
+{
+    peak = std::max(peak, offset.load(std::memory_order_relaxed));
+    offset.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,41 @@
+// FrameArena.h
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// Linear allocator for data that lives at most one frame. Allocation is a
+// lock-free bump of an offset and may happen from any thread; everything is
+// released at once by reset(). Returns nullptr when full so callers can fall
+// back to the heap.
+class FrameArena
+{
+public:
+    explicit FrameArena(std::size_t capacity = 1 << 20);
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    void *allocate(std::size_t size, std::size_t align = alignof(std::max_align_t));
+    template <typename T>
+    T *allocateArray(std::size_t count)
+    {
+        return static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // No allocation from this arena may still be in use
+    void reset();
+
+    std::size_t used() const { return offset.load(std::memory_order_relaxed); }
+    std::size_t capacity() const { return size; }
+    std::size_t highWater() const { return peak; }
+
+private:
+    std::unique_ptr<unsigned char[]> memory;
+    std::size_t size;
+    std::atomic<std::size_t> offset{0};
+    std::size_t peak = 0;
+};
+
+#endif // FRAMEARENA_H
@@ -0,0 +1,56 @@
+// FrameCache.cpp
+#include "FrameCache.h"
+#include "RenderCounters.h"
+#include <glad/glad.h>
+
+FrameCache::~FrameCache()
+{
+    if (fbo)
+    {
+        glDeleteFramebuffers(1, &fbo);
+        glDeleteRenderbuffers(1, &color);
+        RenderCounters::trackTexture(-static_cast<std::int64_t>(width) * height * 4);
+    }
+}
+
+void FrameCache::capture(int w, int h)
+{
+    if (w <= 0 || h <= 0)
+        return;
+    if (!fbo)
+    {
+        glGenFramebuffers(1, &fbo);
+        glGenRenderbuffers(1, &color);
+    }
+    // Sadece pencere boyutu değişince yeniden ayır
+    if (w != width || h != height)
+    {
+        RenderCounters::trackTexture((static_cast<std::int64_t>(w) * h - static_cast<std::int64_t>(width) * height) * 4);
+        width = w;
+        height = h;
+        glBindRenderbuffer(GL_RENDERBUFFER, color);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glReadBuffer(GL_BACK);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+    glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    valid = true;
+}
+
+bool FrameCache::present(int w, int h) const
+{
+    if (!valid || w != width || h != height)
+        return false;
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glDrawBuffer(GL_BACK);
+    glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return true;
+}
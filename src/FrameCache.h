@@ -0,0 +1,26 @@
+// FrameCache.h
+#ifndef FRAMECACHE_H
+#define FRAMECACHE_H
+
+// Copy of the last presented frame (scene + UI). Idle iterations blit it
+// back into the back buffer instead of rendering the scene again.
+class FrameCache
+{
+public:
+    FrameCache() = default;
+    ~FrameCache();
+    FrameCache(const FrameCache &) = delete;
+    FrameCache &operator=(const FrameCache &) = delete;
+
+    // Copies the default framebuffer's back buffer (call before swap)
+    void capture(int width, int height);
+    // Restores it into the back buffer; false if nothing valid is cached
+    bool present(int width, int height) const;
+
+private:
+    int width = 0, height = 0;
+    unsigned int fbo = 0, color = 0;
+    bool valid = false;
+};
+
+#endif // FRAMECACHE_H
@@ -0,0 +1,151 @@
+// FramePacer.cpp
+#include "FramePacer.h"
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+FramePacer::FramePacer()
+{
+    tearControl = glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+                  glfwExtensionSupported("GLX_EXT_swap_control_tear");
+}
+
+FramePacer::~FramePacer()
+{
+    for (Pending &p : frames)
+        if (p.fence)
+            glDeleteSync(static_cast<GLsync>(p.fence));
+}
+
+void FramePacer::applyMode(PacingMode mode)
+{
+    if (applied && mode == appliedMode)
+        return;
+    switch (mode)
+    {
+    case PacingMode::VSync:
+        glfwSwapInterval(1);
+        break;
+    case PacingMode::Adaptive:
+        // Geç kalan frame'de yırtılmaya izin ver, yoksa düz vsync
+        glfwSwapInterval(tearControl ? -1 : 1);
+        break;
+    case PacingMode::Limited:
+    case PacingMode::Unlimited:
+        glfwSwapInterval(0);
+        break;
+    }
+    appliedMode = mode;
+    applied = true;
+}
+
+// Hibrit bekleme: sleep_for kaba olduğundan hedefin biraz öncesine kadar
+// uyu, kalanını meşgul bekle. Pay, ölçülen uyku taşmasına göre ayarlanır.
+void FrameLimiter::wait(const RenderSettings &settings)
+{
+    if (settings.pacing != PacingMode::Limited)
+    {
+        nextDeadline = 0.0; // moda geri dönünce ritim yeniden başlar
+        limiterMs = 0.0f;
+        return;
+    }
+    const double period = 1.0 / std::max(settings.targetFps, 1);
+    double now = glfwGetTime();
+    if (nextDeadline == 0.0 || now > nextDeadline + period)
+        nextDeadline = now; // çok geride kaldık: ritmi yeniden başlat
+
+    double start = now;
+    double sleepUntil = nextDeadline - sleepMargin;
+    if (sleepUntil > now)
+    {
+        double requested = sleepUntil - now;
+        std::this_thread::sleep_for(std::chrono::duration<double>(requested));
+        double overshoot = glfwGetTime() - now - requested;
+        sleepMargin = std::clamp(sleepMargin * 0.9 + std::max(overshoot, 0.0) * 1.5 * 0.1, 0.0002, 0.004);
+    }
+    while ((now = glfwGetTime()) < nextDeadline)
+        std::this_thread::yield();
+
+    limiterMs = static_cast<float>((now - start) * 1000.0);
+    nextDeadline += period;
+}
+
+// Sinyallenen fence'leri topla; block ise en fazla keep tane kalana kadar bekle
+void FramePacer::collect(bool block, int keep)
+{
+    while (count > 0)
+    {
+        Pending &oldest = frames[(head - count + MAX_IN_FLIGHT) % MAX_IN_FLIGHT];
+        GLsync fence = static_cast<GLsync>(oldest.fence);
+        bool mustWait = block && count > keep;
+        GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                         mustWait ? 100000000ull : 0); // 100 ms dilimler
+        if (status == GL_TIMEOUT_EXPIRED)
+        {
+            // Frame bitmedi: fence bekleyen kalır, sınır korunur (beklemeye devam)
+            if (!mustWait)
+                break;
+            ++stalls;
+            continue;
+        }
+
+        // GL_WAIT_FAILED (ör. kayıp bağlam): gecikme örneği yok
+        if (oldest.inputTime >= 0.0 && (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED))
+        {
+            float ms = static_cast<float>((glfwGetTime() - oldest.inputTime) * 1000.0);
+            latencyMs = latencyMs == 0.0f ? ms : latencyMs * 0.9f + ms * 0.1f;
+        }
+        glDeleteSync(fence);
+        oldest.fence = nullptr;
+        --count;
+    }
+}
+
+void FramePacer::beginFrame(const RenderSettings &settings)
+{
+    applyMode(settings.pacing);
+
+    // GPU kuyruğu: sürücü çok frame biriktirirse giriş gecikmesi artar
+    double t0 = glfwGetTime();
+    int maxInFlight = std::clamp(settings.maxFramesInFlight, 1, MAX_IN_FLIGHT - 1);
+    collect(true, maxInFlight - 1);
+    double now = glfwGetTime();
+    throttleMs = static_cast<float>((now - t0) * 1000.0);
+
+    if (lastBegin >= 0.0)
+    {
+        float dt = static_cast<float>((now - lastBegin) * 1000.0);
+        frameAvgMs = frameAvgMs == 0.0f ? dt : frameAvgMs * 0.95f + dt * 0.05f;
+        jitterMs = jitterMs * 0.95f + std::fabs(dt - frameAvgMs) * 0.05f;
+    }
+    lastBegin = now;
+    frameInput = -1.0;
+}
+
+void FramePacer::consumeInput(double inputTime)
+{
+    if (inputTime >= 0.0 && (frameInput < 0.0 || inputTime < frameInput))
+        frameInput = inputTime;
+}
+
+void FramePacer::skipFrame()
+{
+    lastBegin = -1.0;
+}
+
+void FramePacer::endFrame()
+{
+    collect(false, 0);
+    if (count == MAX_IN_FLIGHT)
+        collect(true, MAX_IN_FLIGHT - 1);
+
+    Pending &slot = frames[head];
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.inputTime = frameInput;
+    head = (head + 1) % MAX_IN_FLIGHT;
+    ++count;
+    glFlush(); // fence sürücüde beklemesin
+}
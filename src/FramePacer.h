@@ -0,0 +1,80 @@
+// FramePacer.h
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include "RenderSettings.h"
+
+// Frame rate limiter (PacingMode::Limited). Runs on the main thread before
+// input is polled, so the wait happens before the camera is sampled and not
+// between sampling and rendering.
+class FrameLimiter
+{
+public:
+    // Sleeps until the next frame deadline; no-op in the other modes
+    void wait(const RenderSettings &settings);
+    // Loop iteration that did not render (idle): restart the rhythm
+    void restart() { nextDeadline = 0.0; }
+    float waitMs() const { return limiterMs; }
+
+private:
+    double nextDeadline = 0.0;
+    double sleepMargin = 0.002; // s, uyku taşmasına göre ayarlanır
+    float limiterMs = 0.0f;
+};
+
+// Swap interval selection and a cap on GPU frames in flight (render side).
+// Also tracks input-to-present latency: the time of the oldest input
+// consumed by a frame is stored with that frame's fence and compared with
+// the moment the fence signals (GPU done, swap queued).
+class FramePacer
+{
+public:
+    FramePacer();
+    ~FramePacer();
+    FramePacer(const FramePacer &) = delete;
+    FramePacer &operator=(const FramePacer &) = delete;
+
+    // Start of a rendered frame: applies mode changes and waits until fewer
+    // than maxFramesInFlight frames are queued
+    void beginFrame(const RenderSettings &settings);
+    // Oldest input time (glfwGetTime) that this frame reacts to, < 0 if none
+    void consumeInput(double inputTime);
+    // After glfwSwapBuffers
+    void endFrame();
+    // Loop iteration that did not render (idle): restart the rhythm
+    void skipFrame();
+
+    float gpuWaitMs() const { return throttleMs; }
+    float inputLatencyMs() const { return latencyMs; }
+    // Fence waits that hit the 100 ms timeout (GPU backed up)
+    unsigned long long gpuStalls() const { return stalls; }
+    float frameMs() const { return frameAvgMs; }
+    float frameJitterMs() const { return jitterMs; }
+    bool adaptiveSupported() const { return tearControl; }
+
+private:
+    static constexpr int MAX_IN_FLIGHT = 4;
+    struct Pending
+    {
+        void *fence = nullptr; // GLsync
+        double inputTime = -1.0;
+    };
+    Pending frames[MAX_IN_FLIGHT];
+    int head = 0, count = 0;
+    double frameInput = -1.0;
+
+    PacingMode appliedMode = PacingMode::VSync;
+    bool applied = false;
+    bool tearControl = false;
+
+    double lastBegin = -1.0;
+
+    float throttleMs = 0.0f, latencyMs = 0.0f;
+    unsigned long long stalls = 0;
+    float frameAvgMs = 0.0f, jitterMs = 0.0f;
+
+    void applyMode(PacingMode mode);
+    void collect(bool block, int keep);
+};
+
+#endif // FRAMEPACER_H
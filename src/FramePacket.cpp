@@ -0,0 +1,48 @@
+// FramePacket.cpp
+#include "FramePacket.h"
+#include <cstring>
+
+UiDrawData::~UiDrawData()
+{
+    for (ImDrawList *list : lists)
+        IM_DELETE(list);
+}
+
+template <typename T>
+static void copyBuffer(ImVector<T> &dst, const ImVector<T> &src)
+{
+    // ImVector::operator= belleği bırakıp yeniden ayırır; resize kapasiteyi korur
+    dst.resize(src.Size);
+    if (src.Size > 0)
+        std::memcpy(dst.Data, src.Data, src.size_in_bytes());
+}
+
+void UiDrawData::capture(const ImDrawData *src)
+{
+    valid = src && src->Valid;
+    if (!valid)
+        return;
+
+    while (static_cast<int>(lists.size()) < src->CmdListsCount)
+        lists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+
+    data.Valid = true;
+    data.CmdListsCount = src->CmdListsCount;
+    data.TotalIdxCount = src->TotalIdxCount;
+    data.TotalVtxCount = src->TotalVtxCount;
+    data.DisplayPos = src->DisplayPos;
+    data.DisplaySize = src->DisplaySize;
+    data.FramebufferScale = src->FramebufferScale;
+    data.OwnerViewport = nullptr;
+    data.CmdLists.resize(src->CmdListsCount);
+    for (int i = 0; i < src->CmdListsCount; ++i)
+    {
+        const ImDrawList *from = src->CmdLists[i];
+        ImDrawList *to = lists[i];
+        copyBuffer(to->CmdBuffer, from->CmdBuffer);
+        copyBuffer(to->IdxBuffer, from->IdxBuffer);
+        copyBuffer(to->VtxBuffer, from->VtxBuffer);
+        to->Flags = from->Flags;
+        data.CmdLists[i] = to;
+    }
+}
@@ -0,0 +1,57 @@
+// FramePacket.h
+#ifndef FRAMEPACKET_H
+#define FRAMEPACKET_H
+
+#include <cstdint>
+#include <vector>
+#include <imgui.h>
+#include "Renderer.h"
+#include "RenderSettings.h"
+#include "Robot.h"
+#include "Lights.h"
+
+// Deep copy of ImGui's draw lists, so the render thread can draw the UI
+// while the main thread already builds the next frame. Buffers are kept
+// between frames and only grow.
+class UiDrawData
+{
+public:
+    UiDrawData() = default;
+    ~UiDrawData();
+    UiDrawData(const UiDrawData &) = delete;
+    UiDrawData &operator=(const UiDrawData &) = delete;
+
+    void capture(const ImDrawData *src);
+    ImDrawData *get() { return valid ? &data : nullptr; }
+
+private:
+    std::vector<ImDrawList *> lists;
+    ImDrawData data;
+    bool valid = false;
+};
+
+// Everything the render side needs for one frame. Written only by the main
+// thread, read only by the render thread once published.
+struct FramePacket
+{
+    unsigned long long frameIndex = 0;
+
+    // Idle mode: show the cached frame again, nothing else is valid
+    bool presentCached = false;
+    // Store this frame in the cache after drawing (last frame before idle)
+    bool captureFrame = false;
+
+    FrameView view;
+    RenderSettings settings;
+    RobotPose robotPose;
+    std::vector<SpotLight> lights;
+    std::vector<std::uint32_t> visibleModels; // view.visibleModels buraya işaret eder
+
+    // Single-thread mode points at ImGui's own data, otherwise at uiCopy
+    ImDrawData *ui = nullptr;
+    UiDrawData uiCopy;
+
+    double inputTime = -1.0; // oldest input this frame reacts to (glfwGetTime)
+};
+
+#endif // FRAMEPACKET_H
@@ -0,0 +1,78 @@
+// Frustum.cpp
+#include "Frustum.h"
+#include "JobSystem.h"
+#include "GeometryKernels.h"
+
+Frustum Frustum::fromMatrix(const glm::mat4 &m)
+{
+    // glm sütun-öncelikli: satır i = (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&m](int i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+    const glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    Frustum f;
+    f.planes[0] = r3 + r0; // sol
+    f.planes[1] = r3 - r0; // sağ
+    f.planes[2] = r3 + r1; // alt
+    f.planes[3] = r3 - r1; // üst
+    f.planes[4] = r3 + r2; // yakın
+    f.planes[5] = r3 - r2; // uzak
+    for (glm::vec4 &p : f.planes)
+        p /= glm::length(glm::vec3(p));
+    return f;
+}
+
+bool Frustum::intersectsSphere(const glm::vec3 &center, float radius) const
+{
+    for (const glm::vec4 &p : planes)
+    {
+        if (glm::dot(glm::vec3(p), center) + p.w < -radius)
+            return false;
+    }
+    return true;
+}
+
+void cullSpheres(const Frustum &frustum, const std::vector<glm::vec4> &spheres,
+                 std::vector<std::uint32_t> &visible)
+{
+    // SoA kopya + bayraklar frame arena'dan (parçalar birbirinden bağımsız yazar),
+    // sonra sıralı sıkıştırma. Arena doluysa thread'e özel, büyüyen tampon.
+    const std::size_t count = spheres.size();
+    JobSystem &jobs = JobSystem::get();
+    FrameArena &arena = jobs.frameArena();
+    float *soa = arena.allocateArray<float>(count * 4);
+    unsigned char *flags = arena.allocateArray<unsigned char>(count);
+    if (!soa || !flags)
+    {
+        static thread_local std::vector<float> fallbackSoa;
+        static thread_local std::vector<unsigned char> fallbackFlags;
+        fallbackSoa.resize(count * 4);
+        fallbackFlags.resize(count);
+        soa = fallbackSoa.data();
+        flags = fallbackFlags.data();
+    }
+    float *x = soa, *y = soa + count, *z = soa + count * 2, *r = soa + count * 3;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        x[i] = spheres[i].x;
+        y[i] = spheres[i].y;
+        z[i] = spheres[i].z;
+        r[i] = spheres[i].w;
+    }
+
+    float planes[24];
+    for (int p = 0; p < 6; ++p)
+        for (int k = 0; k < 4; ++k)
+            planes[p * 4 + k] = frustum.planes[p][k];
+
+    const GeometryKernels &kernels = geometryKernels();
+    jobs.parallelFor(count, [&](std::size_t begin, std::size_t end)
+                     { kernels.testSpheres(planes, x + begin, y + begin, z + begin, r + begin, end - begin, flags + begin); });
+
+    // visible kapasitesini korur; ısındıktan sonra ayırma yok
+    visible.clear();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (flags[i])
+            visible.push_back(static_cast<std::uint32_t>(i));
+    }
+}
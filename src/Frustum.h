@@ -0,0 +1,24 @@
+// Frustum.h
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// View frustum as six planes (ax + by + cz + d >= 0 inside), extracted from
+// projection * view (Gribb & Hartmann).
+struct Frustum
+{
+    glm::vec4 planes[6];
+
+    static Frustum fromMatrix(const glm::mat4 &viewProjection);
+    bool intersectsSphere(const glm::vec3 &center, float radius) const;
+};
+
+// Indices of the spheres (xyz center, w radius) that touch the frustum, in
+// ascending order. Large inputs are split over the job system.
+void cullSpheres(const Frustum &frustum, const std::vector<glm::vec4> &spheres,
+                 std::vector<std::uint32_t> &visible);
+
+#endif // FRUSTUM_H
@@ -0,0 +1,80 @@
+// GBuffer.cpp
+#include "GBuffer.h"
+#include "RenderCounters.h"
+#include <glad/glad.h>
+#include <iostream>
+
+// RGBA8 + RGBA16F + D32F
+static constexpr std::int64_t BYTES_PER_PIXEL = 4 + 8 + 4;
+
+GBuffer::~GBuffer()
+{
+    release();
+}
+
+void GBuffer::release()
+{
+    if (!fbo)
+        return;
+    glDeleteFramebuffers(1, &fbo);
+    unsigned int textures[3] = {albedoSpec, normalShininess, depth};
+    glDeleteTextures(3, textures);
+    RenderCounters::trackTexture(-static_cast<std::int64_t>(width) * height * BYTES_PER_PIXEL);
+    fbo = albedoSpec = normalShininess = depth = 0;
+}
+
+static unsigned int createTarget(GLenum internalFormat, GLenum format, GLenum type, int width, int height)
+{
+    unsigned int tex;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, nullptr);
+    // Işık geçişi texelFetch ile okur; filtre yok
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return tex;
+}
+
+void GBuffer::resize(int w, int h)
+{
+    if (w == width && h == height && fbo)
+        return;
+    release();
+    width = w;
+    height = h;
+
+    albedoSpec = createTarget(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, w, h);
+    normalShininess = createTarget(GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, w, h);
+    depth = createTarget(GL_DEPTH_COMPONENT32F, GL_DEPTH_COMPONENT, GL_FLOAT, w, h);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    RenderCounters::trackTexture(static_cast<std::int64_t>(w) * h * BYTES_PER_PIXEL);
+
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, albedoSpec, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, normalShininess, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth, 0);
+    const GLenum drawBuffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(2, drawBuffers);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "ERROR::GBUFFER: framebuffer incomplete (" << w << "x" << h << ")" << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void GBuffer::bindForWriting() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+}
+
+void GBuffer::bindTextures() const
+{
+    const unsigned int textures[3] = {albedoSpec, normalShininess, depth};
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        glActiveTexture(GL_TEXTURE0 + GBUFFER_TEXTURE_UNIT + i);
+        glBindTexture(GL_TEXTURE_2D, textures[i]);
+    }
+    glActiveTexture(GL_TEXTURE0);
+}
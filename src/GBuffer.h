@@ -0,0 +1,37 @@
+// GBuffer.h
+#ifndef GBUFFER_H
+#define GBUFFER_H
+
+// G-buffer textures are read from these units (0-1 materials, 2 transforms)
+constexpr unsigned int GBUFFER_TEXTURE_UNIT = 4;
+
+// Deferred shading targets:
+//   0: RGBA8   albedo.rgb, specular mask
+//   1: RGBA16F octahedral normal.xy, shininess, (unused)
+//   depth: DEPTH_COMPONENT32F, world position is reconstructed from it
+class GBuffer
+{
+public:
+    GBuffer() = default;
+    ~GBuffer();
+    GBuffer(const GBuffer &) = delete;
+    GBuffer &operator=(const GBuffer &) = delete;
+
+    // Reallocates only when the size changes
+    void resize(int width, int height);
+    void bindForWriting() const;
+    // Binds albedo / normal / depth to GBUFFER_TEXTURE_UNIT + 0..2
+    void bindTextures() const;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    int width = 0, height = 0;
+    unsigned int fbo = 0;
+    unsigned int albedoSpec = 0, normalShininess = 0, depth = 0;
+
+    void release();
+};
+
+#endif // GBUFFER_H
@@ -0,0 +1,242 @@
+// GeometryKernels.cpp
+// Scalar reference kernels and runtime (CPUID) selection.
+#include "GeometryKernels.h"
+#include "GeometryKernelsInternal.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if GEOMETRY_KERNELS_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace
+{
+    void minMaxScalar(const float *x, const float *y, const float *z, std::size_t count,
+                      float outMin[3], float outMax[3])
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            outMin[0] = std::min(outMin[0], x[i]);
+            outMin[1] = std::min(outMin[1], y[i]);
+            outMin[2] = std::min(outMin[2], z[i]);
+            outMax[0] = std::max(outMax[0], x[i]);
+            outMax[1] = std::max(outMax[1], y[i]);
+            outMax[2] = std::max(outMax[2], z[i]);
+        }
+    }
+
+    void transformPointsScalar(const float m[16], const float *x, const float *y, const float *z,
+                               std::size_t count, float *outX, float *outY, float *outZ)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float px = x[i], py = y[i], pz = z[i];
+            outX[i] = m[0] * px + m[4] * py + m[8] * pz + m[12];
+            outY[i] = m[1] * px + m[5] * py + m[9] * pz + m[13];
+            outZ[i] = m[2] * px + m[6] * py + m[10] * pz + m[14];
+        }
+    }
+
+    void transformMinMaxScalar(const float m[16], const float *x, const float *y, const float *z,
+                               std::size_t count, float outMin[3], float outMax[3])
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float px = x[i], py = y[i], pz = z[i];
+            const float wx = m[0] * px + m[4] * py + m[8] * pz + m[12];
+            const float wy = m[1] * px + m[5] * py + m[9] * pz + m[13];
+            const float wz = m[2] * px + m[6] * py + m[10] * pz + m[14];
+            outMin[0] = std::min(outMin[0], wx);
+            outMin[1] = std::min(outMin[1], wy);
+            outMin[2] = std::min(outMin[2], wz);
+            outMax[0] = std::max(outMax[0], wx);
+            outMax[1] = std::max(outMax[1], wy);
+            outMax[2] = std::max(outMax[2], wz);
+        }
+    }
+
+    float maxDistanceSqScalar(const float *x, const float *y, const float *z, std::size_t count,
+                              const float center[3])
+    {
+        float best = 0.0f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float dx = x[i] - center[0], dy = y[i] - center[1], dz = z[i] - center[2];
+            best = std::max(best, dx * dx + dy * dy + dz * dz);
+        }
+        return best;
+    }
+
+    void testSpheresScalar(const float planes[24], const float *x, const float *y, const float *z,
+                           const float *radius, std::size_t count, unsigned char *visible)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            unsigned char inside = 1;
+            for (int p = 0; p < 6; ++p)
+            {
+                const float *plane = planes + p * 4;
+                const float d = plane[0] * x[i] + plane[1] * y[i] + plane[2] * z[i] + plane[3];
+                if (d < -radius[i])
+                    inside = 0;
+            }
+            visible[i] = inside;
+        }
+    }
+
+    const GeometryKernels SCALAR_KERNELS = {
+        SimdLevel::Scalar,
+        minMaxScalar,
+        transformPointsScalar,
+        transformMinMaxScalar,
+        maxDistanceSqScalar,
+        testSpheresScalar};
+
+#if GEOMETRY_KERNELS_X86
+    void cpuid(int leaf, int subleaf, unsigned int regs[4])
+    {
+#if defined(_MSC_VER)
+        int out[4];
+        __cpuidex(out, leaf, subleaf);
+        for (int i = 0; i < 4; ++i)
+            regs[i] = static_cast<unsigned int>(out[i]);
+#else
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+
+    // İşletim sisteminin kaydettiği register durumları (XCR0)
+    unsigned long long xgetbv0()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        unsigned int eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+    }
+#endif
+
+    SimdLevel hardwareLevel()
+    {
+#if GEOMETRY_KERNELS_X86
+        unsigned int regs[4];
+        cpuid(0, 0, regs);
+        const unsigned int maxLeaf = regs[0];
+        cpuid(1, 0, regs);
+        const unsigned int ecx1 = regs[2];
+        if (!(ecx1 & (1u << 19)))
+            return SimdLevel::Scalar;
+
+        // AVX: CPU desteği + OSXSAVE + OS'un YMM durumunu kaydetmesi
+        const bool osxsave = (ecx1 & (1u << 27)) && (ecx1 & (1u << 28));
+        const unsigned long long xcr0 = osxsave ? xgetbv0() : 0;
+        if (maxLeaf < 7 || (xcr0 & 0x6) != 0x6)
+            return SimdLevel::SSE41;
+        cpuid(7, 0, regs);
+        const unsigned int ebx7 = regs[1];
+        if (!(ebx7 & (1u << 5)))
+            return SimdLevel::SSE41;
+        // AVX-512F: opmask + ZMM durumları da gerekli
+        if ((ebx7 & (1u << 16)) && (xcr0 & 0xE6) == 0xE6)
+            return SimdLevel::AVX512;
+        return SimdLevel::AVX2;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    const GeometryKernels *compiledTable(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::AVX512:
+            return geometryKernelsAVX512();
+        case SimdLevel::AVX2:
+            return geometryKernelsAVX2();
+        case SimdLevel::SSE41:
+            return geometryKernelsSSE41();
+        case SimdLevel::Scalar:
+            break;
+        }
+        return &SCALAR_KERNELS;
+    }
+}
+
+const GeometryKernels &geometryKernelsScalar()
+{
+    return SCALAR_KERNELS;
+}
+
+const char *simdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::SSE41:
+        return "sse41";
+    case SimdLevel::AVX2:
+        return "avx2";
+    case SimdLevel::AVX512:
+        return "avx512";
+    case SimdLevel::Scalar:
+        break;
+    }
+    return "scalar";
+}
+
+SimdLevel detectSimdLevel()
+{
+    SimdLevel level = hardwareLevel();
+    if (const char *cap = std::getenv("VM_SIMD"))
+    {
+        for (SimdLevel l : {SimdLevel::Scalar, SimdLevel::SSE41, SimdLevel::AVX2, SimdLevel::AVX512})
+        {
+            if (std::strcmp(cap, simdLevelName(l)) == 0 && l < level)
+                level = l;
+        }
+    }
+    return level;
+}
+
+const GeometryKernels *geometryKernelsFor(SimdLevel level)
+{
+    if (level > hardwareLevel())
+        return nullptr;
+    const GeometryKernels *table = compiledTable(level);
+    return table && table->level == level ? table : nullptr;
+}
+
+const GeometryKernels &geometryKernels()
+{
+    static const GeometryKernels *selected = []
+    {
+        // En iyi derlenmiş ve desteklenen seviyeye in
+        SimdLevel level = detectSimdLevel();
+        for (;;)
+        {
+            if (const GeometryKernels *table = geometryKernelsFor(level))
+                return table;
+            level = static_cast<SimdLevel>(static_cast<int>(level) - 1);
+        }
+    }();
+    return *selected;
+}
+
+void PositionStreams::assign(const Vertex *vertices, std::size_t count)
+{
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        x[i] = vertices[i].Position.x;
+        y[i] = vertices[i].Position.y;
+        z[i] = vertices[i].Position.z;
+    }
+}
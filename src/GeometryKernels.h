@@ -0,0 +1,61 @@
+// GeometryKernels.h
+#ifndef GEOMETRYKERNELS_H
+#define GEOMETRYKERNELS_H
+
+#include <cstddef>
+#include <vector>
+#include "Mesh.h"
+
+enum class SimdLevel
+{
+    Scalar,
+    SSE41,
+    AVX2,
+    AVX512
+};
+
+// Bulk geometry loops over structure-of-arrays float streams. Every SIMD
+// path computes the same thing as the scalar reference; min/max and the
+// sphere tests are exact, transforms may differ by rounding (FMA).
+// Matrices are column-major (glm layout) and treated as affine: w is ignored.
+struct GeometryKernels
+{
+    SimdLevel level;
+
+    // min/max over the points, merged into the existing contents of outMin/outMax
+    void (*minMax)(const float *x, const float *y, const float *z, std::size_t count,
+                   float outMin[3], float outMax[3]);
+    // out = M * (x, y, z, 1); output may alias the input
+    void (*transformPoints)(const float m[16], const float *x, const float *y, const float *z,
+                            std::size_t count, float *outX, float *outY, float *outZ);
+    // minMax(transformPoints(...)) without writing the points
+    void (*transformMinMax)(const float m[16], const float *x, const float *y, const float *z,
+                            std::size_t count, float outMin[3], float outMax[3]);
+    // Largest squared distance to center (radius of a bounding sphere)
+    float (*maxDistanceSq)(const float *x, const float *y, const float *z, std::size_t count,
+                           const float center[3]);
+    // planes: 6 x (a, b, c, d), inside when dot + d >= -radius; visible[i] = 0/1
+    void (*testSpheres)(const float planes[24], const float *x, const float *y, const float *z,
+                        const float *radius, std::size_t count, unsigned char *visible);
+};
+
+// Highest level the CPU and OS support. VM_SIMD=scalar|sse41|avx2|avx512
+// in the environment caps it (for comparisons and bug hunting).
+SimdLevel detectSimdLevel();
+const char *simdLevelName(SimdLevel level);
+
+// Best supported table, chosen once
+const GeometryKernels &geometryKernels();
+// nullptr if the level isn't compiled in or not supported by this CPU
+const GeometryKernels *geometryKernelsFor(SimdLevel level);
+
+// SoA copy of vertex positions, the input format of the kernels
+struct PositionStreams
+{
+    std::vector<float> x, y, z;
+
+    void assign(const Vertex *vertices, std::size_t count);
+    std::size_t size() const { return x.size(); }
+};
+
+#endif // GEOMETRYKERNELS_H
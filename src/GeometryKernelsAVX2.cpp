@@ -0,0 +1,41 @@
+// GeometryKernelsAVX2.cpp
+// Compiled with AVX2 enabled (see CMakeLists.txt); only called after CPUID.
+#include "GeometryKernelsInternal.h"
+
+#if GEOMETRY_KERNELS_X86
+#include <immintrin.h>
+
+namespace
+{
+    struct Avx2Ops
+    {
+        using V = __m256;
+        static constexpr int W = 8;
+        static V load(const float *p) { return _mm256_loadu_ps(p); }
+        static void store(float *p, V v) { _mm256_storeu_ps(p, v); }
+        static V set1(float f) { return _mm256_set1_ps(f); }
+        static V add(V a, V b) { return _mm256_add_ps(a, b); }
+        static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+        static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+        static V min(V a, V b) { return _mm256_min_ps(a, b); }
+        static V max(V a, V b) { return _mm256_max_ps(a, b); }
+        static unsigned int lessMask(V a, V b)
+        {
+            return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)));
+        }
+    };
+}
+
+#include "GeometryKernelsSimd.h"
+
+const GeometryKernels *geometryKernelsAVX2()
+{
+    static const GeometryKernels table = makeKernels<Avx2Ops>(SimdLevel::AVX2);
+    return &table;
+}
+#else
+const GeometryKernels *geometryKernelsAVX2()
+{
+    return nullptr;
+}
+#endif
@@ -0,0 +1,41 @@
+// GeometryKernelsAVX512.cpp
+// Compiled with AVX-512F enabled (see CMakeLists.txt); only called after CPUID.
+#include "GeometryKernelsInternal.h"
+
+#if GEOMETRY_KERNELS_X86
+#include <immintrin.h>
+
+namespace
+{
+    struct Avx512Ops
+    {
+        using V = __m512;
+        static constexpr int W = 16;
+        static V load(const float *p) { return _mm512_loadu_ps(p); }
+        static void store(float *p, V v) { _mm512_storeu_ps(p, v); }
+        static V set1(float f) { return _mm512_set1_ps(f); }
+        static V add(V a, V b) { return _mm512_add_ps(a, b); }
+        static V sub(V a, V b) { return _mm512_sub_ps(a, b); }
+        static V mul(V a, V b) { return _mm512_mul_ps(a, b); }
+        static V min(V a, V b) { return _mm512_min_ps(a, b); }
+        static V max(V a, V b) { return _mm512_max_ps(a, b); }
+        static unsigned int lessMask(V a, V b)
+        {
+            return static_cast<unsigned int>(_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ));
+        }
+    };
+}
+
+#include "GeometryKernelsSimd.h"
+
+const GeometryKernels *geometryKernelsAVX512()
+{
+    static const GeometryKernels table = makeKernels<Avx512Ops>(SimdLevel::AVX512);
+    return &table;
+}
+#else
+const GeometryKernels *geometryKernelsAVX512()
+{
+    return nullptr;
+}
+#endif
@@ -0,0 +1,21 @@
+// GeometryKernelsInternal.h
+// Tables of the ISA-specific translation units, each compiled with its own
+// instruction set flags. Only included by GeometryKernels*.cpp.
+#ifndef GEOMETRYKERNELSINTERNAL_H
+#define GEOMETRYKERNELSINTERNAL_H
+
+#include "GeometryKernels.h"
+
+const GeometryKernels &geometryKernelsScalar();
+// nullptr when not built for x86
+const GeometryKernels *geometryKernelsSSE41();
+const GeometryKernels *geometryKernelsAVX2();
+const GeometryKernels *geometryKernelsAVX512();
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GEOMETRY_KERNELS_X86 1
+#else
+#define GEOMETRY_KERNELS_X86 0
+#endif
+
+#endif // GEOMETRYKERNELSINTERNAL_H
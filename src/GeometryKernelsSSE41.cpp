@@ -0,0 +1,38 @@
+// GeometryKernelsSSE41.cpp
+// Compiled with SSE4.1 enabled (see CMakeLists.txt); only called after CPUID.
+#include "GeometryKernelsInternal.h"
+
+#if GEOMETRY_KERNELS_X86
+#include <smmintrin.h>
+
+namespace
+{
+    struct SseOps
+    {
+        using V = __m128;
+        static constexpr int W = 4;
+        static V load(const float *p) { return _mm_loadu_ps(p); }
+        static void store(float *p, V v) { _mm_storeu_ps(p, v); }
+        static V set1(float f) { return _mm_set1_ps(f); }
+        static V add(V a, V b) { return _mm_add_ps(a, b); }
+        static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+        static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+        static V min(V a, V b) { return _mm_min_ps(a, b); }
+        static V max(V a, V b) { return _mm_max_ps(a, b); }
+        static unsigned int lessMask(V a, V b) { return static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(a, b))); }
+    };
+}
+
+#include "GeometryKernelsSimd.h"
+
+const GeometryKernels *geometryKernelsSSE41()
+{
+    static const GeometryKernels table = makeKernels<SseOps>(SimdLevel::SSE41);
+    return &table;
+}
+#else
+const GeometryKernels *geometryKernelsSSE41()
+{
+    return nullptr;
+}
+#endif
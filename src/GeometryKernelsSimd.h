@@ -0,0 +1,217 @@
+// GeometryKernelsSimd.h
+// Kernel bodies shared by the SSE4.1 / AVX2 / AVX-512 translation units.
+// Each unit includes this after defining its lane type Ops (vector width W,
+// load/store, arithmetic, min/max and a less-than bitmask); the templates
+// then compile with that unit's instruction set flags. Tails go to the
+// scalar reference.
+// Everything here must stay in the anonymous namespace: an inline or
+// template function with external linkage (std::min, std::max_element, ...)
+// becomes a weak symbol, and the linker may keep this unit's AVX copy for
+// callers that run on CPUs without AVX.
+#ifndef GEOMETRYKERNELSSIMD_H
+#define GEOMETRYKERNELSSIMD_H
+
+#include "GeometryKernelsInternal.h"
+
+namespace
+{
+    // std::min / std::max gibi: eşitlikte ilk argüman
+    inline float minFloat(float a, float b)
+    {
+        return b < a ? b : a;
+    }
+
+    inline float maxFloat(float a, float b)
+    {
+        return a < b ? b : a;
+    }
+
+    template <typename Ops>
+    float reduceMin(typename Ops::V v)
+    {
+        alignas(64) float lanes[Ops::W];
+        Ops::store(lanes, v);
+        float best = lanes[0];
+        for (int lane = 1; lane < Ops::W; ++lane)
+            best = minFloat(best, lanes[lane]);
+        return best;
+    }
+
+    template <typename Ops>
+    float reduceMax(typename Ops::V v)
+    {
+        alignas(64) float lanes[Ops::W];
+        Ops::store(lanes, v);
+        float best = lanes[0];
+        for (int lane = 1; lane < Ops::W; ++lane)
+            best = maxFloat(best, lanes[lane]);
+        return best;
+    }
+
+    template <typename Ops>
+    void mergeMinMax(typename Ops::V mn[3], typename Ops::V mx[3], float outMin[3], float outMax[3])
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            outMin[k] = minFloat(outMin[k], reduceMin<Ops>(mn[k]));
+            outMax[k] = maxFloat(outMax[k], reduceMax<Ops>(mx[k]));
+        }
+    }
+
+    template <typename Ops>
+    void minMaxSimd(const float *x, const float *y, const float *z, std::size_t count,
+                    float outMin[3], float outMax[3])
+    {
+        using V = typename Ops::V;
+        std::size_t i = 0;
+        if (count >= Ops::W)
+        {
+            V mn[3] = {Ops::set1(outMin[0]), Ops::set1(outMin[1]), Ops::set1(outMin[2])};
+            V mx[3] = {Ops::set1(outMax[0]), Ops::set1(outMax[1]), Ops::set1(outMax[2])};
+            for (; i + Ops::W <= count; i += Ops::W)
+            {
+                const V vx = Ops::load(x + i), vy = Ops::load(y + i), vz = Ops::load(z + i);
+                mn[0] = Ops::min(mn[0], vx);
+                mn[1] = Ops::min(mn[1], vy);
+                mn[2] = Ops::min(mn[2], vz);
+                mx[0] = Ops::max(mx[0], vx);
+                mx[1] = Ops::max(mx[1], vy);
+                mx[2] = Ops::max(mx[2], vz);
+            }
+            mergeMinMax<Ops>(mn, mx, outMin, outMax);
+        }
+        geometryKernelsScalar().minMax(x + i, y + i, z + i, count - i, outMin, outMax);
+    }
+
+    // Satır k: m[k] * x + m[4 + k] * y + m[8 + k] * z + m[12 + k]
+    template <typename Ops>
+    struct AffineRows
+    {
+        typename Ops::V c[12];
+
+        explicit AffineRows(const float m[16])
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                c[k * 4 + 0] = Ops::set1(m[k]);
+                c[k * 4 + 1] = Ops::set1(m[4 + k]);
+                c[k * 4 + 2] = Ops::set1(m[8 + k]);
+                c[k * 4 + 3] = Ops::set1(m[12 + k]);
+            }
+        }
+
+        typename Ops::V row(int k, typename Ops::V x, typename Ops::V y, typename Ops::V z) const
+        {
+            const typename Ops::V *r = c + k * 4;
+            return Ops::add(Ops::add(Ops::add(Ops::mul(r[0], x), Ops::mul(r[1], y)), Ops::mul(r[2], z)), r[3]);
+        }
+    };
+
+    template <typename Ops>
+    void transformPointsSimd(const float m[16], const float *x, const float *y, const float *z,
+                             std::size_t count, float *outX, float *outY, float *outZ)
+    {
+        using V = typename Ops::V;
+        const AffineRows<Ops> rows(m);
+        std::size_t i = 0;
+        for (; i + Ops::W <= count; i += Ops::W)
+        {
+            const V vx = Ops::load(x + i), vy = Ops::load(y + i), vz = Ops::load(z + i);
+            Ops::store(outX + i, rows.row(0, vx, vy, vz));
+            Ops::store(outY + i, rows.row(1, vx, vy, vz));
+            Ops::store(outZ + i, rows.row(2, vx, vy, vz));
+        }
+        geometryKernelsScalar().transformPoints(m, x + i, y + i, z + i, count - i, outX + i, outY + i, outZ + i);
+    }
+
+    template <typename Ops>
+    void transformMinMaxSimd(const float m[16], const float *x, const float *y, const float *z,
+                             std::size_t count, float outMin[3], float outMax[3])
+    {
+        using V = typename Ops::V;
+        std::size_t i = 0;
+        if (count >= Ops::W)
+        {
+            const AffineRows<Ops> rows(m);
+            V mn[3] = {Ops::set1(outMin[0]), Ops::set1(outMin[1]), Ops::set1(outMin[2])};
+            V mx[3] = {Ops::set1(outMax[0]), Ops::set1(outMax[1]), Ops::set1(outMax[2])};
+            for (; i + Ops::W <= count; i += Ops::W)
+            {
+                const V vx = Ops::load(x + i), vy = Ops::load(y + i), vz = Ops::load(z + i);
+                for (int k = 0; k < 3; ++k)
+                {
+                    const V w = rows.row(k, vx, vy, vz);
+                    mn[k] = Ops::min(mn[k], w);
+                    mx[k] = Ops::max(mx[k], w);
+                }
+            }
+            mergeMinMax<Ops>(mn, mx, outMin, outMax);
+        }
+        geometryKernelsScalar().transformMinMax(m, x + i, y + i, z + i, count - i, outMin, outMax);
+    }
+
+    template <typename Ops>
+    float maxDistanceSqSimd(const float *x, const float *y, const float *z, std::size_t count,
+                            const float center[3])
+    {
+        using V = typename Ops::V;
+        std::size_t i = 0;
+        float best = 0.0f;
+        if (count >= Ops::W)
+        {
+            const V cx = Ops::set1(center[0]), cy = Ops::set1(center[1]), cz = Ops::set1(center[2]);
+            V acc = Ops::set1(0.0f);
+            for (; i + Ops::W <= count; i += Ops::W)
+            {
+                const V dx = Ops::sub(Ops::load(x + i), cx);
+                const V dy = Ops::sub(Ops::load(y + i), cy);
+                const V dz = Ops::sub(Ops::load(z + i), cz);
+                acc = Ops::max(acc, Ops::add(Ops::add(Ops::mul(dx, dx), Ops::mul(dy, dy)), Ops::mul(dz, dz)));
+            }
+            best = reduceMax<Ops>(acc);
+        }
+        return maxFloat(best, geometryKernelsScalar().maxDistanceSq(x + i, y + i, z + i, count - i, center));
+    }
+
+    template <typename Ops>
+    void testSpheresSimd(const float planes[24], const float *x, const float *y, const float *z,
+                         const float *radius, std::size_t count, unsigned char *visible)
+    {
+        using V = typename Ops::V;
+        V p[24];
+        for (int k = 0; k < 24; ++k)
+            p[k] = Ops::set1(planes[k]);
+
+        std::size_t i = 0;
+        for (; i + Ops::W <= count; i += Ops::W)
+        {
+            const V vx = Ops::load(x + i), vy = Ops::load(y + i), vz = Ops::load(z + i);
+            const V negR = Ops::sub(Ops::set1(0.0f), Ops::load(radius + i));
+            unsigned int outside = 0;
+            for (int k = 0; k < 6; ++k)
+            {
+                const V *plane = p + k * 4;
+                const V d = Ops::add(Ops::add(Ops::add(Ops::mul(plane[0], vx), Ops::mul(plane[1], vy)),
+                                              Ops::mul(plane[2], vz)),
+                                     plane[3]);
+                outside |= Ops::lessMask(d, negR);
+            }
+            for (int lane = 0; lane < Ops::W; ++lane)
+                visible[i + lane] = static_cast<unsigned char>(((outside >> lane) & 1u) ^ 1u);
+        }
+        geometryKernelsScalar().testSpheres(planes, x + i, y + i, z + i, radius + i, count - i, visible + i);
+    }
+
+    template <typename Ops>
+    GeometryKernels makeKernels(SimdLevel level)
+    {
+        return GeometryKernels{level,
+                               minMaxSimd<Ops>,
+                               transformPointsSimd<Ops>,
+                               transformMinMaxSimd<Ops>,
+                               maxDistanceSqSimd<Ops>,
+                               testSpheresSimd<Ops>};
+    }
+}
+
+#endif // GEOMETRYKERNELSSIMD_H
@@ -0,0 +1,201 @@
+// GpuProfiler.cpp
+#include "GpuProfiler.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+
+GpuProfiler &GpuProfiler::get()
+{
+    static GpuProfiler instance;
+    return instance;
+}
+
+void GpuProfiler::init()
+{
+    initialized = true;
+    // GL_TIMESTAMP 3.3 çekirdeğinde; sürücü sayaç bitini 0 bildirirse yine yok say
+    supported = GLAD_GL_VERSION_3_3;
+#if defined(GL_ARB_timer_query)
+    supported = supported || GLAD_GL_ARB_timer_query;
+#endif
+    if (supported)
+    {
+        GLint bits = 0;
+        glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &bits);
+        supported = bits > 0;
+    }
+    if (!supported)
+        return;
+    for (Frame &frame : frames)
+        glGenQueries(MAX_SCOPES * 2, frame.queries);
+}
+
+void GpuProfiler::shutdown()
+{
+    if (initialized && supported)
+    {
+        for (Frame &frame : frames)
+        {
+            glDeleteQueries(MAX_SCOPES * 2, frame.queries);
+            frame = Frame();
+        }
+    }
+    initialized = supported = inFrame = recording = false;
+}
+
+void GpuProfiler::calibrate()
+{
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    clockOffset = static_cast<std::int64_t>(Profiler::now()) - gpuNow;
+}
+
+void GpuProfiler::beginFrame()
+{
+    if (!initialized)
+        init();
+    inFrame = true;
+    recording = false;
+    depth = 0;
+    if (!supported)
+        return;
+
+    // Yakalama başlarken GPU saati CPU saatine eşlenir
+    const bool capturing = Profiler::get().capturing();
+    if (capturing && !wasCapturing)
+    {
+        if (!track)
+            track = &Profiler::get().createTrack("GPU");
+        calibrate();
+    }
+    wasCapturing = capturing;
+
+    // LATENCY frame önceki sonuçlar: hazır değilse bu frame ölçülmez (asla bekleme)
+    Frame &frame = frames[current];
+    if (frame.pending)
+    {
+        GLint available = 0;
+        glGetQueryObjectiv(frame.queries[frame.queryCount - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return;
+        collect(frame);
+    }
+    frame.scopeCount = 0;
+    frame.queryCount = 0;
+    recording = true;
+}
+
+void GpuProfiler::endFrame()
+{
+    if (!inFrame)
+        return;
+    inFrame = false;
+    Frame &frame = frames[current];
+    if (recording && frame.queryCount > 0)
+        frame.pending = true;
+    recording = false;
+    current = (current + 1) % LATENCY;
+}
+
+void GpuProfiler::beginPass(const char *name)
+{
+    if (!inFrame)
+        return;
+    int index = -1;
+    Frame &frame = frames[current];
+    if (recording && depth < MAX_DEPTH && frame.scopeCount < MAX_SCOPES)
+    {
+        index = frame.scopeCount++;
+        Scope &scope = frame.scopes[index];
+        scope.name = name;
+        scope.beginQuery = frame.queryCount++;
+        scope.endQuery = -1;
+        glQueryCounter(frame.queries[scope.beginQuery], GL_TIMESTAMP);
+    }
+    if (depth < MAX_DEPTH)
+        stack[depth] = index;
+    ++depth;
+}
+
+void GpuProfiler::endPass()
+{
+    if (!inFrame || depth == 0)
+        return;
+    --depth;
+    if (depth >= MAX_DEPTH || stack[depth] < 0)
+        return;
+    Frame &frame = frames[current];
+    Scope &scope = frame.scopes[stack[depth]];
+    scope.endQuery = frame.queryCount++;
+    glQueryCounter(frame.queries[scope.endQuery], GL_TIMESTAMP);
+}
+
+void GpuProfiler::collect(Frame &frame)
+{
+    frame.pending = false;
+    const bool toTrace = track && Profiler::get().capturing();
+
+    // Aynı isim bir frame'de birden çok kez geçebilir: toplanır
+    float totals[MAX_GPU_PASSES] = {0};
+    bool seen[MAX_GPU_PASSES] = {false};
+    for (int i = 0; i < frame.scopeCount; ++i)
+    {
+        const Scope &scope = frame.scopes[i];
+        if (scope.endQuery < 0)
+            continue; // frame sonunda açık kalmış
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(frame.queries[scope.beginQuery], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(frame.queries[scope.endQuery], GL_QUERY_RESULT, &end);
+        const std::uint64_t duration = end > begin ? end - begin : 0;
+
+        if (toTrace)
+            track->push({scope.name, static_cast<std::uint64_t>(static_cast<std::int64_t>(begin) + clockOffset),
+                         duration, 0.0, ProfileEvent::Type::Scope});
+
+        int pass = 0;
+        while (pass < passCount && passes[pass].name != scope.name && std::strcmp(passes[pass].name, scope.name) != 0)
+            ++pass;
+        if (pass == passCount)
+        {
+            if (passCount == MAX_GPU_PASSES)
+                continue;
+            passes[passCount++].name = scope.name;
+        }
+        totals[pass] += static_cast<float>(duration) * 1e-6f;
+        seen[pass] = true;
+    }
+    for (int pass = 0; pass < passCount; ++pass)
+        if (seen[pass])
+            addSample(pass, totals[pass]);
+}
+
+void GpuProfiler::addSample(int pass, float ms)
+{
+    PassHistory &h = history[pass];
+    h.samples[h.next] = ms;
+    h.next = (h.next + 1) % HISTORY;
+    h.count = std::min(h.count + 1, HISTORY);
+
+    float sorted[HISTORY];
+    std::copy(h.samples, h.samples + h.count, sorted);
+    std::sort(sorted, sorted + h.count);
+    float sum = 0.0f;
+    for (int i = 0; i < h.count; ++i)
+        sum += sorted[i];
+    auto percentile = [&](float p) { return sorted[static_cast<int>(p * static_cast<float>(h.count - 1) + 0.5f)]; };
+
+    GpuPassStats &s = passes[pass];
+    s.lastMs = ms;
+    s.avgMs = sum / static_cast<float>(h.count);
+    s.p50Ms = percentile(0.50f);
+    s.p95Ms = percentile(0.95f);
+    s.p99Ms = percentile(0.99f);
+    s.maxMs = sorted[h.count - 1];
+}
+
+int GpuProfiler::snapshot(GpuPassStats *dst, int max) const
+{
+    int count = std::min(passCount, max);
+    std::copy(passes, passes + count, dst);
+    return count;
+}
@@ -0,0 +1,100 @@
+// GpuProfiler.h
+#ifndef GPUPROFILER_H
+#define GPUPROFILER_H
+
+#include <cstdint>
+#include "Profiler.h"
+#include "RenderSettings.h"
+
+// GL_TIMESTAMP pairs around render passes. Query objects come from a fixed
+// pool, one set per frame in flight; a frame's results are read back LATENCY
+// frames later and only if they are already available, so the CPU never
+// waits on the GPU (a frame whose slot is still busy is not measured).
+// Results feed the per-pass stats and, while a CPU capture runs, a "GPU"
+// track in the Profiler trace. Without timer queries every call is a no-op.
+// GL thread only.
+//
+//   GpuProfiler::get().beginFrame();
+//   { GPU_PROFILE_SCOPE("Scene"); ... }
+//   GpuProfiler::get().endFrame();
+class GpuProfiler
+{
+public:
+    static GpuProfiler &get();
+
+    static constexpr int LATENCY = 4;     // frames between issue and readback
+    static constexpr int MAX_SCOPES = 32; // per frame, nested scopes included
+    static constexpr int MAX_DEPTH = 8;
+    static constexpr int HISTORY = 128;   // samples per pass for avg/percentiles
+
+    // Query objects are created on the first beginFrame (needs a current context)
+    void beginFrame();
+    void endFrame();
+    void beginPass(const char *name); // name: string literal
+    void endPass();
+    void shutdown(); // deletes the queries; context must be current
+
+    bool available() const { return supported; }
+    // Copies up to max pass stats, in first-seen order; returns the count
+    int snapshot(GpuPassStats *dst, int max) const;
+
+private:
+    GpuProfiler() = default;
+
+    struct Scope
+    {
+        const char *name;
+        int beginQuery, endQuery;
+    };
+    struct Frame
+    {
+        unsigned int queries[MAX_SCOPES * 2] = {0};
+        Scope scopes[MAX_SCOPES];
+        int scopeCount = 0;
+        int queryCount = 0;
+        bool pending = false;
+    };
+    struct PassHistory
+    {
+        float samples[HISTORY] = {0};
+        int count = 0, next = 0;
+    };
+
+    bool initialized = false;
+    bool supported = false;
+    bool inFrame = false;
+    bool recording = false; // this frame's slot was free
+    Frame frames[LATENCY];
+    int current = 0;
+    int stack[MAX_DEPTH];
+    int depth = 0;
+
+    GpuPassStats passes[MAX_GPU_PASSES];
+    PassHistory history[MAX_GPU_PASSES];
+    int passCount = 0;
+
+    // GPU -> Profiler::now() clock offset, taken when a capture starts
+    bool wasCapturing = false;
+    std::int64_t clockOffset = 0;
+    Profiler::ThreadBuffer *track = nullptr; // created on the first capture
+
+    void init();
+    void collect(Frame &frame);
+    void addSample(int pass, float ms);
+    void calibrate();
+};
+
+class GpuProfileScope
+{
+public:
+    explicit GpuProfileScope(const char *name) { GpuProfiler::get().beginPass(name); }
+    ~GpuProfileScope() { GpuProfiler::get().endPass(); }
+    GpuProfileScope(const GpuProfileScope &) = delete;
+    GpuProfileScope &operator=(const GpuProfileScope &) = delete;
+};
+
+#define GPU_PROFILE_CONCAT_INNER(a, b) a##b
+#define GPU_PROFILE_CONCAT(a, b) GPU_PROFILE_CONCAT_INNER(a, b)
+#define GPU_PROFILE_SCOPE(name) GpuProfileScope GPU_PROFILE_CONCAT(gpuProfileScope, __COUNTER__)(name)
+
+#endif // GPUPROFILER_H
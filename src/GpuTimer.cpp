@@ -0,0 +1,44 @@
+// GpuTimer.cpp
+#include "GpuTimer.h"
+#include <glad/glad.h>
+
+GpuTimer::GpuTimer()
+{
+    glGenQueries(LATENCY, queries);
+}
+
+GpuTimer::~GpuTimer()
+{
+    glDeleteQueries(LATENCY, queries);
+}
+
+void GpuTimer::begin()
+{
+    // Bu slot hâlâ sonuç bekliyorsa ya oku ya da bu frame'i atla (asla bekleme)
+    if (pending[current])
+    {
+        GLint available = 0;
+        glGetQueryObjectiv(queries[current], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return;
+
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(queries[current], GL_QUERY_RESULT, &ns);
+        pending[current] = false;
+        lastMs = static_cast<float>(ns) * 1e-6f;
+        smoothedMs = smoothedMs == 0.0f ? lastMs : smoothedMs * 0.9f + lastMs * 0.1f;
+    }
+
+    glBeginQuery(GL_TIME_ELAPSED, queries[current]);
+    active = true;
+}
+
+void GpuTimer::end()
+{
+    if (!active)
+        return;
+    glEndQuery(GL_TIME_ELAPSED);
+    pending[current] = true;
+    active = false;
+    current = (current + 1) % LATENCY;
+}
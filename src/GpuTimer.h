@@ -0,0 +1,34 @@
+// GpuTimer.h
+#ifndef GPUTIMER_H
+#define GPUTIMER_H
+
+// GL_TIME_ELAPSED around a block of GL commands. Results are read back a few
+// frames later, so measuring never stalls the pipeline.
+class GpuTimer
+{
+public:
+    GpuTimer();
+    ~GpuTimer();
+    GpuTimer(const GpuTimer &) = delete;
+    GpuTimer &operator=(const GpuTimer &) = delete;
+
+    void begin();
+    void end();
+
+    // Smoothed duration in milliseconds (0 until the first result arrives)
+    float milliseconds() const { return smoothedMs; }
+    // Most recent raw result
+    float lastMilliseconds() const { return lastMs; }
+
+private:
+    static constexpr int LATENCY = 4;
+    unsigned int queries[LATENCY] = {0};
+    bool pending[LATENCY] = {false};
+    int current = 0;
+    bool active = false;
+
+    float lastMs = 0.0f;
+    float smoothedMs = 0.0f;
+};
+
+#endif // GPUTIMER_H
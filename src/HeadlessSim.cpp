@@ -0,0 +1,152 @@
+// HeadlessSim.cpp
+#include "HeadlessSim.h"
+#include "FixedStep.h"
+#include "Robot.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace
+{
+    struct SimResult
+    {
+        std::uint64_t hash = 1469598103934665603ull; // FNV-1a
+        unsigned long long steps = 0;
+        int arrivals = 0;
+        glm::vec3 position{0.0f};
+        double wallSeconds = 0.0;
+    };
+
+    void hashState(SimResult &r, const Robot &robot)
+    {
+        float state[6] = {robot.position.x, robot.position.y, robot.position.z,
+                          robot.direction.x, robot.direction.y, robot.direction.z};
+        unsigned char bytes[sizeof(state)];
+        std::memcpy(bytes, state, sizeof(state));
+        for (unsigned char b : bytes)
+        {
+            r.hash ^= b;
+            r.hash *= 1099511628211ull;
+        }
+    }
+
+    void countArrival(SimResult &r, const Robot &robot, int &lastTarget)
+    {
+        if (robot.targetIndex() != lastTarget)
+        {
+            ++r.arrivals;
+            lastTarget = robot.targetIndex();
+        }
+    }
+
+    // Referans: doğrudan sabit adım; her adımın konumu saklanır
+    SimResult simulateDirect(const std::vector<glm::vec3> &tourStops, unsigned long long totalSteps, int rateHz,
+                             std::vector<glm::vec3> &positions)
+    {
+        Robot robot;
+        robot.setPath(tourStops);
+        positions.assign(1, robot.position);
+        positions.reserve(static_cast<std::size_t>(totalSteps) + 1);
+
+        SimResult r;
+        auto start = std::chrono::steady_clock::now();
+        int lastTarget = robot.targetIndex();
+        for (; r.steps < totalSteps; ++r.steps)
+        {
+            robot.update(static_cast<float>(1.0 / rateHz));
+            hashState(r, robot);
+            countArrival(r, robot, lastTarget);
+            positions.push_back(robot.position);
+        }
+        r.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        r.position = robot.position;
+        return r;
+    }
+
+    struct FramedResult
+    {
+        SimResult sim;
+        unsigned long long frames = 0;
+        unsigned long long poseErrors = 0; // ara değer doğrudan koşunun yolunda değil
+        unsigned long long expectedSteps = 0; // toplam frame süresinden
+        unsigned long long clockSteps = 0;
+        double droppedSeconds = 0.0;
+    };
+
+    // Ana döngünün yolu: float deltaTime, her frame setRate + FixedStep::tick,
+    // sonra robot.pose(alpha). Frame süreleri 0.2..3 adım arası rastgele.
+    FramedResult simulateFramed(const std::vector<glm::vec3> &tourStops, unsigned long long totalSteps, int rateHz,
+                                const std::vector<glm::vec3> &positions)
+    {
+        Robot robot;
+        robot.setPath(tourStops);
+        FixedStep clock(rateHz);
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> frameTime(0.2f / rateHz, 3.0f / rateHz);
+
+        FramedResult f;
+        SimResult &r = f.sim;
+        int lastTarget = robot.targetIndex();
+        double elapsed = 0.0;
+        while (clock.totalSteps() < totalSteps)
+        {
+            float deltaTime = frameTime(rng);
+            elapsed += deltaTime;
+            ++f.frames;
+            clock.setRate(rateHz);
+            clock.tick(deltaTime, [&](float dt) {
+                if (r.steps >= totalSteps)
+                    return; // son frame fazladan adım verebilir
+                robot.update(dt);
+                hashState(r, robot);
+                countArrival(r, robot, lastTarget);
+                ++r.steps;
+            });
+            if (clock.totalSteps() > totalSteps)
+                break;
+
+            std::size_t k = static_cast<std::size_t>(clock.totalSteps());
+            float alpha = clock.alpha();
+            glm::vec3 expected = k == 0 ? positions[0] : glm::mix(positions[k - 1], positions[k], alpha);
+            if (alpha < 0.0f || alpha >= 1.0f || glm::length(robot.pose(alpha).position - expected) > 1e-4f)
+                ++f.poseErrors;
+        }
+        r.position = robot.position;
+        f.expectedSteps = static_cast<unsigned long long>(elapsed * rateHz);
+        f.clockSteps = clock.totalSteps();
+        f.droppedSeconds = clock.droppedSeconds();
+        return f;
+    }
+}
+
+int runHeadlessSim(double seconds, int rateHz, const std::vector<glm::vec3> &tourStops)
+{
+    unsigned long long steps = static_cast<unsigned long long>(seconds * rateHz + 0.5);
+    std::vector<glm::vec3> positions;
+    SimResult direct = simulateDirect(tourStops, steps, rateHz, positions);
+    FramedResult framed = simulateFramed(tourStops, steps, rateHz, positions);
+
+    // Kayan nokta birikimi en fazla bir adım oynatabilir; düşürme olmamalı
+    unsigned long long stepDiff = framed.clockSteps > framed.expectedSteps ? framed.clockSteps - framed.expectedSteps
+                                                                           : framed.expectedSteps - framed.clockSteps;
+    bool hashOk = direct.hash == framed.sim.hash && framed.sim.steps == direct.steps;
+    bool timingOk = stepDiff <= 1 && framed.droppedSeconds == 0.0;
+    bool poseOk = framed.poseErrors == 0;
+
+    std::printf("Headless sim: %.1f s at %d Hz = %llu steps\n", seconds, rateHz, direct.steps);
+    std::printf("  wall time %.3f ms (%.0fx real time)\n", direct.wallSeconds * 1000.0,
+                direct.wallSeconds > 0.0 ? seconds / direct.wallSeconds : 0.0);
+    std::printf("  waypoints reached %d, final position (%.4f, %.4f, %.4f)\n", direct.arrivals,
+                direct.position.x, direct.position.y, direct.position.z);
+    std::printf("  state hash %016llx, main loop path with random frame times %016llx: %s\n",
+                static_cast<unsigned long long>(direct.hash), static_cast<unsigned long long>(framed.sim.hash),
+                hashOk ? "identical" : "MISMATCH");
+    std::printf("  %llu frames: %llu steps for %llu steps of frame time, %.3f ms dropped: %s\n", framed.frames,
+                framed.clockSteps, framed.expectedSteps, framed.droppedSeconds * 1000.0,
+                timingOk ? "ok" : "MISMATCH");
+    std::printf("  interpolated poses off the fixed-step path: %llu%s\n", framed.poseErrors,
+                poseOk ? "" : " MISMATCH");
+    return hashOk && timingOk && poseOk ? 0 : 1;
+}
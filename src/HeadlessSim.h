@@ -0,0 +1,16 @@
+// HeadlessSim.h
+#ifndef HEADLESSSIM_H
+#define HEADLESSSIM_H
+
+#include <vector>
+#include <glm/glm.hpp>
+
+// --headless-sim <seconds> [--sim-rate <hz>]: runs the robot tour without a
+// window as fast as possible. The same sim time is then replayed through the
+// main loop's path (FixedStep::tick, float frame times, pose(alpha)) with
+// random frame times: every step must match, no time may be lost and each
+// interpolated pose must lie on the fixed-step path. Prints timing and a
+// state hash, returns non-zero on mismatch.
+int runHeadlessSim(double seconds, int rateHz, const std::vector<glm::vec3> &tourStops);
+
+#endif // HEADLESSSIM_H
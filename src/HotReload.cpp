@@ -0,0 +1,336 @@
+// HotReload.cpp
+#include "HotReload.h"
+#include "Material.h"
+#include "Profiler.h"
+#include "Renderer.h"
+#include "Scene.h"
+#include <stb_image.h>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // Bir kayıt genelde birkaç olay üretir (geçici dosya, rename, touch)
+    constexpr std::chrono::milliseconds DEBOUNCE{100};
+
+    std::string normalPath(const std::string &path)
+    {
+        return fs::path(path).lexically_normal().generic_string();
+    }
+
+    std::string lowerExtension(const std::string &path)
+    {
+        std::string extension = fs::path(path).extension().string();
+        for (char &c : extension)
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return extension;
+    }
+
+    bool isShader(const std::string &extension)
+    {
+        return extension == ".glsl" || extension == ".vert" || extension == ".frag";
+    }
+
+    // stb_image'ın okuyabildikleri
+    bool isImage(const std::string &extension)
+    {
+        for (const char *known : {".png", ".jpg", ".jpeg", ".tga", ".bmp", ".psd", ".gif", ".hdr", ".pic", ".pnm"})
+            if (extension == known)
+                return true;
+        return false;
+    }
+
+    double msBetween(FileWatcher::Clock::time_point from, FileWatcher::Clock::time_point to)
+    {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+}
+
+HotReload::Task::~Task()
+{
+    if (pixels)
+        stbi_image_free(pixels);
+    for (DecodedTexture &texture : textures)
+        if (texture.pixels)
+            stbi_image_free(texture.pixels);
+}
+
+HotReload::~HotReload()
+{
+    stop();
+}
+
+bool HotReload::start(const SceneDesc &desc, std::function<void()> wake, std::string &error)
+{
+    stop();
+    modelDescs = desc.models;
+    std::vector<std::string> directories{"shaders"};
+    for (const ModelDesc &model : desc.models)
+    {
+        const fs::path directory = fs::path(model.path).parent_path();
+        if (!directory.empty())
+            directories.push_back(directory.string());
+    }
+    return watcher.start(directories, DEBOUNCE, std::move(wake), error);
+}
+
+void HotReload::stop()
+{
+    watcher.stop();
+    if (jobs.load() > 0)
+        JobSystem::get().wait(jobs);
+    std::lock_guard<std::mutex> lock(mutex);
+    done.clear();
+    retry.clear();
+    applying.clear();
+    inFlight.clear();
+    pending = 0;
+    ready = 0;
+}
+
+void HotReload::dispatch()
+{
+    Clock::time_point changedAt;
+    if (!watcher.take(changed, changedAt))
+        return;
+
+    std::vector<std::string> models; // bu partide yeniden yüklenecekler (.obj ve .mtl birlikte kaydedilebilir)
+    for (const std::string &path : changed)
+    {
+        const std::string extension = lowerExtension(path);
+        if (isShader(extension))
+        {
+            queue(Task::SHADER, path, changedAt);
+            continue;
+        }
+        if (isImage(extension))
+        {
+            queue(Task::TEXTURE, path, changedAt);
+            continue;
+        }
+        // Model dosyasının kendisi ya da yanındaki bir .mtl
+        const fs::path directory = fs::path(path).parent_path();
+        for (const ModelDesc &desc : modelDescs)
+        {
+            const std::string &model = desc.path;
+            const bool affected = extension == ".mtl" ? fs::path(normalPath(model)).parent_path() == directory
+                                                      : normalPath(model) == path;
+            if (affected && std::find(models.begin(), models.end(), model) == models.end())
+                models.push_back(model);
+        }
+    }
+    for (const std::string &model : models)
+        queue(Task::MODEL, model, changedAt);
+}
+
+void HotReload::queue(Task::Kind kind, const std::string &path, Clock::time_point changedAt)
+{
+    std::unique_ptr<Task> task(new Task());
+    task->kind = kind;
+    task->path = path;
+    task->changed = changedAt;
+    pending.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (kind == Task::SHADER)
+        {
+            // CPU işi yok: derleme GL thread'inde
+            done.push_back(std::move(task));
+            ready.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (std::find(inFlight.begin(), inFlight.end(), path) != inFlight.end())
+        {
+            // Süren iş bitince bir kez daha; ilk kaydın zamanı korunur
+            auto queued = std::find_if(retry.begin(), retry.end(),
+                                       [&path](const std::unique_ptr<Task> &t) { return t->path == path; });
+            if (queued == retry.end())
+                retry.push_back(std::move(task));
+            else
+                pending.fetch_sub(1, std::memory_order_relaxed);
+            return;
+        }
+        inFlight.push_back(path);
+    }
+    launch(std::move(task));
+}
+
+void HotReload::launch(std::unique_ptr<Task> task)
+{
+    // Son işçiye sabitlenir: frame işini bekleyen ana thread uzun bir import'u çalmasın
+    JobSystem &jobSystem = JobSystem::get();
+    const int worker = jobSystem.threadCount() > 1 ? static_cast<int>(jobSystem.threadCount()) - 1 : -1;
+    Task *raw = task.release(); // iş bitince done listesine geçer
+    jobSystem.run([this, raw] { run(*raw); }, &jobs, worker);
+}
+
+void HotReload::run(Task &task)
+{
+    PROFILE_SCOPE("Hot reload import");
+    // Son işlem alt işleri de bu işçide kalır: ana thread frame'i beklerken çalmasın
+    JobSystem::InlineScope serial;
+    const Clock::time_point start = Clock::now();
+    if (task.kind == Task::MODEL)
+    {
+        try
+        {
+            auto desc = std::find_if(modelDescs.begin(), modelDescs.end(),
+                                     [&task](const ModelDesc &m) { return m.path == task.path; });
+            task.model = Model::import(task.path, desc != modelDescs.end() ? desc->import : ImportProfile(),
+                                       &task.stats);
+            // Sınırlar import'ta yeniden hesaplandı; eser yüksekliğine ölçek bunlara bölünür
+            if (!(task.model.bbMax.y > task.model.bbMin.y))
+                throw std::runtime_error("model has no height, cannot scale it to its exhibits");
+            decodeNewTextures(task);
+        }
+        catch (const std::exception &e)
+        {
+            task.error = e.what();
+        }
+    }
+    else
+    {
+        task.pixels = stbi_load(task.path.c_str(), &task.width, &task.height, &task.components, 0);
+        if (!task.pixels)
+            task.error = "cannot decode the image";
+    }
+    task.workMs = msBetween(start, Clock::now());
+
+    std::unique_ptr<Task> again;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const std::string path = task.path;
+        done.emplace_back(&task);
+        ready.fetch_add(1, std::memory_order_relaxed);
+        inFlight.erase(std::find(inFlight.begin(), inFlight.end(), path));
+        auto queued = std::find_if(retry.begin(), retry.end(),
+                                   [&path](const std::unique_ptr<Task> &t) { return t->path == path; });
+        if (queued != retry.end())
+        {
+            again = std::move(*queued);
+            retry.erase(queued);
+            inFlight.push_back(path);
+        }
+    }
+    if (again)
+        launch(std::move(again));
+}
+
+void HotReload::decodeNewTextures(Task &task)
+{
+    // Model::reload GL thread'inde loadTexture çağırır; önbellekte olmayan
+    // yollar burada çözülür ki orada stbi_load çalışmasın
+    std::vector<std::string> paths;
+    for (const ImportedMaterial &material : task.model.materials)
+        for (const std::string *path : {&material.diffuseTexture, &material.specularTexture})
+            if (!path->empty() && std::find(paths.begin(), paths.end(), *path) == paths.end())
+                paths.push_back(*path);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        paths.erase(std::remove_if(paths.begin(), paths.end(),
+                                   [this](const std::string &path) { return knownTextures.count(path) > 0; }),
+                    paths.end());
+    }
+    task.textures.reserve(paths.size());
+    for (const std::string &path : paths)
+    {
+        task.textures.emplace_back();
+        DecodedTexture &texture = task.textures.back();
+        texture.path = path;
+        texture.pixels = stbi_load(path.c_str(), &texture.width, &texture.height, &texture.components, 0);
+    }
+}
+
+void HotReload::update(Scene &scene, Renderer &renderer)
+{
+    if (ready.load(std::memory_order_relaxed) == 0)
+        return;
+    PROFILE_SCOPE("Hot reload");
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        applying.swap(done);
+        ready.fetch_sub(static_cast<int>(applying.size()), std::memory_order_relaxed);
+    }
+    for (const std::unique_ptr<Task> &task : applying)
+        apply(*task, scene, renderer);
+    pending.fetch_sub(static_cast<int>(applying.size()), std::memory_order_relaxed);
+    applying.clear();
+}
+
+void HotReload::apply(Task &task, Scene &scene, Renderer &renderer)
+{
+    const Clock::time_point start = Clock::now();
+    if (!task.error.empty())
+    {
+        std::cerr << "Hot reload: " << task.path << ": " << task.error << std::endl;
+        return;
+    }
+
+    switch (task.kind)
+    {
+    case Task::SHADER:
+    {
+        int failed = 0;
+        const int reloaded = renderer.reloadShaders(task.path, failed);
+        const Clock::time_point end = Clock::now();
+        if (failed)
+            std::cerr << "Hot reload: " << task.path << " does not compile, " << failed
+                      << " program(s) keep the previous version" << std::endl;
+        if (reloaded)
+            std::cout << "Hot reload: " << task.path << " in " << msBetween(task.changed, end) << " ms (compile "
+                      << msBetween(start, end) << " ms, " << reloaded << " program(s))" << std::endl;
+        break;
+    }
+    case Task::MODEL:
+    {
+        // Önce iş içinde çözülen dokular: buildMaterial'in loadTexture'ı önbellekten döner.
+        // Okunamayanlar da (0) önbelleğe girer, burada tekrar denenmez.
+        MaterialLibrary &library = MaterialLibrary::get();
+        for (const DecodedTexture &texture : task.textures)
+        {
+            if (!texture.pixels && library.texturePath(texture.path).empty())
+                std::cerr << "Failed to load texture at path: " << texture.path << "\n";
+            library.createTexture(texture.path, texture.pixels, texture.width, texture.height, texture.components);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const ImportedMaterial &material : task.model.materials)
+                for (const std::string *path : {&material.diffuseTexture, &material.specularTexture})
+                    if (!path->empty())
+                        knownTextures.insert(*path);
+        }
+
+        ModelReloadStats stats;
+        if (!scene.reloadModel(std::move(task.model), stats))
+            break; // hiçbir eser kullanmıyor
+        const Clock::time_point end = Clock::now();
+        std::cout << "Hot reload: " << task.path << " in " << msBetween(task.changed, end) << " ms (import "
+                  << task.workMs << " ms, " << task.textures.size() << " texture(s) decoded, "
+                  << task.stats.verticesOut << " vertices from " << task.stats.verticesIn
+                  << ", upload " << msBetween(start, end) << " ms; meshes " << stats.meshesKept
+                  << " kept, " << stats.meshesUpdated << " updated, " << stats.meshesCreated << " new, "
+                  << stats.meshesReleased << " released; materials " << stats.materialsKept << " kept, "
+                  << stats.materialsCreated << " new; " << stats.uploadedBytes / 1024 << " KB uploaded)"
+                  << std::endl;
+        break;
+    }
+    case Task::TEXTURE:
+    {
+        MaterialLibrary &library = MaterialLibrary::get();
+        const std::string key = library.texturePath(task.path);
+        if (key.empty() || !library.reloadTexture(key, task.pixels, task.width, task.height, task.components))
+            break; // sahnede kullanılmayan resim
+        const Clock::time_point end = Clock::now();
+        std::cout << "Hot reload: " << task.path << " in " << msBetween(task.changed, end) << " ms (decode "
+                  << task.workMs << " ms, upload " << msBetween(start, end) << " ms, " << task.width << "x"
+                  << task.height << ")" << std::endl;
+        break;
+    }
+    }
+}
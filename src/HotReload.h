@@ -0,0 +1,114 @@
+// HotReload.h
+#ifndef HOTRELOAD_H
+#define HOTRELOAD_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "FileWatcher.h"
+#include "JobSystem.h"
+#include "Model.h"
+#include "SceneDesc.h"
+
+class Renderer;
+class Scene;
+
+// Development aid (--hot-reload): saved edits to the scene's models, their
+// .mtl files and textures, and to the shaders show up in the running app.
+//
+//   watcher thread   FileWatcher batches saved files (debounced)
+//   main thread      dispatch(): re-import models / decode textures in jobs
+//                    (with the textures a re-imported model newly names)
+//   job threads      the CPU work, results queued
+//   GL thread        update(): at the start of a rendered frame, swaps the
+//                    results in and recompiles edited shaders
+//
+// A re-imported model brings new bounds: its exhibits are re-scaled and
+// re-grounded in the same swap and the main thread's culling picks the new
+// spheres up through Scene::pollModelBounds.
+// Only buffers whose content changed are re-uploaded (Model::reload,
+// MaterialLibrary::reloadTexture); a shader that does not compile keeps its
+// old program. Each reload logs its latency from the save to the swap.
+// When nothing changed, dispatch(), busy() and update() are one or two
+// relaxed atomic loads each.
+class HotReload
+{
+public:
+    HotReload() = default;
+    ~HotReload();
+    HotReload(const HotReload &) = delete;
+    HotReload &operator=(const HotReload &) = delete;
+
+    // Watches the directories of the scene's models and shaders/. wake runs on
+    // the watcher thread after a change, to end an idle wait of the main loop.
+    bool start(const SceneDesc &desc, std::function<void()> wake, std::string &error);
+    // Waits for jobs in flight; main thread, before JobSystem::shutdown
+    void stop();
+    bool isRunning() const { return watcher.isRunning(); }
+
+    // Main thread (job system thread 0), once per loop iteration
+    void dispatch();
+    // Main thread: a reload is on its way, so the frame must be rendered
+    bool busy() const { return pending.load(std::memory_order_relaxed) > 0 || watcher.hasChanges(); }
+    // GL thread, at a frame boundary
+    void update(Scene &scene, Renderer &renderer);
+
+private:
+    using Clock = FileWatcher::Clock;
+
+    struct DecodedTexture
+    {
+        std::string path;
+        unsigned char *pixels = nullptr; // stb_image; nullptr: okunamadı
+        int width = 0, height = 0, components = 0;
+    };
+
+    struct Task
+    {
+        enum Kind
+        {
+            MODEL,
+            TEXTURE,
+            SHADER
+        } kind;
+        std::string path;
+        Clock::time_point changed; // dosyanın kaydedildiği an (partinin ilki)
+        double workMs = 0.0;       // import / decode
+        std::string error;
+        ModelData model;
+        ImportStats stats;
+        // MODEL: materyallerin GL tarafında henüz olmayan dokuları
+        std::vector<DecodedTexture> textures;
+        // TEXTURE: stb_image pikselleri, update() sonunda serbest
+        unsigned char *pixels = nullptr;
+        int width = 0, height = 0, components = 0;
+
+        ~Task();
+    };
+
+    FileWatcher watcher;
+    std::vector<ModelDesc> modelDescs;   // yol + import profili
+    std::vector<std::string> changed;    // dispatch() tamponu
+    JobCounter jobs{0};
+    std::atomic<int> pending{0}; // başlatılmış, henüz uygulanmamış işler
+    std::atomic<int> ready{0};   // done listesindekiler
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Task>> done;  // uygulanmayı bekleyen
+    std::vector<std::string> inFlight;        // import/decode süren yollar
+    std::vector<std::unique_ptr<Task>> retry; // yolu meşgulken tekrar değişenler
+    std::vector<std::unique_ptr<Task>> applying; // update() tamponu
+    std::unordered_set<std::string> knownTextures; // MaterialLibrary'de olduğu bilinen doku yolları
+
+    void queue(Task::Kind kind, const std::string &path, Clock::time_point changedAt);
+    void launch(std::unique_ptr<Task> task);
+    void run(Task &task);
+    void decodeNewTextures(Task &task);
+    void apply(Task &task, Scene &scene, Renderer &renderer);
+};
+
+#endif // HOTRELOAD_H
@@ -0,0 +1,50 @@
+// IdleMonitor.cpp
+#include "IdleMonitor.h"
+#include <algorithm>
+
+bool IdleState::operator==(const IdleState &o) const
+{
+    return cameraPos == o.cameraPos && cameraTarget == o.cameraTarget && fov == o.fov &&
+           robotPos == o.robotPos && robotDir == o.robotDir && width == o.width && height == o.height;
+}
+
+bool IdleMonitor::update(const IdleState &state, unsigned int inputEvents, bool busy, double now)
+{
+    if (startTime < 0.0)
+        startTime = prevTime = now;
+
+    // Önceki iterasyonun süresi, o iterasyonun türüne yazılır
+    double elapsed = now - prevTime;
+    prevTime = now;
+    if (prevIdle)
+        idleSeconds += elapsed;
+    else if (elapsed > 0.0)
+        activeFrameSeconds = activeFrameSeconds == 0.0 ? elapsed : activeFrameSeconds * 0.95 + elapsed * 0.05;
+
+    bool changed = !hasLast || !(state == last) || inputEvents != lastInput || busy;
+    last = state;
+    hasLast = true;
+    lastInput = inputEvents;
+
+    if (!enabled || changed)
+        grace = graceFrames;
+    else if (grace > 0)
+        --grace;
+
+    prevIdle = enabled && grace == 0;
+    return !prevIdle;
+}
+
+float IdleMonitor::idleFraction() const
+{
+    double total = prevTime - startTime;
+    return total > 0.0 ? static_cast<float>(idleSeconds / total) : 0.0f;
+}
+
+unsigned long long IdleMonitor::savedFrames() const
+{
+    if (activeFrameSeconds <= 0.0)
+        return 0;
+    double saved = idleSeconds / activeFrameSeconds - static_cast<double>(presented);
+    return static_cast<unsigned long long>(std::max(0.0, saved));
+}
@@ -0,0 +1,61 @@
+// IdleMonitor.h
+#ifndef IDLEMONITOR_H
+#define IDLEMONITOR_H
+
+#include <glm/glm.hpp>
+
+// Everything that changes the rendered image, sampled once per loop iteration
+struct IdleState
+{
+    glm::vec3 cameraPos;
+    glm::vec3 cameraTarget;
+    float fov;
+    glm::vec3 robotPos;
+    glm::vec3 robotDir;
+    int width, height;
+
+    bool operator==(const IdleState &o) const;
+};
+
+// Decides per loop iteration whether the frame has to be rendered or the
+// cached previous frame can be shown again. After the last change a few
+// more frames are rendered so ImGui hover/animation states settle.
+class IdleMonitor
+{
+public:
+    bool enabled = true;
+    int graceFrames = 4;
+    double wakeInterval = 0.25; // bekleme zaman aşımı (s), önbellek yeniden gösterilir
+
+    // inputEvents: monotonically increasing counter bumped by the GLFW callbacks.
+    // busy: animation running or ImGui needs continuous frames.
+    // Returns true if this frame must be rendered.
+    bool update(const IdleState &state, unsigned int inputEvents, bool busy, double now);
+
+    // true on the last rendered frame before going idle: capture it then
+    bool lastActiveFrame() const { return enabled && grace == 1; }
+
+    // Fraction of wall time spent idle (since start)
+    float idleFraction() const;
+    // Frames that would have been rendered at the measured active frame rate
+    unsigned long long savedFrames() const;
+    unsigned long long presentedFrames() const { return presented; }
+    // Re-presents that actually reached the screen, counted by the render
+    // side (RenderThread::cachedPresents); an idle frame whose cache blit
+    // failed is not one
+    void setPresentedFrames(unsigned long long count) { presented = count; }
+
+private:
+    IdleState last{};
+    bool hasLast = false;
+    unsigned int lastInput = 0;
+    int grace = 0;
+
+    double startTime = -1.0, prevTime = 0.0;
+    bool prevIdle = false;
+    double idleSeconds = 0.0;
+    double activeFrameSeconds = 0.0; // EMA
+    unsigned long long presented = 0;
+};
+
+#endif // IDLEMONITOR_H
@@ -0,0 +1,41 @@
+// ImportArena.cpp
+#include "ImportArena.h"
+#include <algorithm>
+#include <cstdint>
+
+ImportArena::ImportArena(std::size_t firstBlock)
+    : nextBlock(std::max<std::size_t>(firstBlock, 4096))
+{
+}
+
+void *ImportArena::allocate(std::size_t size, std::size_t align)
+{
+    const auto alignUp = [align](std::uintptr_t p) { return (p + align - 1) & ~std::uintptr_t(align - 1); };
+    if (cursor)
+    {
+        unsigned char *start = reinterpret_cast<unsigned char *>(alignUp(reinterpret_cast<std::uintptr_t>(cursor)));
+        if (start <= limit && size <= static_cast<std::size_t>(limit - start))
+        {
+            cursor = start + size;
+            usedBytes += size;
+            return start;
+        }
+    }
+
+    // Yeni blok; dev istek kendi bloğunu alır, sıradaki boyutu büyütmez
+    const std::size_t needed = size + align;
+    const bool own = needed > nextBlock;
+    const std::size_t bytes = own ? needed : nextBlock;
+    blocks.emplace_back(new unsigned char[bytes]);
+    reservedBytes += bytes;
+    unsigned char *block = blocks.back().get();
+    unsigned char *start = reinterpret_cast<unsigned char *>(alignUp(reinterpret_cast<std::uintptr_t>(block)));
+    usedBytes += size;
+    if (own && cursor)
+        return start; // kalan yer eski blokta
+    cursor = start + size;
+    limit = block + bytes;
+    if (!own)
+        nextBlock *= 2;
+    return start;
+}
@@ -0,0 +1,43 @@
+// ImportArena.h
+#ifndef IMPORTARENA_H
+#define IMPORTARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Bump allocator for the transient data of one import: Assimp's meshes
+// converted to MeshData, and the scratch arrays of welding and normal
+// generation. Blocks are added as needed and all released together when the
+// arena is destroyed; nothing is freed or destroyed one by one, so only
+// trivially destructible data goes in. Unlike FrameArena it never runs out
+// and is not thread-safe: one arena per thread of work (Model::postProcess
+// gives each mesh its own). Memory is not zeroed.
+class ImportArena
+{
+public:
+    // firstBlock: size of the first block, allocated on first use; later
+    // blocks double, a request larger than that gets a block of its own
+    explicit ImportArena(std::size_t firstBlock = 64 * 1024);
+    ImportArena(const ImportArena &) = delete;
+    ImportArena &operator=(const ImportArena &) = delete;
+
+    void *allocate(std::size_t size, std::size_t align = alignof(std::max_align_t));
+    template <typename T>
+    T *allocateArray(std::size_t count)
+    {
+        return static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    std::size_t used() const { return usedBytes; }         // istenen baytlar
+    std::size_t reserved() const { return reservedBytes; } // blokların toplamı
+    std::size_t blockCount() const { return blocks.size(); }
+
+private:
+    std::vector<std::unique_ptr<unsigned char[]>> blocks;
+    unsigned char *cursor = nullptr, *limit = nullptr;
+    std::size_t nextBlock;
+    std::size_t usedBytes = 0, reservedBytes = 0;
+};
+
+#endif // IMPORTARENA_H
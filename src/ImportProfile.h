@@ -0,0 +1,43 @@
+// ImportProfile.h
+#ifndef IMPORTPROFILE_H
+#define IMPORTPROFILE_H
+
+// How Model::import turns a file into meshes. Set per model with an "import"
+// line in the scene file (SceneFile.h); the defaults suit the museum's OBJ
+// exhibits. Assimp is only asked to triangulate (and flip UVs): welding and
+// normal generation are our own parallel stages (MeshProcessing.h).
+enum class NormalMode : unsigned char
+{
+    Keep,      // dosyadakiler; yoksa sıfır
+    IfMissing, // normalsiz mesh'ler için Smooth
+    Smooth,    // her zaman yeniden, creaseAngle'dan keskin kenarlar ayrı
+    Flat       // üçgen başına
+};
+
+enum class TexCoordMode : unsigned char
+{
+    Auto, // materyalde doku yoksa sıfırlanır (kaynaklar daha çok birleşir)
+    Keep,
+    Drop
+};
+
+struct ImportProfile
+{
+    bool flipUVs = true;
+    // Vertices within weldTolerance x the mesh's largest extent (normals and
+    // UVs within fixed small steps) become one; 0 welds exact copies only
+    bool weld = true;
+    float weldTolerance = 1e-5f;
+    NormalMode normals = NormalMode::IfMissing;
+    float creaseAngle = 60.0f; // derece
+    TexCoordMode texCoords = TexCoordMode::Auto;
+
+    bool operator==(const ImportProfile &o) const
+    {
+        return flipUVs == o.flipUVs && weld == o.weld && weldTolerance == o.weldTolerance &&
+               normals == o.normals && creaseAngle == o.creaseAngle && texCoords == o.texCoords;
+    }
+    bool operator!=(const ImportProfile &o) const { return !(*this == o); }
+};
+
+#endif // IMPORTPROFILE_H
@@ -0,0 +1,330 @@
+// JobSystem.cpp
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <cstdio>
+
+namespace
+{
+    thread_local int threadIndex = -1;
+    thread_local int inlineDepth = 0; // iç içe InlineScope sayısı
+
+    // Boşta kalan işçi uyumadan önce bu kadar tur dener
+    constexpr int SPIN_ROUNDS = 64;
+}
+
+JobSystem &JobSystem::get()
+{
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::~JobSystem()
+{
+    shutdown();
+}
+
+int JobSystem::currentThread()
+{
+    return threadIndex;
+}
+
+JobSystem::InlineScope::InlineScope()
+{
+    ++inlineDepth;
+}
+
+JobSystem::InlineScope::~InlineScope()
+{
+    --inlineDepth;
+}
+
+bool JobSystem::inlineOnly()
+{
+    return inlineDepth > 0;
+}
+
+// ---------------------------------------------------------------------------
+// Chase-Lev deque (C11 bellek modeli sürümü, Lê et al. 2013)
+// ---------------------------------------------------------------------------
+bool JobSystem::WorkDeque::push(Job *job)
+{
+    std::int64_t b = bottom.load(std::memory_order_relaxed);
+    std::int64_t t = top.load(std::memory_order_acquire);
+    if (b - t >= CAPACITY)
+        return false;
+    items[b & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+}
+
+JobSystem::Job *JobSystem::WorkDeque::pop()
+{
+    std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = top.load(std::memory_order_relaxed);
+
+    Job *job = nullptr;
+    if (t <= b)
+    {
+        job = items[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+        if (t == b)
+        {
+            // Son eleman: bir hırsızla yarışıyoruz
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                job = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+    }
+    else
+    {
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+JobSystem::Job *JobSystem::WorkDeque::steal()
+{
+    std::int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b)
+        return nullptr;
+    Job *job = items[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+    return job;
+}
+
+// ---------------------------------------------------------------------------
+void JobSystem::init(unsigned int workerThreads)
+{
+    if (ready)
+        return;
+    if (workerThreads == 0)
+    {
+        unsigned int hw = std::thread::hardware_concurrency();
+        workerThreads = hw > 1 ? hw - 1 : 1;
+    }
+
+    queues.clear();
+    for (unsigned int i = 0; i <= workerThreads; ++i)
+    {
+        queues.emplace_back(new ThreadQueue());
+        queues.back()->rng = 0x9e3779b9u * (i + 1);
+    }
+    threadIndex = 0;
+    running = true;
+    ready = true;
+    for (unsigned int i = 1; i <= workerThreads; ++i)
+        threads.emplace_back(&JobSystem::workerLoop, this, static_cast<int>(i));
+}
+
+void JobSystem::shutdown()
+{
+    if (!ready)
+        return;
+    // Kuyrukta kalan işleri bitir (işçilere sabitlenmişleri onlar çalıştırır)
+    for (;;)
+    {
+        bool pending = queued.load() > 0;
+        for (auto &queue : queues)
+            pending = pending || queue->mailboxSize.load() > 0;
+        if (!pending)
+            break;
+        if (Job *job = findJob(0))
+            execute(job);
+        else
+            std::this_thread::yield();
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    wake.notify_all();
+    for (auto &t : threads)
+        t.join();
+    threads.clear();
+    queues.clear();
+    threadIndex = -1;
+    ready = false;
+}
+
+JobSystem::Job *JobSystem::allocateJob(bool mayRunInline)
+{
+    ThreadQueue &queue = *queues[threadIndex];
+    std::size_t index = queue.poolIndex;
+    if (queue.pool[index].busy.load(std::memory_order_acquire))
+    {
+        if (mayRunInline)
+            return nullptr;
+        // Sabitlenmiş iş başka iş parçacığında çalışmalı: boş yuva bulunana
+        // kadar ara ve yardım et (dolu yuvalardan biri yığınımızdaki iş olabilir)
+        for (;;)
+        {
+            std::size_t i = 1;
+            for (; i < ThreadQueue::POOL_SIZE; ++i)
+                if (!queue.pool[(index + i) % ThreadQueue::POOL_SIZE].busy.load(std::memory_order_acquire))
+                    break;
+            if (i < ThreadQueue::POOL_SIZE)
+            {
+                index = (index + i) % ThreadQueue::POOL_SIZE;
+                break;
+            }
+            if (Job *job = findJob(threadIndex))
+                execute(job);
+            else
+                std::this_thread::yield();
+        }
+    }
+    Job *job = &queue.pool[index];
+    job->busy.store(true, std::memory_order_relaxed);
+    queue.poolIndex = (index + 1) % ThreadQueue::POOL_SIZE;
+    return job;
+}
+
+void JobSystem::submit(Job *job, int pinnedThread)
+{
+    if (pinnedThread >= static_cast<int>(queues.size()))
+        pinnedThread = 0;
+
+    if (pinnedThread >= 0)
+    {
+        ThreadQueue &target = *queues[pinnedThread];
+        {
+            std::lock_guard<std::mutex> lock(target.mailboxMutex);
+            target.mailbox.push_back(job);
+            target.mailboxSize.fetch_add(1);
+        }
+        // Hedef iş parçacığı hangisi olduğunu bilmeden uyandıramayız: hepsi
+        if (sleepers.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            wake.notify_all();
+        }
+        return;
+    }
+
+    queued.fetch_add(1);
+    if (!queues[threadIndex]->deque.push(job))
+    {
+        // Deque dolu: geri basınç olarak hemen çalıştır
+        queued.fetch_sub(1);
+        execute(job);
+        return;
+    }
+    if (sleepers.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wake.notify_one();
+    }
+}
+
+JobSystem::Job *JobSystem::findJob(int index)
+{
+    ThreadQueue &own = *queues[index];
+    if (own.mailboxSize.load(std::memory_order_relaxed) > 0)
+    {
+        std::lock_guard<std::mutex> lock(own.mailboxMutex);
+        if (!own.mailbox.empty())
+        {
+            Job *job = own.mailbox.front();
+            own.mailbox.erase(own.mailbox.begin());
+            own.mailboxSize.fetch_sub(1);
+            return job;
+        }
+    }
+
+    if (Job *job = own.deque.pop())
+    {
+        queued.fetch_sub(1);
+        return job;
+    }
+
+    // Rastgele bir kurbandan başlayarak çal
+    const std::size_t count = queues.size();
+    own.rng ^= own.rng << 13;
+    own.rng ^= own.rng >> 17;
+    own.rng ^= own.rng << 5;
+    std::size_t start = own.rng % count;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::size_t victim = (start + i) % count;
+        if (victim == static_cast<std::size_t>(index))
+            continue;
+        if (Job *job = queues[victim]->deque.steal())
+        {
+            queued.fetch_sub(1);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::execute(Job *job)
+{
+    PROFILE_SCOPE("Job");
+    JobCounter *counter = job->counter;
+    job->invoke(*job);
+    job->busy.store(false, std::memory_order_release); // yuva yeniden kullanılabilir
+    if (counter)
+        counter->fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::wait(JobCounter &counter)
+{
+    if (threadIndex < 0)
+    {
+        while (counter.load(std::memory_order_acquire) > 0)
+            std::this_thread::yield();
+        return;
+    }
+    // Beklerken yardım et
+    while (counter.load(std::memory_order_acquire) > 0)
+    {
+        if (Job *job = findJob(threadIndex))
+            execute(job);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::workerLoop(int index)
+{
+    threadIndex = index;
+    ThreadQueue &own = *queues[index];
+    char name[32];
+    std::snprintf(name, sizeof(name), "Job worker %d", index);
+    PROFILE_THREAD(name);
+    int idle = 0;
+    while (running.load(std::memory_order_relaxed))
+    {
+        if (Job *job = findJob(index))
+        {
+            execute(job);
+            idle = 0;
+            continue;
+        }
+        if (++idle < SPIN_ROUNDS)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepers.fetch_add(1);
+        wake.wait(lock, [&] {
+            return !running.load() || queued.load() > 0 || own.mailboxSize.load() > 0;
+        });
+        sleepers.fetch_sub(1);
+        idle = 0;
+    }
+}
+
+std::size_t JobSystem::autoGrain(std::size_t count) const
+{
+    std::size_t chunks = static_cast<std::size_t>(threadCount()) * 4;
+    std::size_t grain = chunks ? (count + chunks - 1) / chunks : count;
+    return std::max(grain, MIN_AUTO_GRAIN);
+}
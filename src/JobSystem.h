@@ -0,0 +1,211 @@
+// JobSystem.h
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "FrameArena.h"
+
+// Jobs decrement their counter when done; waiting on it is the dependency
+// mechanism (a job may itself wait on the counter of the jobs it needs).
+using JobCounter = std::atomic<int>;
+
+// Worker threads with work-stealing deques. The thread calling init()
+// becomes thread 0: it may submit jobs and executes jobs while it waits.
+// Jobs can be submitted from thread 0 and from inside jobs; on any other
+// thread (or before init) run() executes the job immediately.
+class JobSystem
+{
+public:
+    static JobSystem &get();
+
+    // workerThreads == 0: hardware_concurrency - 1
+    void init(unsigned int workerThreads = 0);
+    void shutdown();
+    bool initialized() const { return ready; }
+    // Worker threads + thread 0
+    unsigned int threadCount() const { return static_cast<unsigned int>(queues.size()); }
+    // -1 outside the job system
+    static int currentThread();
+
+    // pinnedThread >= 0: only that thread runs the job (never stolen)
+    template <typename F>
+    void run(F &&f, JobCounter *counter = nullptr, int pinnedThread = -1);
+    // Executes other jobs until the counter reaches zero
+    void wait(JobCounter &counter);
+
+    // fn(begin, end) over [0, count). grain == 0 picks ~4 chunks per thread,
+    // at least MIN_AUTO_GRAIN items. The caller runs the first chunk itself.
+    template <typename F>
+    void parallelFor(std::size_t count, F &&fn, std::size_t grain = 0);
+    static constexpr std::size_t MIN_AUTO_GRAIN = 256;
+
+    // While alive, parallelFor on this thread runs the whole range itself.
+    // For long background jobs (hot-reload imports): their chunks would go
+    // to deques that thread 0 steals from while it waits on frame work.
+    class InlineScope
+    {
+    public:
+        InlineScope();
+        ~InlineScope();
+        InlineScope(const InlineScope &) = delete;
+        InlineScope &operator=(const InlineScope &) = delete;
+    };
+    static bool inlineOnly();
+
+    // Job data that must outlive run() but not the frame. Reset by beginFrame()
+    // on thread 0 when no job from the previous frame is in flight.
+    FrameArena &frameArena() { return arena; }
+    void beginFrame() { arena.reset(); }
+
+    ~JobSystem();
+
+private:
+    struct Job
+    {
+        void (*invoke)(Job &) = nullptr;
+        JobCounter *counter = nullptr;
+        void *heap = nullptr; // closure büyükse: arena ya da heap
+        bool ownsHeap = false;
+        std::atomic<bool> busy{false}; // sıraya girdi, henüz bitmedi
+        alignas(16) unsigned char storage[48];
+    };
+
+    // Chase-Lev: owner pushes/pops at the bottom, thieves take from the top
+    class WorkDeque
+    {
+    public:
+        static constexpr std::int64_t CAPACITY = 4096;
+        bool push(Job *job);
+        Job *pop();
+        Job *steal();
+
+    private:
+        alignas(64) std::atomic<std::int64_t> top{0};
+        alignas(64) std::atomic<std::int64_t> bottom{0};
+        std::atomic<Job *> items[CAPACITY];
+    };
+
+    // Per-thread state. The job pool is a ring of POOL_SIZE slots; a slot is
+    // reused only once its job has finished (Job::busy). When the next slot
+    // is still busy run() executes the job inline instead, like a full deque.
+    struct ThreadQueue
+    {
+        static constexpr std::size_t POOL_SIZE = 4096;
+        WorkDeque deque;
+        std::unique_ptr<Job[]> pool{new Job[POOL_SIZE]};
+        std::size_t poolIndex = 0;
+        std::uint32_t rng = 0;
+
+        std::mutex mailboxMutex; // sabitlenmiş işler
+        std::vector<Job *> mailbox;
+        std::atomic<int> mailboxSize{0};
+    };
+
+    std::vector<std::unique_ptr<ThreadQueue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<bool> running{false};
+    bool ready = false;
+    FrameArena arena{4 << 20};
+
+    // Uyuyan işçiler
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> sleepers{0};
+    std::atomic<int> queued{0};
+
+    JobSystem() = default;
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    // nullptr if the next slot is busy and mayRunInline; otherwise helps
+    // with other jobs until some slot is free
+    Job *allocateJob(bool mayRunInline);
+    void submit(Job *job, int pinnedThread);
+    Job *findJob(int index);
+    void execute(Job *job);
+    void workerLoop(int index);
+    std::size_t autoGrain(std::size_t count) const;
+};
+
+template <typename F>
+void JobSystem::run(F &&f, JobCounter *counter, int pinnedThread)
+{
+    using Fn = typename std::decay<F>::type;
+    if (currentThread() < 0)
+    {
+        f(); // iş sistemi dışından: hemen çalıştır
+        return;
+    }
+
+    Job *job = allocateJob(pinnedThread < 0 || pinnedThread == currentThread());
+    if (!job)
+    {
+        f(); // havuz dolu: geri basınç, çağıran çalıştırır
+        return;
+    }
+    job->counter = counter;
+    if (sizeof(Fn) <= sizeof(job->storage) && alignof(Fn) <= 16)
+    {
+        new (job->storage) Fn(std::forward<F>(f));
+        job->heap = nullptr;
+        job->ownsHeap = false;
+        job->invoke = [](Job &j) {
+            Fn *fn = reinterpret_cast<Fn *>(j.storage);
+            (*fn)();
+            fn->~Fn();
+        };
+    }
+    else
+    {
+        void *memory = arena.allocate(sizeof(Fn), alignof(Fn));
+        job->ownsHeap = memory == nullptr;
+        if (!memory)
+            memory = ::operator new(sizeof(Fn));
+        job->heap = new (memory) Fn(std::forward<F>(f));
+        job->invoke = [](Job &j) {
+            Fn *fn = static_cast<Fn *>(j.heap);
+            (*fn)();
+            fn->~Fn();
+            if (j.ownsHeap)
+                ::operator delete(j.heap);
+        };
+    }
+    if (counter)
+        counter->fetch_add(1, std::memory_order_relaxed);
+    submit(job, pinnedThread);
+}
+
+template <typename F>
+void JobSystem::parallelFor(std::size_t count, F &&fn, std::size_t grain)
+{
+    if (count == 0)
+        return;
+    std::size_t chunk = grain ? grain : autoGrain(count);
+    if (chunk >= count || currentThread() < 0 || inlineOnly())
+    {
+        fn(std::size_t(0), count);
+        return;
+    }
+
+    JobCounter counter{0};
+    for (std::size_t begin = chunk; begin < count; begin += chunk)
+    {
+        std::size_t end = std::min(count, begin + chunk);
+        run([&fn, begin, end] { fn(begin, end); }, &counter);
+    }
+    fn(std::size_t(0), chunk);
+    wait(counter);
+}
+
+#endif // JOBSYSTEM_H
@@ -0,0 +1,36 @@
+// Lights.h
+#ifndef LIGHTS_H
+#define LIGHTS_H
+
+#include <cstddef>
+#include <glm/glm.hpp>
+
+// Must match MAX_SPOT_LIGHTS / LightBlock in the shaders
+constexpr int MAX_SPOT_LIGHTS = 64;
+constexpr unsigned int LIGHT_BLOCK_BINDING = 0;
+
+// std140 uyumlu: her vec3'ü bir float tamamlar (16 bayt)
+struct SpotLight
+{
+    glm::vec3 position;
+    float cutOff;      // cos(inner angle)
+    glm::vec3 direction;
+    float outerCutOff; // cos(outer angle)
+    glm::vec3 ambient;
+    float constant;
+    glm::vec3 diffuse;
+    float linear;
+    glm::vec3 specular;
+    float quadratic;
+};
+static_assert(sizeof(SpotLight) == 80, "SpotLight must match the std140 layout");
+
+struct LightBlockHeader
+{
+    int numSpotLights;
+    int pad[3];
+};
+
+constexpr std::size_t LIGHT_BLOCK_SIZE = sizeof(LightBlockHeader) + MAX_SPOT_LIGHTS * sizeof(SpotLight);
+
+#endif // LIGHTS_H
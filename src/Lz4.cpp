@@ -0,0 +1,165 @@
+// Lz4.cpp
+#include "Lz4.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    constexpr int HASH_LOG = 14;
+    constexpr std::size_t MIN_MATCH = 4;
+    constexpr std::size_t LAST_LITERALS = 5; // son 5 bayt her zaman literal
+    constexpr std::size_t MF_LIMIT = 12;     // son eşleşme en geç sondan 12 bayt önce başlar
+    constexpr std::size_t MAX_OFFSET = 65535;
+
+    std::uint32_t read32(const unsigned char *p)
+    {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    std::uint32_t hash4(std::uint32_t sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - HASH_LOG);
+    }
+
+    // 15 ve üstü uzunluklar 255'lik ek baytlarla devam eder
+    void writeLength(unsigned char *dst, std::size_t &op, std::size_t length)
+    {
+        while (length >= 255)
+        {
+            dst[op++] = 255;
+            length -= 255;
+        }
+        dst[op++] = static_cast<unsigned char>(length);
+    }
+
+    // matchLength == 0: son dizi, sadece literal
+    bool emitSequence(unsigned char *dst, std::size_t capacity, std::size_t &op, const unsigned char *literals,
+                      std::size_t literalLength, std::size_t offset, std::size_t matchLength)
+    {
+        const std::size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+        const std::size_t worst = 1 + literalLength / 255 + 1 + literalLength + 2 + matchCode / 255 + 1;
+        if (capacity - op < worst)
+            return false;
+
+        unsigned char &token = dst[op++];
+        token = static_cast<unsigned char>((literalLength < 15 ? literalLength : 15) << 4);
+        if (literalLength >= 15)
+            writeLength(dst, op, literalLength - 15);
+        if (literalLength)
+            std::memcpy(dst + op, literals, literalLength);
+        op += literalLength;
+        if (!matchLength)
+            return true;
+
+        dst[op++] = static_cast<unsigned char>(offset & 0xFF);
+        dst[op++] = static_cast<unsigned char>(offset >> 8);
+        token |= static_cast<unsigned char>(matchCode < 15 ? matchCode : 15);
+        if (matchCode >= 15)
+            writeLength(dst, op, matchCode - 15);
+        return true;
+    }
+
+    bool readLength(const unsigned char *src, std::size_t size, std::size_t &ip, std::size_t &length)
+    {
+        unsigned char b;
+        do
+        {
+            if (ip >= size)
+                return false;
+            b = src[ip++];
+            length += b;
+        } while (b == 255);
+        return true;
+    }
+}
+
+std::size_t lz4Compress(const unsigned char *src, std::size_t size, unsigned char *dst, std::size_t capacity)
+{
+    std::size_t ip = 0, anchor = 0, op = 0;
+    if (size > MF_LIMIT)
+    {
+        std::vector<std::uint32_t> table(std::size_t(1) << HASH_LOG, 0);
+        const std::size_t matchLimit = size - LAST_LITERALS;
+        const std::size_t startLimit = size - MF_LIMIT;
+        while (ip < startLimit)
+        {
+            const std::uint32_t sequence = read32(src + ip);
+            const std::uint32_t h = hash4(sequence);
+            std::size_t ref = table[h];
+            table[h] = static_cast<std::uint32_t>(ip);
+            if (ref >= ip || ip - ref > MAX_OFFSET || read32(src + ref) != sequence)
+            {
+                // Sıkışmayan veride giderek daha büyük adımlar
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+
+            // Eşleşmeyi geriye ve ileriye uzat
+            while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1])
+            {
+                --ip;
+                --ref;
+            }
+            std::size_t length = MIN_MATCH;
+            while (ip + length < matchLimit && src[ip + length] == src[ref + length])
+                ++length;
+
+            if (!emitSequence(dst, capacity, op, src + anchor, ip - anchor, ip - ref, length))
+                return 0;
+            ip += length;
+            anchor = ip;
+        }
+    }
+    if (!emitSequence(dst, capacity, op, src + anchor, size - anchor, 0, 0))
+        return 0;
+    return op;
+}
+
+bool lz4Decompress(const unsigned char *src, std::size_t size, unsigned char *dst, std::size_t decodedSize)
+{
+    std::size_t ip = 0, op = 0;
+    while (ip < size)
+    {
+        const unsigned char token = src[ip++];
+        std::size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(src, size, ip, literalLength))
+            return false;
+        if (literalLength > size - ip || literalLength > decodedSize - op)
+            return false;
+        if (literalLength)
+            std::memcpy(dst + op, src + ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+        if (ip == size)
+            break; // son dizi
+
+        if (size - ip < 2)
+            return false;
+        const std::size_t offset = src[ip] | (static_cast<std::size_t>(src[ip + 1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > op)
+            return false;
+        std::size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(src, size, ip, matchLength))
+            return false;
+        matchLength += MIN_MATCH;
+        if (matchLength > decodedSize - op)
+            return false;
+
+        unsigned char *out = dst + op;
+        const unsigned char *match = out - offset;
+        if (offset >= matchLength)
+            std::memcpy(out, match, matchLength);
+        else
+        {
+            // Çakışan kopya (tekrarlanan desen): bayt bayt
+            for (std::size_t i = 0; i < matchLength; ++i)
+                out[i] = match[i];
+        }
+        op += matchLength;
+    }
+    return op == decodedSize;
+}
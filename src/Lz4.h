@@ -0,0 +1,22 @@
+// Lz4.h
+#ifndef LZ4_H
+#define LZ4_H
+
+#include <cstddef>
+
+// LZ4 block format (no frame header, no checksum): greedy single-probe
+// compressor and a bounds-checked decoder that rejects malformed input
+// instead of reading or writing out of range.
+
+// Worst-case compressed size of n bytes
+constexpr std::size_t lz4CompressBound(std::size_t n)
+{
+    return n + n / 255 + 16;
+}
+
+// Returns the compressed size, or 0 if it does not fit in capacity
+std::size_t lz4Compress(const unsigned char *src, std::size_t size, unsigned char *dst, std::size_t capacity);
+// The decoded size must be known; false on malformed input or size mismatch
+bool lz4Decompress(const unsigned char *src, std::size_t size, unsigned char *dst, std::size_t decodedSize);
+
+#endif // LZ4_H
@@ -0,0 +1,114 @@
+// MappedFile.cpp
+#include "MappedFile.h"
+#include <utility>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        std::swap(bytes, other.bytes);
+        std::swap(length, other.length);
+        std::swap(opened, other.opened);
+#ifdef _WIN32
+        std::swap(fileHandle, other.fileHandle);
+        std::swap(mappingHandle, other.mappingHandle);
+#endif
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string &path, std::string &error)
+{
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    fileHandle = file;
+    opened = true;
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    if (length == 0)
+        return true; // boş dosya eşlenemez; boş görünüm yeterli
+    mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle)
+        bytes = static_cast<const unsigned char *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        error = "cannot stat " + path;
+        return false;
+    }
+    opened = true;
+    length = static_cast<std::size_t>(info.st_size);
+    if (length == 0)
+    {
+        ::close(fd);
+        return true;
+    }
+    void *view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // eşleme dosya tanıtıcısından bağımsız yaşar
+    if (view != MAP_FAILED)
+        bytes = static_cast<const unsigned char *>(view);
+#endif
+    if (!bytes)
+    {
+        close();
+        error = "cannot map " + path;
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+    if (bytes)
+        UnmapViewOfFile(bytes);
+    if (mappingHandle)
+        CloseHandle(mappingHandle);
+    if (fileHandle)
+        CloseHandle(fileHandle);
+    fileHandle = mappingHandle = nullptr;
+#else
+    if (bytes)
+        munmap(const_cast<unsigned char *>(bytes), length);
+#endif
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+}
@@ -0,0 +1,39 @@
+// MappedFile.h
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory map of a whole file (mmap / MapViewOfFile). Pages are
+// faulted in on first touch, so opening is cheap whatever the file size.
+// Move-only; the view is valid until the object is destroyed.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // false (and error set) if the file cannot be opened or mapped
+    bool open(const std::string &path, std::string &error);
+    void close();
+
+    const unsigned char *data() const { return bytes; }
+    std::size_t size() const { return length; }
+    bool isOpen() const { return opened; }
+
+private:
+    const unsigned char *bytes = nullptr;
+    std::size_t length = 0;
+    bool opened = false;
+#ifdef _WIN32
+    void *fileHandle = nullptr;
+    void *mappingHandle = nullptr;
+#endif
+};
+
+#endif // MAPPEDFILE_H
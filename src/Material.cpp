@@ -0,0 +1,242 @@
+// Material.cpp
+#include "Material.h"
+#include "RenderCounters.h"
+#include <glad/glad.h>
+#include <filesystem>
+#include <stb_image.h>
+#include <iostream>
+
+namespace
+{
+    // Sürücüler RGB'yi çoğunlukla 4 bayta yaslar; mip zinciri +1/3
+    std::int64_t textureBytes(int width, int height, int components)
+    {
+        return static_cast<std::int64_t>(width) * height * (components == 1 ? 1 : 4) * 4 / 3;
+    }
+}
+
+MaterialLibrary &MaterialLibrary::get()
+{
+    static MaterialLibrary library;
+    return library;
+}
+
+void MaterialLibrary::initDefaults()
+{
+    // 1x1 beyaz doku: haritası olmayan slotlar bununla örneklenir
+    const unsigned char white[4] = {255, 255, 255, 255};
+    glGenTextures(1, &whiteTexture);
+    glBindTexture(GL_TEXTURE_2D, whiteTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    RenderCounters::trackTexture(4);
+
+    // Filtreleme ve sarma ayarları doku yerine sampler nesnesinde tutulur
+    glGenSamplers(1, &sharedSampler);
+    glSamplerParameteri(sharedSampler, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glSamplerParameteri(sharedSampler, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glSamplerParameteri(sharedSampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glSamplerParameteri(sharedSampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // Material 0: floor, walls, robot and anything without an imported material
+    Material fallback;
+    fallback.textures[SLOT_DIFFUSE] = whiteTexture;
+    fallback.textures[SLOT_SPECULAR] = whiteTexture;
+    fallback.sampler = sharedSampler;
+    fallback.name = intern("default");
+    materials.push_back(fallback);
+}
+
+void MaterialLibrary::fillDefaults(Material &material) const
+{
+    for (unsigned int slot = 0; slot < SLOT_COUNT; ++slot)
+    {
+        if (material.textures[slot] == 0)
+            material.textures[slot] = whiteTexture;
+    }
+    if (material.sampler == 0)
+        material.sampler = sharedSampler;
+}
+
+MaterialID MaterialLibrary::create(Material material)
+{
+    if (materials.empty())
+        initDefaults();
+
+    // ID'ler 16 bit ve 0xFFFF (NO_MATERIAL) ayrılmış: taşan ID varsayılan
+    // materyalin üstüne sarmasın, yeni materyal reddedilir
+    if (materials.size() >= NO_MATERIAL)
+    {
+        if (!reportedFull)
+            std::cerr << "Material library full (" << materials.size()
+                      << " materials), further materials use the default\n";
+        reportedFull = true;
+        return DEFAULT_MATERIAL;
+    }
+
+    fillDefaults(material);
+    materials.push_back(material);
+    return static_cast<MaterialID>(materials.size() - 1);
+}
+
+void MaterialLibrary::replace(MaterialID id, Material material)
+{
+    fillDefaults(material);
+    materials[id] = material;
+    if (boundMaterial == id)
+        boundMaterial = NO_MATERIAL;
+}
+
+unsigned int MaterialLibrary::loadTexture(const std::string &path)
+{
+    auto it = textureCache.find(path);
+    if (it != textureCache.end())
+        return it->second.id;
+
+    int width, height, nrComponents;
+    unsigned char *data = stbi_load(path.c_str(), &width, &height, &nrComponents, 0);
+    if (!data)
+        std::cerr << "Failed to load texture at path: " << path << "\n";
+    unsigned int id = createTexture(path, data, width, height, nrComponents);
+    stbi_image_free(data);
+    return id;
+}
+
+unsigned int MaterialLibrary::createTexture(const std::string &path, const unsigned char *pixels, int width,
+                                            int height, int components)
+{
+    auto it = textureCache.find(path);
+    if (it != textureCache.end())
+        return it->second.id;
+
+    CachedTexture texture;
+    if (pixels)
+    {
+        GLenum format = (components == 1 ? GL_RED : components == 3 ? GL_RGB
+                                                                    : GL_RGBA);
+        glGenTextures(1, &texture.id);
+        glBindTexture(GL_TEXTURE_2D, texture.id);
+        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        RenderCounters::trackTexture(textureBytes(width, height, components));
+        texture.width = width;
+        texture.height = height;
+        texture.components = components;
+    }
+
+    // Bind cache artık geçersiz (GL_TEXTURE_2D değişti)
+    resetBindings();
+    textureCache.emplace(path, texture);
+    intern(path);
+    return texture.id;
+}
+
+std::string MaterialLibrary::texturePath(const std::string &file) const
+{
+    if (textureCache.count(file))
+        return file;
+    const std::filesystem::path normal = std::filesystem::path(file).lexically_normal();
+    for (const auto &entry : textureCache)
+        if (std::filesystem::path(entry.first).lexically_normal() == normal)
+            return entry.first;
+    return std::string();
+}
+
+bool MaterialLibrary::reloadTexture(const std::string &path, const unsigned char *pixels, int width, int height,
+                                    int components)
+{
+    auto it = textureCache.find(path);
+    if (it == textureCache.end() || !it->second.id || !pixels)
+        return false; // ilk yüklemede başarısız: materyaller beyaz dokuyu gösteriyor
+
+    // Aynı GL adı: materyaller değişmeden yeni pikselleri örnekler
+    CachedTexture &texture = it->second;
+    GLenum format = (components == 1 ? GL_RED : components == 3 ? GL_RGB
+                                                                : GL_RGBA);
+    glBindTexture(GL_TEXTURE_2D, texture.id);
+    if (width == texture.width && height == texture.height && components == texture.components)
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, GL_UNSIGNED_BYTE, pixels);
+    else
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+        RenderCounters::trackTexture(textureBytes(width, height, components) -
+                                     textureBytes(texture.width, texture.height, texture.components));
+        texture.width = width;
+        texture.height = height;
+        texture.components = components;
+    }
+    glGenerateMipmap(GL_TEXTURE_2D);
+    resetBindings();
+    return true;
+}
+
+void MaterialLibrary::resetBindings()
+{
+    boundMaterial = NO_MATERIAL;
+    for (unsigned int slot = 0; slot < SLOT_COUNT; ++slot)
+    {
+        boundTextures[slot] = 0;
+        boundSamplers[slot] = 0;
+    }
+}
+
+void MaterialLibrary::forgetProgram(unsigned int program)
+{
+    if (boundProgram == program)
+    {
+        boundProgram = 0;
+        boundMaterial = NO_MATERIAL;
+    }
+}
+
+void MaterialLibrary::bind(MaterialID id, const Shader &shader)
+{
+    if (materials.empty())
+        initDefaults();
+
+    // Program değiştiyse uniform konumlarını bir kez çöz, sampler birimlerini sabitle
+    if (shader.ID != boundProgram)
+    {
+        boundProgram = shader.ID;
+        boundMaterial = NO_MATERIAL;
+        glUniform1i(glGetUniformLocation(shader.ID, "texture_diffuse1"), SLOT_DIFFUSE);
+        glUniform1i(glGetUniformLocation(shader.ID, "texture_specular1"), SLOT_SPECULAR);
+        locDiffuseColor = glGetUniformLocation(shader.ID, "material.diffuseColor");
+        locShininess = glGetUniformLocation(shader.ID, "material.shininess");
+    }
+    if (id == boundMaterial)
+        return;
+
+    const Material &mat = materials[id];
+    for (unsigned int slot = 0; slot < SLOT_COUNT; ++slot)
+    {
+        if (boundTextures[slot] != mat.textures[slot])
+        {
+            glActiveTexture(GL_TEXTURE0 + slot);
+            glBindTexture(GL_TEXTURE_2D, mat.textures[slot]);
+            boundTextures[slot] = mat.textures[slot];
+            RenderCounters::stateChange();
+        }
+        if (boundSamplers[slot] != mat.sampler)
+        {
+            glBindSampler(slot, mat.sampler);
+            boundSamplers[slot] = mat.sampler;
+            RenderCounters::stateChange();
+        }
+    }
+    glActiveTexture(GL_TEXTURE0);
+
+    glUniform3fv(locDiffuseColor, 1, &mat.diffuseColor[0]);
+    glUniform1f(locShininess, mat.shininess);
+    boundMaterial = id;
+}
+
+std::uint32_t MaterialLibrary::intern(const std::string &str)
+{
+    auto it = stringIds.find(str);
+    if (it != stringIds.end())
+        return it->second;
+    std::uint32_t id = static_cast<std::uint32_t>(strings.size());
+    strings.push_back(str);
+    stringIds.emplace(str, id);
+    return id;
+}
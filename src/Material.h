@@ -0,0 +1,109 @@
+// Material.h
+#ifndef MATERIAL_H
+#define MATERIAL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include "Shader.h"
+
+// Meshes refer to materials through this compact index into MaterialLibrary
+using MaterialID = std::uint16_t;
+constexpr MaterialID DEFAULT_MATERIAL = 0;
+
+// Every texture kind lives on a fixed unit, so sampler uniforms are set once per program
+enum TextureSlot : unsigned int
+{
+    SLOT_DIFFUSE = 0,
+    SLOT_SPECULAR = 1,
+    SLOT_COUNT
+};
+
+// Shader permutation key bits (also the primary material sort key)
+enum MaterialFeature : std::uint32_t
+{
+    MAT_DIFFUSE_MAP = 1u << 0,
+    MAT_SPECULAR_MAP = 1u << 1
+};
+
+struct Material
+{
+    unsigned int textures[SLOT_COUNT] = {0, 0}; // GL texture per slot (default white when missing)
+    unsigned int sampler = 0;
+    std::uint32_t permutation = 0;
+
+    // Constant parameters
+    glm::vec3 diffuseColor{1.0f};
+    float shininess = 32.0f;
+
+    std::uint32_t name = 0; // interned, only for tooling / debug UI
+};
+
+class MaterialLibrary
+{
+public:
+    static MaterialLibrary &get();
+
+    // DEFAULT_MATERIAL once every ID up to NO_MATERIAL is taken
+    MaterialID create(Material material);
+    // Overwrites a material in place (hot reload); meshes keep their ID
+    void replace(MaterialID id, Material material);
+    const Material &operator[](MaterialID id) const { return materials[id]; }
+    std::size_t size() const { return materials.size(); }
+
+    // Loads (or reuses) a 2D texture; returns 0 if the file cannot be read
+    unsigned int loadTexture(const std::string &path);
+    // Uploads already decoded 8-bit pixels (e.g. from an AssetPack) and caches
+    // them under path, so later loadTexture(path) calls reuse the texture
+    unsigned int createTexture(const std::string &path, const unsigned char *pixels, int width, int height,
+                               int components);
+    // Hot reload: cache key of a loaded texture file (compared as normal
+    // paths), empty if no material uses it
+    std::string texturePath(const std::string &file) const;
+    // Replaces the pixels of a cached texture in place, so every material
+    // sampling it follows. False if path never loaded successfully.
+    bool reloadTexture(const std::string &path, const unsigned char *pixels, int width, int height, int components);
+
+    // Applies the material's texture units, sampler and constants; no-op if already bound
+    void bind(MaterialID id, const Shader &shader);
+    // Forget cached bindings, e.g. after other code touched texture / sampler state
+    void resetBindings();
+    // A program was deleted (shader hot reload); its ID may come back
+    void forgetProgram(unsigned int program);
+
+    // Tooling-side string storage; never touched while drawing
+    std::uint32_t intern(const std::string &str);
+    const std::string &lookup(std::uint32_t id) const { return strings[id]; }
+
+private:
+    MaterialLibrary() = default;
+    void initDefaults();
+    void fillDefaults(Material &material) const;
+
+    std::vector<Material> materials;
+    struct CachedTexture
+    {
+        unsigned int id = 0;
+        int width = 0, height = 0, components = 0;
+    };
+    std::unordered_map<std::string, CachedTexture> textureCache; // path -> GL texture
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, std::uint32_t> stringIds;
+
+    bool reportedFull = false;
+
+    unsigned int whiteTexture = 0;
+    unsigned int sharedSampler = 0;
+
+    // Currently bound state
+    static constexpr MaterialID NO_MATERIAL = 0xFFFF;
+    MaterialID boundMaterial = NO_MATERIAL;
+    unsigned int boundProgram = 0;
+    unsigned int boundTextures[SLOT_COUNT] = {0, 0};
+    unsigned int boundSamplers[SLOT_COUNT] = {0, 0};
+    int locDiffuseColor = -1, locShininess = -1;
+};
+
+#endif // MATERIAL_H
@@ -1,12 +1,54 @@
 #include "Mesh.h"
+#include "RenderCounters.h"
 #include <glad/glad.h>
+#include <utility>
+#include <vector>
 
-Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures)
-    : vertices(vertices), indices(indices), textures(textures) {
+static std::int64_t bufferBytes(const MeshData &geometry) {
+    return static_cast<std::int64_t>(geometry.vertices.size() * (sizeof(Vertex) + sizeof(glm::vec3)) +
+                                     geometry.indices.size() * sizeof(unsigned int));
+}
+
+// Depth akışı: pozisyonlar ara vektör olmadan eşlenen buffer'a yazılır; eşleme
+// olmazsa (ya da glUnmapBuffer içeriği kaybettiyse) geçici kopyayla
+static void uploadPositions(unsigned int buffer, const ArrayView<Vertex> &vertices, bool sameSize) {
+    const std::size_t bytes = vertices.size() * sizeof(glm::vec3);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (!sameSize)
+        glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STATIC_DRAW);
+    if (bytes == 0)
+        return;
+    if (void *mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT)) {
+        glm::vec3 *positions = static_cast<glm::vec3 *>(mapped);
+        for (size_t i = 0; i < vertices.size(); i++)
+            positions[i] = vertices[i].Position;
+        if (glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE)
+            return;
+    }
+    std::vector<glm::vec3> positions(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++)
+        positions[i] = vertices[i].Position;
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, positions.data());
+}
+
+// Aynı boydaysa yerinde güncelle, değilse yeniden ayır (buffer adı, dolayısıyla VAO bağlantısı aynı kalır)
+static void refill(GLenum target, unsigned int buffer, const void *data, std::size_t bytes, bool sameSize) {
+    glBindBuffer(target, buffer);
+    if (sameSize)
+        glBufferSubData(target, 0, bytes, data);
+    else
+        glBufferData(target, bytes, data, GL_STATIC_DRAW);
+}
+
+Mesh::Mesh(MeshData geometry, MaterialID material)
+    : geometry(std::move(geometry)), material(material) {
+    this->geometry.detach(); // import arenasına bakıyorsa kendi bloğuna
     setupMesh();
 }
 
 void Mesh::setupMesh() {
+    const ArrayView<Vertex> &vertices = geometry.vertices;
+    const ArrayView<unsigned int> &indices = geometry.indices;
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
     glGenBuffers(1, &EBO);
@@ -28,27 +70,76 @@ void Mesh::setupMesh() {
     glEnableVertexAttribArray(2);
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
 
+    // Depth pre-pass için ayrı, sıkı paketlenmiş pozisyon akışı (32 yerine 12 bayt/vertex)
+    glGenVertexArrays(1, &depthVAO);
+    glGenBuffers(1, &positionVBO);
+    glBindVertexArray(depthVAO);
+    uploadPositions(positionVBO, vertices, false);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+
     glBindVertexArray(0);
+    RenderCounters::trackBuffer(bufferBytes(geometry));
 }
 
-void Mesh::draw(Shader &shader) {
-    // Texture bind
-    unsigned int diffuseNr  = 1;
-    unsigned int specularNr = 1;
-    for (unsigned int i = 0; i < textures.size(); i++) {
-        glActiveTexture(GL_TEXTURE0 + i);
-        std::string number;
-        if (textures[i].type == "texture_diffuse")
-            number = std::to_string(diffuseNr++);
-        else if (textures[i].type == "texture_specular")
-            number = std::to_string(specularNr++);
-        shader.setInt((textures[i].type + number).c_str(), i);
-        glBindTexture(GL_TEXTURE_2D, textures[i].id);
+Mesh Mesh::reuse(Mesh &old, MeshData geometry, MaterialID material, std::size_t &uploadedBytes) {
+    Mesh mesh;
+    mesh.geometry = std::move(geometry);
+    mesh.geometry.detach();
+    mesh.material = material;
+    std::swap(mesh.VAO, old.VAO);
+    std::swap(mesh.VBO, old.VBO);
+    std::swap(mesh.EBO, old.EBO);
+    std::swap(mesh.depthVAO, old.depthVAO);
+    std::swap(mesh.positionVBO, old.positionVBO);
+
+    const MeshData &now = mesh.geometry, &before = old.geometry;
+    if (!sameBytes(now.vertices, before.vertices)) {
+        const bool sameSize = now.vertices.size() == before.vertices.size();
+        refill(GL_ARRAY_BUFFER, mesh.VBO, now.vertices.data(), now.vertices.size() * sizeof(Vertex), sameSize);
+        uploadPositions(mesh.positionVBO, now.vertices, sameSize);
+        uploadedBytes += now.vertices.size() * (sizeof(Vertex) + sizeof(glm::vec3));
+    }
+    if (!sameBytes(now.indices, before.indices)) {
+        // EBO VAO durumunun parçası: bağlamak için VAO'lardan biri bağlı olmalı
+        glBindVertexArray(mesh.VAO);
+        refill(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO, now.indices.data(), now.indices.size() * sizeof(unsigned int),
+               now.indices.size() == before.indices.size());
+        glBindVertexArray(0);
+        uploadedBytes += now.indices.size() * sizeof(unsigned int);
     }
-    glActiveTexture(GL_TEXTURE0);
+    RenderCounters::trackBuffer(bufferBytes(now) - bufferBytes(before));
+    return mesh;
+}
+
+void Mesh::release() {
+    if (!VAO)
+        return;
+    const unsigned int arrays[2] = {VAO, depthVAO};
+    const unsigned int buffers[3] = {VBO, EBO, positionVBO};
+    glDeleteVertexArrays(2, arrays);
+    glDeleteBuffers(3, buffers);
+    RenderCounters::trackBuffer(-bufferBytes(geometry));
+    VAO = VBO = EBO = depthVAO = positionVBO = 0;
+}
+
+void Mesh::draw(Shader &shader) const {
+    // Materyal (önceki çizimle aynıysa hiçbir GL çağrısı yapılmaz)
+    MaterialLibrary::get().bind(material, shader);
 
     // Çizim
     glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, (GLsizei)indices.size(), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, (GLsizei)geometry.indices.size(), GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
+    RenderCounters::stateChange();
+    RenderCounters::draw(geometry.indices.size() / 3);
+}
+
+void Mesh::drawDepth() const {
+    glBindVertexArray(depthVAO);
+    glDrawElements(GL_TRIANGLES, (GLsizei)geometry.indices.size(), GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
+    RenderCounters::stateChange();
+    RenderCounters::draw(geometry.indices.size() / 3);
 }
@@ -1,35 +1,34 @@
 #ifndef MESH_H
 #define MESH_H
 
-#include <vector>
 #include <string>
 #include <glm/glm.hpp>
+#include "MeshData.h"
 #include "Shader.h"
-
-struct Vertex {
-    glm::vec3 Position;
-    glm::vec3 Normal;
-    glm::vec2 TexCoords;
-};
-
-struct Texture {
-    unsigned int id;
-    std::string type;
-    std::string path;
-};
+#include "Material.h"
 
 class Mesh {
 public:
-    // Mesh verisi
-    std::vector<Vertex>    vertices;
-    std::vector<unsigned int> indices;
-    std::vector<Texture>   textures;
+    // Mesh verisi (CPU kopyası tek blokta: sınırlar ve hot reload karşılaştırması için)
+    MeshData               geometry;
+    MaterialID             material;
 
-    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures);
-    void draw(Shader &shader);
+    Mesh(MeshData geometry, MaterialID material);
+    void draw(Shader &shader) const;
+    // Depth pre-pass: sadece pozisyon akışı, materyal yok
+    void drawDepth() const;
+    // Deletes the GL objects. Meshes are copied by value, so this is explicit
+    // rather than a destructor; the mesh must not be drawn afterwards.
+    void release();
+    // Hot reload: takes over the GL objects of old, which is left empty, and
+    // re-uploads only the buffers whose content differs from old's. Bytes
+    // sent to the GPU are added to uploadedBytes.
+    static Mesh reuse(Mesh &old, MeshData geometry, MaterialID material, std::size_t &uploadedBytes);
 
 private:
-    unsigned int VAO, VBO, EBO;
+    Mesh() = default;
+    unsigned int VAO = 0, VBO = 0, EBO = 0;
+    unsigned int depthVAO = 0, positionVBO = 0; // interleaved Vertex'ten ayıklanmış vec3 akışı
     void setupMesh();
 };
 
@@ -0,0 +1,70 @@
+// MeshData.cpp
+#include "MeshData.h"
+#include "ImportArena.h"
+#include <utility>
+
+// Vertex dizisinin sonu unsigned int için hizalı kalır (32 bayt / vertex)
+static_assert(sizeof(Vertex) % alignof(unsigned int) == 0, "indices follow vertices in one block");
+
+MeshData::MeshData(const MeshData &other)
+    : materialIndex(other.materialIndex), hasNormals(other.hasNormals)
+{
+    allocate(other.vertices.size(), other.indices.size());
+    if (!other.vertices.empty())
+        std::memcpy(vertices.data(), other.vertices.data(), other.vertices.size() * sizeof(Vertex));
+    if (!other.indices.empty())
+        std::memcpy(indices.data(), other.indices.data(), other.indices.size() * sizeof(unsigned int));
+}
+
+MeshData::MeshData(MeshData &&other) noexcept
+    : vertices(other.vertices), indices(other.indices), materialIndex(other.materialIndex),
+      hasNormals(other.hasNormals), storage(std::move(other.storage))
+{
+    other.vertices = ArrayView<Vertex>();
+    other.indices = ArrayView<unsigned int>();
+}
+
+MeshData &MeshData::operator=(MeshData other) noexcept
+{
+    std::swap(vertices, other.vertices);
+    std::swap(indices, other.indices);
+    std::swap(materialIndex, other.materialIndex);
+    std::swap(hasNormals, other.hasNormals);
+    std::swap(storage, other.storage);
+    return *this;
+}
+
+void MeshData::allocate(std::size_t vertexCount, std::size_t indexCount)
+{
+    const std::size_t total = vertexCount * sizeof(Vertex) + indexCount * sizeof(unsigned int);
+    storage.reset(total ? new unsigned char[total] : nullptr);
+    unsigned char *block = storage.get();
+    vertices = ArrayView<Vertex>(vertexCount ? reinterpret_cast<Vertex *>(block) : nullptr, vertexCount);
+    indices = ArrayView<unsigned int>(
+        indexCount ? reinterpret_cast<unsigned int *>(block + vertexCount * sizeof(Vertex)) : nullptr, indexCount);
+}
+
+void MeshData::allocate(ImportArena &arena, std::size_t vertexCount, std::size_t indexCount)
+{
+    storage.reset();
+    vertices = ArrayView<Vertex>(arena.allocateArray<Vertex>(vertexCount), vertexCount);
+    indices = ArrayView<unsigned int>(arena.allocateArray<unsigned int>(indexCount), indexCount);
+}
+
+bool MeshData::owns() const
+{
+    if (bytes() == 0)
+        return !storage;
+    const unsigned char *block = storage.get();
+    return block && (vertices.empty() || reinterpret_cast<const unsigned char *>(vertices.data()) == block) &&
+           (indices.empty() ||
+            reinterpret_cast<const unsigned char *>(indices.data()) == block + vertices.size() * sizeof(Vertex));
+}
+
+void MeshData::detach()
+{
+    if (owns())
+        return;
+    MeshData copy(*this); // eski blok (varsa) takasla bırakılır
+    *this = std::move(copy);
+}
@@ -0,0 +1,76 @@
+// MeshData.h
+#ifndef MESHDATA_H
+#define MESHDATA_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <glm/glm.hpp>
+
+class ImportArena;
+
+struct Vertex
+{
+    glm::vec3 Position;
+    glm::vec3 Normal;
+    glm::vec2 TexCoords;
+};
+
+// Pointer and count over memory owned elsewhere (a MeshData block or an
+// ImportArena); copying a view does not copy the elements
+template <typename T>
+class ArrayView
+{
+public:
+    ArrayView() = default;
+    ArrayView(T *data, std::size_t size) : first(data), count(size) {}
+
+    T *data() const { return first; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T *begin() const { return first; }
+    T *end() const { return first + count; }
+    T &operator[](std::size_t i) const { return first[i]; }
+
+private:
+    T *first = nullptr;
+    std::size_t count = 0;
+};
+
+// Same size and same bytes
+template <typename T>
+bool sameBytes(ArrayView<T> a, ArrayView<T> b)
+{
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+// Vertices and indices of one mesh. A finished mesh keeps both arrays in a
+// single heap block of exactly their size (vertices first, then indices).
+// During Model::import they point into the import's arenas instead, and
+// detach() makes the final copy before those are released. Copies are deep.
+struct MeshData
+{
+    ArrayView<Vertex> vertices;
+    ArrayView<unsigned int> indices;
+    unsigned int materialIndex = 0; // ModelData::materials içinde
+    bool hasNormals = true;         // dosyada normal vardı
+
+    MeshData() = default;
+    MeshData(const MeshData &other);
+    MeshData(MeshData &&other) noexcept;
+    MeshData &operator=(MeshData other) noexcept;
+
+    // New uninitialized arrays: in one heap block owned by the mesh, or in
+    // the arena (valid until it is destroyed)
+    void allocate(std::size_t vertexCount, std::size_t indexCount);
+    void allocate(ImportArena &arena, std::size_t vertexCount, std::size_t indexCount);
+    // Moves the arrays into one exact-size heap block, unless they already are
+    void detach();
+    std::size_t bytes() const { return vertices.size() * sizeof(Vertex) + indices.size() * sizeof(unsigned int); }
+
+private:
+    std::unique_ptr<unsigned char[]> storage;
+    bool owns() const;
+};
+
+#endif // MESHDATA_H
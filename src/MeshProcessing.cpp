@@ -0,0 +1,288 @@
+// MeshProcessing.cpp
+#include "MeshProcessing.h"
+#include "ImportArena.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace
+{
+    // Normal ve UV için sabit adımlar, ters olarak (birim vektör / doku koordinatı)
+    constexpr float NORMAL_SCALE = 1024.0f;
+    constexpr float UV_SCALE = 8192.0f;
+    constexpr std::size_t GRAIN = 8192;
+
+    template <std::size_t N>
+    using Key = std::array<std::int32_t, N>;
+
+    // scale = 1 / adım; 0 ise tolerans yok, bit eşitliği (+0 ile -0 aynı).
+    // floor / bölme yerine çarpma ve kesme: anahtar üretimi döngünün sıcak yeri
+    std::int32_t quantize(float v, float scale)
+    {
+        if (scale <= 0.0f)
+        {
+            if (v == 0.0f)
+                return 0;
+            std::int32_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            return bits;
+        }
+        const float q = v * scale;
+        if (!(q > -2.0e9f && q < 2.0e9f)) // NaN de buraya
+            return q > 0.0f ? std::numeric_limits<std::int32_t>::max() : std::numeric_limits<std::int32_t>::min();
+        return static_cast<std::int32_t>(q < 0.0f ? q - 0.5f : q + 0.5f);
+    }
+
+    template <std::size_t N>
+    std::uint64_t hashKey(const Key<N> &key)
+    {
+        std::uint64_t h = 0x9E3779B97F4A7C15ull;
+        for (std::int32_t v : key)
+        {
+            h ^= static_cast<std::uint32_t>(v);
+            h *= 0xFF51AFD7ED558CCDull;
+            h ^= h >> 32;
+        }
+        return h;
+    }
+
+    // first[i] = smallest j with keys[j] == keys[i]. Lock-free open
+    // addressing: a slot holds index + 1 and only ever moves to a smaller
+    // index with the same key, so the outcome is the same on every run.
+    template <std::size_t N>
+    std::uint32_t *groupEqual(const Key<N> *keys, std::size_t count, ImportArena &scratch)
+    {
+        std::size_t capacity = 16;
+        while (capacity < count * 2)
+            capacity <<= 1;
+        const std::size_t mask = capacity - 1;
+        std::atomic<std::uint32_t> *table = scratch.allocateArray<std::atomic<std::uint32_t>>(capacity);
+        std::uint32_t *first = scratch.allocateArray<std::uint32_t>(count);
+
+        JobSystem &jobs = JobSystem::get();
+        jobs.parallelFor(capacity, [&](std::size_t begin, std::size_t end)
+                         {
+            for (std::size_t slot = begin; slot < end; ++slot)
+                new (&table[slot]) std::atomic<std::uint32_t>(0); }, GRAIN);
+        jobs.parallelFor(count, [&](std::size_t begin, std::size_t end)
+                         {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const std::uint32_t mine = static_cast<std::uint32_t>(i) + 1;
+                std::size_t slot = hashKey(keys[i]) & mask;
+                for (;;)
+                {
+                    std::uint32_t held = table[slot].load(std::memory_order_acquire);
+                    if (held == 0 && table[slot].compare_exchange_strong(held, mine, std::memory_order_acq_rel))
+                        break;
+                    // held: yuvadaki (ya da CAS'ı kazanan) vertex
+                    if (keys[held - 1] == keys[i])
+                    {
+                        while (mine < held &&
+                               !table[slot].compare_exchange_weak(held, mine, std::memory_order_acq_rel))
+                        {
+                        }
+                        break;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+                first[i] = static_cast<std::uint32_t>(slot); // yuva; ikinci geçişte çözülür
+            } }, GRAIN);
+        jobs.parallelFor(count, [&](std::size_t begin, std::size_t end)
+                         {
+            for (std::size_t i = begin; i < end; ++i)
+                first[i] = table[first[i]].load(std::memory_order_relaxed) - 1; }, GRAIN);
+        return first;
+    }
+
+    // Kaynak ızgarasının adımının tersi; adım = tolerans x en büyük kenar
+    float positionScale(const ArrayView<Vertex> &vertices, float tolerance)
+    {
+        if (tolerance <= 0.0f || vertices.empty())
+            return 0.0f;
+        glm::vec3 lo(std::numeric_limits<float>::max()), hi(-std::numeric_limits<float>::max());
+        for (const Vertex &v : vertices)
+        {
+            lo = glm::min(lo, v.Position);
+            hi = glm::max(hi, v.Position);
+        }
+        const glm::vec3 size = hi - lo;
+        const float step = tolerance * std::max(size.x, std::max(size.y, size.z));
+        return step > 0.0f && std::isfinite(step) ? 1.0f / step : 0.0f;
+    }
+
+    glm::vec3 unitOr(const glm::vec3 &v, const glm::vec3 &fallback)
+    {
+        const float length = glm::length(v);
+        return length > 0.0f && std::isfinite(length) ? v / length : fallback;
+    }
+}
+
+std::size_t weldVertices(MeshData &mesh, float tolerance, ImportArena &scratch)
+{
+    const std::size_t count = mesh.vertices.size();
+    if (count < 2)
+        return 0;
+    JobSystem &jobs = JobSystem::get();
+    const Vertex *in = mesh.vertices.data();
+    const float scale = positionScale(mesh.vertices, tolerance);
+    const float normalScale = tolerance > 0.0f ? NORMAL_SCALE : 0.0f;
+    const float uvScale = tolerance > 0.0f ? UV_SCALE : 0.0f;
+
+    const std::uint32_t *first;
+    {
+        Key<8> *keys = scratch.allocateArray<Key<8>>(count);
+        jobs.parallelFor(count, [&](std::size_t begin, std::size_t end)
+                         {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const Vertex &v = in[i];
+                keys[i] = {quantize(v.Position.x, scale), quantize(v.Position.y, scale),
+                           quantize(v.Position.z, scale), quantize(v.Normal.x, normalScale),
+                           quantize(v.Normal.y, normalScale), quantize(v.Normal.z, normalScale),
+                           quantize(v.TexCoords.x, uvScale), quantize(v.TexCoords.y, uvScale)};
+            } }, GRAIN);
+        first = groupEqual(keys, count, scratch);
+    }
+
+    // Sıra korunur: temsilcinin yeni yeri, kendinden önceki temsilci sayısı
+    const std::size_t chunks = (count + GRAIN - 1) / GRAIN;
+    std::uint32_t *offsets = scratch.allocateArray<std::uint32_t>(chunks + 1);
+    offsets[0] = 0;
+    jobs.parallelFor(chunks, [&](std::size_t begin, std::size_t end)
+                     {
+        for (std::size_t c = begin; c < end; ++c)
+        {
+            std::uint32_t kept = 0;
+            for (std::size_t i = c * GRAIN, last = std::min(count, i + GRAIN); i < last; ++i)
+                kept += first[i] == i;
+            offsets[c + 1] = kept;
+        } }, 1);
+    for (std::size_t c = 0; c < chunks; ++c)
+        offsets[c + 1] += offsets[c];
+    const std::size_t kept = offsets[chunks];
+    if (kept == count)
+        return 0;
+
+    Vertex *welded = scratch.allocateArray<Vertex>(kept);
+    std::uint32_t *remap = scratch.allocateArray<std::uint32_t>(count); // sadece temsilciler için dolu
+    jobs.parallelFor(chunks, [&](std::size_t begin, std::size_t end)
+                     {
+        for (std::size_t c = begin; c < end; ++c)
+        {
+            std::uint32_t at = offsets[c];
+            for (std::size_t i = c * GRAIN, last = std::min(count, i + GRAIN); i < last; ++i)
+                if (first[i] == i)
+                {
+                    remap[i] = at;
+                    welded[at++] = in[i];
+                }
+        } }, 1);
+    unsigned int *indices = mesh.indices.data();
+    jobs.parallelFor(mesh.indices.size(), [&](std::size_t begin, std::size_t end)
+                     {
+        for (std::size_t k = begin; k < end; ++k)
+            indices[k] = remap[first[indices[k]]]; }, GRAIN);
+    mesh.vertices = ArrayView<Vertex>(welded, kept);
+    return count - kept;
+}
+
+bool generateNormals(MeshData &mesh, NormalMode mode, float creaseDegrees, float tolerance, ImportArena &scratch)
+{
+    if (mode == NormalMode::Keep || (mode == NormalMode::IfMissing && mesh.hasNormals))
+        return false;
+    if (mesh.indices.size() % 3 != 0)
+        return false; // çizgi / nokta: üçgen normali yok
+    const std::size_t triangles = mesh.indices.size() / 3;
+    const std::size_t corners = mesh.indices.size();
+    JobSystem &jobs = JobSystem::get();
+    const glm::vec3 up(0.0f, 1.0f, 0.0f);
+
+    // Köşe başına bir vertex: keskin kenarda aynı konumun iki normali olur
+    Vertex *out = scratch.allocateArray<Vertex>(corners);
+    glm::vec3 *area = scratch.allocateArray<glm::vec3>(triangles); // alanla ağırlıklı yüz normali
+    glm::vec3 *unit = scratch.allocateArray<glm::vec3>(triangles); // birim
+    const Vertex *in = mesh.vertices.data();
+    const unsigned int *indices = mesh.indices.data();
+    jobs.parallelFor(triangles, [&](std::size_t begin, std::size_t end)
+                     {
+        for (std::size_t t = begin; t < end; ++t)
+        {
+            const Vertex &a = in[indices[3 * t]], &b = in[indices[3 * t + 1]], &c = in[indices[3 * t + 2]];
+            out[3 * t] = a;
+            out[3 * t + 1] = b;
+            out[3 * t + 2] = c;
+            area[t] = glm::cross(b.Position - a.Position, c.Position - a.Position);
+            unit[t] = unitOr(area[t], glm::vec3(0.0f));
+        } }, GRAIN);
+
+    if (mode == NormalMode::Flat)
+    {
+        jobs.parallelFor(corners, [&](std::size_t begin, std::size_t end)
+                         {
+            for (std::size_t k = begin; k < end; ++k)
+                out[k].Normal = unitOr(unit[k / 3], up); }, GRAIN);
+    }
+    else
+    {
+        const std::uint32_t *first;
+        {
+            const float scale = positionScale(mesh.vertices, tolerance);
+            Key<3> *keys = scratch.allocateArray<Key<3>>(corners);
+            jobs.parallelFor(corners, [&](std::size_t begin, std::size_t end)
+                             {
+                for (std::size_t k = begin; k < end; ++k)
+                    keys[k] = {quantize(out[k].Position.x, scale), quantize(out[k].Position.y, scale),
+                               quantize(out[k].Position.z, scale)}; }, GRAIN);
+            first = groupEqual(keys, corners, scratch);
+        }
+
+        // Konum grubu -> köşeleri, artan sırada (toplama sırası sabit)
+        std::uint32_t *start = scratch.allocateArray<std::uint32_t>(corners + 1);
+        std::uint32_t *members = scratch.allocateArray<std::uint32_t>(corners);
+        std::fill(start, start + corners + 1, 0u);
+        for (std::size_t k = 0; k < corners; ++k)
+            ++start[first[k] + 1];
+        for (std::size_t k = 0; k < corners; ++k)
+            start[k + 1] += start[k];
+        {
+            std::uint32_t *fill = scratch.allocateArray<std::uint32_t>(corners);
+            std::copy(start, start + corners, fill);
+            for (std::size_t k = 0; k < corners; ++k)
+                members[fill[first[k]]++] = static_cast<std::uint32_t>(k);
+        }
+
+        const float cosCrease = std::cos(glm::radians(std::min(std::max(creaseDegrees, 0.0f), 180.0f)));
+        jobs.parallelFor(corners, [&](std::size_t begin, std::size_t end)
+                         {
+            for (std::size_t k = begin; k < end; ++k)
+            {
+                const glm::vec3 &own = unit[k / 3];
+                const bool degenerate = own == glm::vec3(0.0f); // açı testi anlamsız
+                glm::vec3 sum(0.0f);
+                const std::uint32_t group = first[k];
+                for (std::uint32_t m = start[group]; m < start[group + 1]; ++m)
+                {
+                    const std::size_t t = members[m] / 3;
+                    if (degenerate || glm::dot(own, unit[t]) >= cosCrease)
+                        sum += area[t];
+                }
+                out[k].Normal = unitOr(sum, unitOr(own, up));
+            } }, GRAIN);
+    }
+
+    mesh.vertices = ArrayView<Vertex>(out, corners);
+    unsigned int *rewrite = mesh.indices.data();
+    jobs.parallelFor(corners, [&](std::size_t begin, std::size_t end)
+                     {
+        for (std::size_t k = begin; k < end; ++k)
+            rewrite[k] = static_cast<unsigned int>(k); }, GRAIN);
+    mesh.hasNormals = true;
+    return true;
+}
@@ -0,0 +1,34 @@
+// MeshProcessing.h
+#ifndef MESHPROCESSING_H
+#define MESHPROCESSING_H
+
+#include <cstddef>
+#include "ImportArena.h"
+#include "ImportProfile.h"
+#include "MeshData.h"
+
+// Import post-processing stages over MeshData (Model::postProcess). Large
+// meshes are split with JobSystem::parallelFor (inline outside the job
+// system); the result does not depend on the thread count or timing.
+// Scratch arrays and the rewritten vertex array come from the scratch arena:
+// the mesh points into it afterwards, so detach() it before the arena goes.
+// Indices are rewritten in place.
+
+// Merges vertices whose quantized position, normal and UV are equal:
+// positions on a grid of tolerance x the mesh's largest extent, normals and
+// UVs on fixed fine steps; tolerance 0 merges bit-identical vertices only.
+// A grid cell keeps its first vertex as is and vertex order is otherwise
+// preserved. Values within a step of each other can fall into neighbouring
+// cells, so near-duplicates are usually, not always, merged. Returns the
+// number of vertices removed.
+std::size_t weldVertices(MeshData &mesh, float tolerance, ImportArena &scratch);
+
+// Writes new normals for Smooth and Flat, and for IfMissing when the file
+// had none (mesh.hasNormals). Smooth averages the area-weighted normals of
+// the triangles meeting at a position (same grid as weldVertices) that are
+// within creaseDegrees of the corner's own triangle, so hard edges stay
+// hard. The mesh is unwelded to one vertex per corner: weld afterwards.
+// Returns false if the mode left the normals alone.
+bool generateNormals(MeshData &mesh, NormalMode mode, float creaseDegrees, float tolerance, ImportArena &scratch);
+
+#endif // MESHPROCESSING_H
@@ -1,192 +1,469 @@
 // Model.cpp
 #include "Model.h"
+#include "GeometryKernels.h"
+#include "JobSystem.h"
+#include "MeshProcessing.h"
+#include "Profiler.h"
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
-#include <stb_image.h>
 #include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <limits>
 #include <stdexcept>                    // For error handling
 #include <glm/gtc/matrix_transform.hpp> // translate için
 
 Model::Model(const std::string &path)
+    : Model(import(path))
 {
-    loadModel(path);
+}
+
+Model::Model(ModelData &&data)
+    : bbMin(data.bbMin), bbMax(data.bbMax), transform(TransformSystem::get().create())
+{
+    PROFILE_SCOPE("Model upload");
+    // Materyaller mesh başına değil, import başına bir kez çözülür
+    std::vector<MaterialID> materials;
+    materials.reserve(data.materials.size());
+    for (const ImportedMaterial &imported : data.materials)
+        materials.push_back(createMaterial(imported));
+
+    std::vector<Mesh> uploaded;
+    uploaded.reserve(data.meshes.size());
+    for (MeshData &mesh : data.meshes)
+    {
+        MaterialID material = mesh.materialIndex < materials.size() ? materials[mesh.materialIndex]
+                                                                    : DEFAULT_MATERIAL;
+        uploaded.emplace_back(std::move(mesh), material);
+    }
+
+    // Aynı materyali kullanan mesh'ler art arda çizilsin (daha az state değişimi)
+    std::stable_sort(uploaded.begin(), uploaded.end(), [](const Mesh &a, const Mesh &b)
+                     { return a.material < b.material; });
+    meshes = std::make_shared<std::vector<Mesh>>(std::move(uploaded));
+    std::cout << "Successfully loaded model: " << data.path << " (" << meshes->size() << " meshes)" << std::endl;
+}
+
+Model Model::instance() const
+{
+    Model copy(*this);
+    copy.transform = TransformSystem::get().create();
+    copy.syncTransform();
+    return copy;
+}
+
+void Model::reload(ModelData &&data, ModelReloadStats &stats)
+{
+    PROFILE_SCOPE("Model reload");
+    std::vector<Mesh> &old = *meshes;
+    MaterialLibrary &library = MaterialLibrary::get();
+
+    // Materyaller: eski bir materyalle aynı adı taşıyan yerinde yeniden yazılır
+    std::vector<MaterialID> materials;
+    materials.reserve(data.materials.size());
+    for (const ImportedMaterial &imported : data.materials)
+    {
+        MaterialID id = DEFAULT_MATERIAL;
+        if (!imported.name.empty())
+        {
+            const std::uint32_t name = library.intern(imported.name);
+            for (const Mesh &mesh : old)
+            {
+                if (mesh.material != DEFAULT_MATERIAL && library[mesh.material].name == name &&
+                    std::find(materials.begin(), materials.end(), mesh.material) == materials.end())
+                {
+                    id = mesh.material;
+                    break;
+                }
+            }
+        }
+        if (id != DEFAULT_MATERIAL)
+        {
+            library.replace(id, buildMaterial(imported));
+            ++stats.materialsKept;
+        }
+        else
+        {
+            id = createMaterial(imported);
+            ++stats.materialsCreated;
+        }
+        materials.push_back(id);
+    }
+
+    // Yeni mesh'e eski bir mesh eşle: önce aynı içerik, sonra aynı boyutlar,
+    // sonra herhangi biri (GL nesneleri yeniden kullanılır, sadece veri gider)
+    std::vector<int> match(data.meshes.size(), -1);
+    std::vector<bool> taken(old.size(), false);
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        for (std::size_t i = 0; i < data.meshes.size(); ++i)
+        {
+            const MeshData &mesh = data.meshes[i];
+            for (std::size_t j = 0; j < old.size() && match[i] < 0; ++j)
+            {
+                if (taken[j])
+                    continue;
+                const MeshData &before = old[j].geometry;
+                const bool sameSize = mesh.vertices.size() == before.vertices.size() &&
+                                      mesh.indices.size() == before.indices.size();
+                bool fits = pass == 2 || (pass == 1 && sameSize);
+                if (pass == 0 && sameSize)
+                    fits = sameBytes(mesh.indices, before.indices) && sameBytes(mesh.vertices, before.vertices);
+                if (fits)
+                {
+                    match[i] = static_cast<int>(j);
+                    taken[j] = true;
+                }
+            }
+        }
+    }
+
+    std::vector<Mesh> uploaded;
+    uploaded.reserve(data.meshes.size());
+    for (std::size_t i = 0; i < data.meshes.size(); ++i)
+    {
+        MeshData &mesh = data.meshes[i];
+        MaterialID material = mesh.materialIndex < materials.size() ? materials[mesh.materialIndex]
+                                                                    : DEFAULT_MATERIAL;
+        if (match[i] < 0)
+        {
+            stats.uploadedBytes += mesh.vertices.size() * (sizeof(Vertex) + sizeof(glm::vec3)) +
+                                   mesh.indices.size() * sizeof(unsigned int);
+            uploaded.emplace_back(std::move(mesh), material);
+            ++stats.meshesCreated;
+            continue;
+        }
+        const std::size_t before = stats.uploadedBytes;
+        uploaded.push_back(Mesh::reuse(old[match[i]], std::move(mesh), material, stats.uploadedBytes));
+        ++(stats.uploadedBytes == before ? stats.meshesKept : stats.meshesUpdated);
+    }
+    for (std::size_t j = 0; j < old.size(); ++j)
+    {
+        if (!taken[j])
+        {
+            old[j].release();
+            ++stats.meshesReleased;
+        }
+    }
+
+    std::stable_sort(uploaded.begin(), uploaded.end(), [](const Mesh &a, const Mesh &b)
+                     { return a.material < b.material; });
+    meshes = std::make_shared<std::vector<Mesh>>(std::move(uploaded));
+    bbMin = data.bbMin;
+    bbMax = data.bbMax;
 }
 
 void Model::setPosition(const glm::vec3 &pos)
 {
     position = pos;
+    syncTransform();
 }
 
-void Model::draw(Shader &shader)
+void Model::setYaw(float radians)
 {
-    // 1) Model uzayından dünya uzayına dönüşüm
-    glm::mat4 modelMat = glm::translate(glm::mat4(1.0f), position);
-    modelMat = glm::scale(modelMat, glm::vec3(scale)); // <-- YENİ SATIR
+    yaw = radians;
+    syncTransform();
+}
 
-    // 2) Shader’a gönder
-    shader.setMat4("model", modelMat);
+void Model::syncTransform()
+{
+    // Matris burada değil, TransformSystem::update içinde (sadece değiştiyse) hesaplanır
+    TransformSystem::get().set(transform, position, yaw, scale);
+}
 
-    // 3) Tüm mesh’leri çiz
-    for (auto &mesh : meshes)
+void Model::draw(Shader &shader)
+{
+    // 1) Dünya matrisi transform buffer'ında hazır; sadece indeksini seç
+    TransformSystem::get().setDraw(transform, shader);
+
+    // 2) Tüm mesh’leri çiz
+    for (const Mesh &mesh : *meshes)
         mesh.draw(shader);
 }
 
-void Model::loadModel(const std::string &path)
+void Model::drawDepth(Shader &shader)
 {
-    Assimp::Importer importer;
-    const aiScene *scene = importer.ReadFile(
-        path,
-        aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
+    TransformSystem::get().setDraw(transform, shader);
+    for (const auto &mesh : *meshes)
+        mesh.drawDepth();
+}
+
+ModelData Model::import(const std::string &path, const ImportProfile &profile, ImportStats *stats)
+{
+    PROFILE_SCOPE("Model::import");
+    const auto start = std::chrono::steady_clock::now();
+    Assimp::Importer importer; // Importer örneği başına thread-safe
+    const aiScene *scene = importer.ReadFile(path, importFlags(profile));
 
     // Improved error handling
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
     {
         std::string error = "Assimp error: ";
         error += importer.GetErrorString();
-        std::cerr << error << std::endl;
         throw std::runtime_error(error);
     }
 
-    directory = path.substr(0, path.find_last_of('/'));
-    processNode(scene->mRootNode, scene);
-    std::cout << "Successfully loaded model: " << path << " (" << meshes.size() << " meshes)" << std::endl;
-    // yükleme tamam; AABB hesapla
-    bbMin = glm::vec3(std::numeric_limits<float>::max());
-    bbMax = -bbMin;
-    for (const auto &m : meshes)
-        for (const auto &v : m.vertices)
+    ModelData data;
+    data.path = path;
+    const std::string directory = path.substr(0, path.find_last_of('/'));
+    for (unsigned int i = 0; i < scene->mNumMaterials; ++i)
+        data.materials.push_back(importMaterial(scene->mMaterials[i], directory));
+
+    // Assimp çıktısının kopyası tek blokta; postProcess her mesh'e kendi
+    // bloğunu verdikten sonra bütünüyle bırakılır
+    ImportArena arena(parseArenaBytes(scene));
+    processNode(scene->mRootNode, scene, data, arena);
+    importer.FreeScene();
+    ImportStats local;
+    ImportStats &report = stats ? *stats : local;
+    report = ImportStats();
+    report.parseMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    report.parseArenaBytes = arena.reserved();
+    postProcess(data, profile, report);
+    computeBounds(data);
+    report.totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return data;
+}
+
+unsigned int Model::importFlags(const ImportProfile &profile)
+{
+    // Kaynak ve normal üretimi bizde (MeshProcessing); tanjantları tutacak yer yok
+    return aiProcess_Triangulate | (profile.flipUVs ? static_cast<unsigned int>(aiProcess_FlipUVs) : 0u);
+}
+
+std::size_t Model::parseArenaBytes(const aiScene *scene)
+{
+    // Mesh başına iki dizi, her biri en fazla bir hizalama boşluğuyla
+    std::size_t bytes = 0;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i)
+    {
+        const aiMesh *mesh = scene->mMeshes[i];
+        bytes += static_cast<std::size_t>(mesh->mNumVertices) * sizeof(Vertex) +
+                 static_cast<std::size_t>(mesh->mNumFaces) * 3 * sizeof(unsigned int) + 2 * alignof(Vertex);
+    }
+    return bytes;
+}
+
+// postProcess'in mesh işleri; küçük mesh'ler gruplanır
+static constexpr std::size_t MAX_MESH_JOBS = 256;
+
+// İşlem alanı tahmini (MeshProcessing'in dizileri); aşan kısım yeni bloğa gider
+static std::size_t scratchBytes(const MeshData &mesh, const ImportProfile &profile, bool newNormals)
+{
+    const std::size_t vertices = newNormals ? mesh.indices.size() : mesh.vertices.size();
+    std::size_t bytes = 4096;
+    if (newNormals)
+        bytes += mesh.indices.size() * 96;
+    if (profile.weld)
+        bytes += vertices * 96;
+    return bytes;
+}
+
+void Model::postProcess(ModelData &data, const ImportProfile &profile, ImportStats &stats)
+{
+    PROFILE_SCOPE("Model::postProcess");
+    using Clock = std::chrono::steady_clock;
+    JobSystem &jobs = JobSystem::get();
+    const std::size_t count = data.meshes.size();
+    for (const MeshData &mesh : data.meshes)
+        stats.verticesIn += mesh.vertices.size();
+
+    // Mesh'ler paralel, büyük mesh'in kendi aşamaları da (iç içe parallelFor).
+    // Her mesh kendi işlem alanını kullanır ve sonunda tek, tam boy bloğa taşınır.
+    // Binlerce alt mesh'li taramada iş sayısı MAX_MESH_JOBS ile sınırlı
+    const std::size_t grain = std::max<std::size_t>(1, (count + MAX_MESH_JOBS - 1) / MAX_MESH_JOBS);
+    std::vector<unsigned char> dropped(count, 0), generated(count, 0);
+    std::vector<double> normalsMs(count, 0.0), weldMs(count, 0.0);
+    std::vector<std::size_t> scratchUsed(count, 0);
+    jobs.parallelFor(count, [&](std::size_t begin, std::size_t end)
+                     {
+        for (std::size_t i = begin; i < end; ++i)
         {
-            bbMin = glm::min(bbMin, v.Position);
-            bbMax = glm::max(bbMax, v.Position);
-        }
+            MeshData &mesh = data.meshes[i];
+            bool drop = profile.texCoords == TexCoordMode::Drop;
+            if (profile.texCoords == TexCoordMode::Auto)
+            {
+                // Dokusuz materyal UV örneklemez; sıfır UV dikişleri birleştirir
+                const ImportedMaterial *material =
+                    mesh.materialIndex < data.materials.size() ? &data.materials[mesh.materialIndex] : nullptr;
+                drop = !material || (material->diffuseTexture.empty() && material->specularTexture.empty());
+            }
+            if (drop)
+            {
+                for (Vertex &v : mesh.vertices)
+                    v.TexCoords = glm::vec2(0.0f);
+                dropped[i] = 1;
+            }
+
+            const bool newNormals = profile.normals == NormalMode::Smooth || profile.normals == NormalMode::Flat ||
+                                    (profile.normals == NormalMode::IfMissing && !mesh.hasNormals);
+            ImportArena scratch(scratchBytes(mesh, profile, newNormals));
+            auto start = Clock::now();
+            generated[i] = generateNormals(mesh, profile.normals, profile.creaseAngle,
+                                           profile.weld ? profile.weldTolerance : 0.0f, scratch);
+            normalsMs[i] = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            if (profile.weld)
+            {
+                start = Clock::now();
+                weldVertices(mesh, profile.weldTolerance, scratch);
+                weldMs[i] = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            }
+            mesh.detach();
+            scratchUsed[i] = scratch.reserved();
+        } }, grain);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        stats.verticesOut += data.meshes[i].vertices.size();
+        stats.meshesWithNewNormals += generated[i];
+        stats.meshesWithoutTexCoords += dropped[i];
+        stats.normalsMs += normalsMs[i];
+        stats.weldMs += weldMs[i];
+        stats.scratchArenaBytes += scratchUsed[i];
+    }
 }
 
-void Model::processNode(aiNode *node, const aiScene *scene)
+// AABB, SoA kopya üzerinde SIMD
+void Model::computeBounds(ModelData &data)
+{
+    const GeometryKernels &kernels = geometryKernels();
+    float bbMin[3], bbMax[3];
+    std::fill(bbMin, bbMin + 3, std::numeric_limits<float>::max());
+    std::fill(bbMax, bbMax + 3, -std::numeric_limits<float>::max());
+    PositionStreams positions;
+    for (const auto &m : data.meshes)
+    {
+        positions.assign(m.vertices.data(), m.vertices.size());
+        kernels.minMax(positions.x.data(), positions.y.data(), positions.z.data(), positions.size(), bbMin, bbMax);
+    }
+    data.bbMin = glm::vec3(bbMin[0], bbMin[1], bbMin[2]);
+    data.bbMax = glm::vec3(bbMax[0], bbMax[1], bbMax[2]);
+}
+
+void Model::processNode(aiNode *node, const aiScene *scene, ModelData &data, ImportArena &arena)
 {
     // Bu düğüme ait tüm mesh'leri işle
     for (unsigned int i = 0; i < node->mNumMeshes; ++i)
     {
         aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
-        meshes.push_back(processMesh(mesh, scene));
+        data.meshes.push_back(processMesh(mesh, arena));
     }
     // Alt düğümleri dolaş
     for (unsigned int i = 0; i < node->mNumChildren; ++i)
     {
-        processNode(node->mChildren[i], scene);
+        processNode(node->mChildren[i], scene, data, arena);
     }
 }
 
-Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene)
+MeshData Model::processMesh(aiMesh *mesh, ImportArena &arena)
 {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-    std::vector<Texture> textures;
+    // Triangulate sonrası yüzler üçgen; çizgi / nokta karışıksa tek tek say
+    std::size_t indexCount = static_cast<std::size_t>(mesh->mNumFaces) * 3;
+    if (mesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE)
+    {
+        indexCount = 0;
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i)
+            indexCount += mesh->mFaces[i].mNumIndices;
+    }
+    MeshData data;
+    data.allocate(arena, mesh->mNumVertices, indexCount);
 
     // Vertex verisini oku
-    for (unsigned int i = 0; i < mesh->mNumVertices; ++i)
+    const aiVector3D *normals = mesh->HasNormals() ? mesh->mNormals : nullptr;
+    const aiVector3D *texCoords = mesh->mTextureCoords[0];
+    Vertex *vertex = data.vertices.data();
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i, ++vertex)
     {
-        Vertex vertex;
-        // Pozisyon
-        vertex.Position = {
-            mesh->mVertices[i].x,
-            mesh->mVertices[i].y,
-            mesh->mVertices[i].z};
-        // Normaller
-        vertex.Normal = mesh->HasNormals()
-                            ? glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z)
-                            : glm::vec3(0.0f);
-
-        // Tekstür koordinatları
-        if (mesh->mTextureCoords[0])
-        {
-            vertex.TexCoords = {
-                mesh->mTextureCoords[0][i].x,
-                mesh->mTextureCoords[0][i].y};
-        }
-        else
-        {
-            vertex.TexCoords = glm::vec2(0.0f);
-        }
-
-        vertices.push_back(vertex);
+        vertex->Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+        vertex->Normal = normals ? glm::vec3(normals[i].x, normals[i].y, normals[i].z) : glm::vec3(0.0f);
+        vertex->TexCoords = texCoords ? glm::vec2(texCoords[i].x, texCoords[i].y) : glm::vec2(0.0f);
     }
 
     // İndeks verisini oku
+    unsigned int *index = data.indices.data();
     for (unsigned int i = 0; i < mesh->mNumFaces; ++i)
     {
-        aiFace face = mesh->mFaces[i];
-        for (unsigned int j = 0; j < face.mNumIndices; ++j)
-        {
-            indices.push_back(face.mIndices[j]);
-        }
+        const aiFace &face = mesh->mFaces[i];
+        index = std::copy(face.mIndices, face.mIndices + face.mNumIndices, index);
     }
 
-    // Materyal ve texture’ları yükle
-    if (mesh->mMaterialIndex >= 0)
+    // Materyal GL tarafında çözülür; burada sadece aiScene indeksi
+    data.materialIndex = mesh->mMaterialIndex;
+    data.hasNormals = mesh->HasNormals();
+    return data;
+}
+
+ImportedMaterial Model::importMaterial(aiMaterial *mat, const std::string &directory)
+{
+    ImportedMaterial material;
+    material.diffuseTexture = materialTexture(mat, aiTextureType_DIFFUSE, directory);
+    material.specularTexture = materialTexture(mat, aiTextureType_SPECULAR, directory);
+
+    aiColor3D kd(1.0f, 1.0f, 1.0f);
+    if (mat->Get(AI_MATKEY_COLOR_DIFFUSE, kd) == aiReturn_SUCCESS)
     {
-        aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
-        // Sadece diffuse ve specular örneği
-        auto diffuseMaps = loadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse");
-        textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
-        auto specularMaps = loadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular");
-        textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
+        material.hasDiffuseColor = true;
+        material.diffuseColor = glm::vec3(kd.r, kd.g, kd.b);
     }
+    mat->Get(AI_MATKEY_SHININESS, material.shininess);
 
-    // Mesh nesnesini oluştur
-    return Mesh(vertices, indices, textures);
+    aiString name;
+    if (mat->Get(AI_MATKEY_NAME, name) == aiReturn_SUCCESS)
+        material.name = directory + "/" + name.C_Str();
+    return material;
 }
 
-std::vector<Texture> Model::loadMaterialTextures(aiMaterial *mat, aiTextureType type, const std::string &typeName)
+std::string Model::materialTexture(aiMaterial *mat, aiTextureType type, const std::string &directory)
 {
-    std::vector<Texture> textures;
-    for (unsigned int i = 0; i < mat->GetTextureCount(type); ++i)
-    {
-        aiString str;
-        mat->GetTexture(type, i, &str);
-        std::string filename = std::string(str.C_Str());
-        std::string fullPath = directory + "/" + filename;
-
-        Texture texture;
-        glGenTextures(1, &texture.id);
-        int width, height, nrComponents;
-        unsigned char *data = stbi_load(fullPath.c_str(), &width, &height, &nrComponents, 0);
-        if (data)
-        {
-            GLenum format = (nrComponents == 1 ? GL_RED : nrComponents == 3 ? GL_RGB
-                                                                            : GL_RGBA);
-            glBindTexture(GL_TEXTURE_2D, texture.id);
-            glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-            glGenerateMipmap(GL_TEXTURE_2D);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            stbi_image_free(data);
-        }
-        else
-        {
-            std::cerr << "Failed to load texture at path: " << fullPath << "\n";
-            stbi_image_free(data);
-        }
+    // Shader slot başına tek doku örnekler; ilki yeterli
+    if (mat->GetTextureCount(type) == 0)
+        return std::string();
+    aiString str;
+    mat->GetTexture(type, 0, &str);
+    return directory + "/" + str.C_Str();
+}
 
-        texture.type = typeName;
-        texture.path = fullPath;
-        textures.push_back(texture);
-    }
-    return textures;
+Material Model::buildMaterial(const ImportedMaterial &imported)
+{
+    MaterialLibrary &library = MaterialLibrary::get();
+    Material material;
+    if (!imported.diffuseTexture.empty())
+        material.textures[SLOT_DIFFUSE] = library.loadTexture(imported.diffuseTexture);
+    if (!imported.specularTexture.empty())
+        material.textures[SLOT_SPECULAR] = library.loadTexture(imported.specularTexture);
+    if (material.textures[SLOT_DIFFUSE])
+        material.permutation |= MAT_DIFFUSE_MAP;
+    if (material.textures[SLOT_SPECULAR])
+        material.permutation |= MAT_SPECULAR_MAP;
+
+    // Diffuse haritası yoksa MTL'deki Kd rengi kullanılır
+    if (!(material.permutation & MAT_DIFFUSE_MAP) && imported.hasDiffuseColor)
+        material.diffuseColor = imported.diffuseColor;
+    if (imported.shininess > 0.0f)
+        material.shininess = std::min(imported.shininess, 256.0f);
+
+    if (!imported.name.empty())
+        material.name = library.intern(imported.name);
+    return material;
+}
+
+MaterialID Model::createMaterial(const ImportedMaterial &imported)
+{
+    return MaterialLibrary::get().create(buildMaterial(imported));
 }
 
 const std::vector<Mesh> &Model::getMeshes() const
 {
-    return meshes;
+    return *meshes;
 }
 
 glm::mat4 Model::getTransformMatrix() const
 {
     glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
+    model = glm::rotate(model, yaw, glm::vec3(0.0f, 1.0f, 0.0f));
     model = glm::scale(model, glm::vec3(scale));   // <-- ölçek eklendi
     return model;
 }
@@ -194,9 +471,11 @@ glm::mat4 Model::getTransformMatrix() const
 void Model::autoGround(float desiredHeight)
 {
     position.y = desiredHeight - bbMin.y * scale; // tabanı y=desiredHeight’e yasla
+    syncTransform();
 }
 void Model::setUniformScale(float targetHeight)
 {
     float currentH = (bbMax.y - bbMin.y);
     scale = targetHeight / currentH;
+    syncTransform();
 }
@@ -1,37 +1,136 @@
 #ifndef MODEL_H
 #define MODEL_H
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <glm/glm.hpp>
+#include "ImportArena.h"
+#include "ImportProfile.h"
 #include "Mesh.h"
+#include "MeshData.h"
 #include "Shader.h"
+#include "Transform.h"
 #include <assimp/scene.h>
 
+// CPU-side result of an import: no GL or MaterialLibrary state is touched,
+// so several files can be imported in parallel jobs.
+struct ImportedMaterial
+{
+    std::string diffuseTexture;  // tam yol, yoksa boş
+    std::string specularTexture;
+    bool hasDiffuseColor = false;
+    glm::vec3 diffuseColor{1.0f};
+    float shininess = 0.0f;
+    std::string name;
+};
+
+struct ModelData
+{
+    std::string path;
+    std::vector<MeshData> meshes;
+    std::vector<ImportedMaterial> materials;
+    glm::vec3 bbMin{0.0f}, bbMax{0.0f};
+};
+
+// Per-model report of Model::import
+struct ImportStats
+{
+    std::size_t verticesIn = 0;  // Assimp'in verdiği
+    std::size_t verticesOut = 0; // son işlemden sonra
+    std::size_t meshesWithNewNormals = 0, meshesWithoutTexCoords = 0;
+    // normalsMs / weldMs: mesh başına sürelerin toplamı (mesh'ler paralel)
+    double parseMs = 0.0, normalsMs = 0.0, weldMs = 0.0, totalMs = 0.0;
+    // Geçici veri: Assimp çıktısının kopyası ve mesh başına işlem alanı (ImportArena)
+    std::size_t parseArenaBytes = 0, scratchArenaBytes = 0;
+};
+
+// What a hot reload sent to the GPU (Model::reload)
+struct ModelReloadStats
+{
+    std::size_t meshesKept = 0;    // GL buffers untouched
+    std::size_t meshesUpdated = 0; // same GL objects, some buffers re-uploaded
+    std::size_t meshesCreated = 0, meshesReleased = 0;
+    std::size_t materialsKept = 0, materialsCreated = 0;
+    std::size_t uploadedBytes = 0;
+};
+
 class Model
 {
 public:
     Model(const std::string &path);
+    // GL buffers and materials are created here: GL thread only
+    explicit Model(ModelData &&data);
+    // Thread-safe; throws std::runtime_error on failure. stats, if given,
+    // gets the vertex counts and stage times.
+    static ModelData import(const std::string &path, const ImportProfile &profile = ImportProfile(),
+                            ImportStats *stats = nullptr);
+
+    // Stages of import(), public so bench/ImportBench.cpp can time them alone.
+    // processNode/processMesh put the meshes in the arena, sized up front by
+    // parseArenaBytes; postProcess gives each mesh one exact-size block of
+    // its own (MeshData::detach), after which the arena can go.
+    static unsigned int importFlags(const ImportProfile &profile);
+    static std::size_t parseArenaBytes(const aiScene *scene);
+    // UV dropping, normal generation and welding (MeshProcessing.h); parallel
+    // unless called inside a JobSystem::InlineScope
+    static void postProcess(ModelData &data, const ImportProfile &profile, ImportStats &stats);
+    static void processNode(aiNode *node, const aiScene *scene, ModelData &data, ImportArena &arena);
+    static MeshData processMesh(aiMesh *mesh, ImportArena &arena);
+    static void computeBounds(ModelData &data);
+    static ImportedMaterial importMaterial(aiMaterial *mat, const std::string &directory);
+
+    // Same meshes (GL buffers, materials) under a new transform; placement,
+    // scale and yaw start as this model's
+    Model instance() const;
+
+    // Hot reload, GL thread: new meshes and materials from a fresh import.
+    // Meshes take over the GL objects of matching old ones and re-upload
+    // only changed buffers; materials with an old name keep their ID and are
+    // rewritten in place. Takes the new local bounds; placement (scale,
+    // grounding) is the caller's to redo. Other instances keep the old
+    // meshes and bounds until shareMeshes(*this). Textures the
+    // materials name must already be in MaterialLibrary (HotReload decodes
+    // new ones in its job), otherwise loadTexture reads them on this thread.
+    void reload(ModelData &&data, ModelReloadStats &stats);
+    void shareMeshes(const Model &other)
+    {
+        meshes = other.meshes;
+        bbMin = other.bbMin;
+        bbMax = other.bbMax;
+    }
+
     void draw(Shader &shader);
+    void drawDepth(Shader &shader);
     void setPosition(const glm::vec3 &pos);
+    void setYaw(float radians);
     const std::vector<Mesh> &getMeshes() const;
+    // Model-space AABB from import
+    void getLocalBounds(glm::vec3 &min, glm::vec3 &max) const
+    {
+        min = bbMin;
+        max = bbMax;
+    }
     void autoGround(float desiredHeight = 0.0f);
     void setUniformScale(float targetHeight);
     glm::mat4 getTransformMatrix() const;
 
 private:
     // Model verisi
-    std::vector<Mesh> meshes;
-    std::string directory;
+    std::shared_ptr<std::vector<Mesh>> meshes; // instance'lar paylaşır
     glm::vec3 position{0.0f};
     glm::vec3 bbMin, bbMax;
     float scale = 1.0f;
+    float yaw = 0.0f;
+    TransformHandle transform;
+
+    void syncTransform();
 
-    // Assimp işleme fonksiyonları
-    void loadModel(const std::string &path);
-    void processNode(aiNode *node, const aiScene *scene);
-    Mesh processMesh(aiMesh *mesh, const aiScene *scene);
-    std::vector<Texture> loadMaterialTextures(aiMaterial *mat, aiTextureType type, const std::string &typeName);
+    // Assimp işleme fonksiyonları (import, iş parçacığından bağımsız)
+    static std::string materialTexture(aiMaterial *mat, aiTextureType type, const std::string &directory);
+    // GL tarafı
+    static Material buildMaterial(const ImportedMaterial &imported);
+    static MaterialID createMaterial(const ImportedMaterial &imported);
 };
 
 #endif
@@ -0,0 +1,187 @@
+// MuseumGenerator.cpp
+#include "MuseumGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+
+namespace
+{
+    constexpr float ROOM_SIZE = 10.0f;
+    constexpr float WALL_HEIGHT = 3.0f;
+    constexpr float DOOR_WIDTH = 2.0f;
+    constexpr float DOOR_HEIGHT = 2.2f;
+    constexpr float EXHIBIT_MARGIN = 1.5f; // duvar ve kapılardan uzak
+    constexpr float MIN_SPACING = 1.2f;
+    constexpr int PLACEMENT_TRIES = 8;
+    constexpr float LIGHT_HEIGHT = 5.0f;
+    constexpr float EXTRA_DOOR_CHANCE = 0.25f;
+
+    // mt19937'nin çıktısı standartta sabit, std:: dağılımlarınınki değil:
+    // dönüşümler elle yapılır ki aynı seed her platformda aynı müzeyi versin
+    struct Random
+    {
+        std::mt19937 engine;
+        explicit Random(std::uint32_t seed) : engine(seed) {}
+        float uniform(float lo, float hi)
+        {
+            return lo + (hi - lo) * static_cast<float>(engine() >> 8) * (1.0f / 16777216.0f);
+        }
+        std::uint32_t index(std::uint32_t n) { return static_cast<std::uint32_t>(engine() % n); }
+    };
+
+    // Ortasında isteğe bağlı kapı: iki yan parça + lento
+    void addWall(SceneDesc &desc, glm::vec2 from, glm::vec2 to, bool twoSided, bool door)
+    {
+        if (!door)
+        {
+            desc.walls.push_back({from, to, 0.0f, WALL_HEIGHT, twoSided});
+            return;
+        }
+        const glm::vec2 dir = glm::normalize(to - from);
+        const glm::vec2 mid = (from + to) * 0.5f;
+        const glm::vec2 a = mid - dir * (DOOR_WIDTH * 0.5f), b = mid + dir * (DOOR_WIDTH * 0.5f);
+        desc.walls.push_back({from, a, 0.0f, WALL_HEIGHT, twoSided});
+        desc.walls.push_back({b, to, 0.0f, WALL_HEIGHT, twoSided});
+        desc.walls.push_back({a, b, DOOR_HEIGHT, WALL_HEIGHT, twoSided});
+    }
+}
+
+SceneDesc generateMuseum(const MuseumParams &params, const std::vector<ModelDesc> &models)
+{
+    const int rooms = std::max(params.rooms, 1);
+    const int cols = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(rooms))));
+    const int rows = (rooms + cols - 1) / cols;
+    Random random(params.seed);
+
+    SceneDesc desc;
+    desc.name = "Generated museum";
+    desc.metadata.emplace_back("seed", std::to_string(params.seed));
+    desc.models = models;
+
+    // Oda i: ızgarada (i % cols, i / cols), ızgara orijinde ortalanır
+    std::vector<glm::vec2> roomMin(rooms);
+    for (int i = 0; i < rooms; ++i)
+    {
+        roomMin[i] = glm::vec2((static_cast<float>(i % cols) - cols * 0.5f) * ROOM_SIZE,
+                               (static_cast<float>(i / cols) - rows * 0.5f) * ROOM_SIZE);
+        desc.floors.push_back({roomMin[i], roomMin[i] + glm::vec2(ROOM_SIZE)});
+    }
+    // Komşu yanları: 0 kuzey (-z), 1 doğu (+x), 2 güney (+z), 3 batı (-x)
+    auto neighbour = [&](int room, int side)
+    {
+        const int col = room % cols;
+        switch (side)
+        {
+        case 0: return room >= cols ? room - cols : -1;
+        case 1: return col + 1 < cols && room + 1 < rooms ? room + 1 : -1;
+        case 2: return room + cols < rooms ? room + cols : -1;
+        default: return col > 0 ? room - 1 : -1;
+        }
+    };
+
+    // Rastgele DFS yayılım ağacı: her oda erişilebilir; ziyaret sırası tur sırası olur
+    std::vector<std::uint8_t> doors(static_cast<std::size_t>(rooms) * 4, 0); // oda * 4 + yan
+    std::vector<std::uint8_t> visited(rooms, 0);
+    std::vector<int> order, stack{0};
+    visited[0] = 1;
+    order.push_back(0);
+    while (!stack.empty())
+    {
+        const int room = stack.back();
+        int candidates[4], count = 0;
+        for (int side = 0; side < 4; ++side)
+        {
+            const int next = neighbour(room, side);
+            if (next >= 0 && !visited[next])
+                candidates[count++] = side;
+        }
+        if (count == 0)
+        {
+            stack.pop_back();
+            continue;
+        }
+        const int side = candidates[random.index(static_cast<std::uint32_t>(count))];
+        const int next = neighbour(room, side);
+        doors[room * 4 + side] = doors[next * 4 + (side + 2) % 4] = 1;
+        visited[next] = 1;
+        order.push_back(next);
+        stack.push_back(next);
+    }
+    // Birkaç ek kapı: tek yollu bir labirent olmasın
+    for (int room = 0; room < rooms; ++room)
+        for (int side = 1; side <= 2; ++side)
+        {
+            const int next = neighbour(room, side);
+            if (next >= 0 && random.uniform(0.0f, 1.0f) < EXTRA_DOOR_CHANCE)
+                doors[room * 4 + side] = doors[next * 4 + (side + 2) % 4] = 1;
+        }
+
+    // Dış duvarlar içe bakar; ortak duvarlar (doğu/güney sahibi) iki yüzlü
+    for (int room = 0; room < rooms; ++room)
+    {
+        const glm::vec2 lo = roomMin[room], hi = lo + glm::vec2(ROOM_SIZE);
+        const glm::vec2 corners[4] = {{lo.x, lo.y}, {hi.x, lo.y}, {hi.x, hi.y}, {lo.x, hi.y}};
+        for (int side = 0; side < 4; ++side)
+        {
+            const int next = neighbour(room, side);
+            if (next >= 0 && (side == 0 || side == 3))
+                continue; // komşu odanın güney / doğu duvarı
+            addWall(desc, corners[(side + 1) % 4], corners[side], next >= 0, doors[room * 4 + side] != 0);
+        }
+    }
+
+    // Eserler: rastgele oda ve konum, aynı odadakilerle arada boşluk bırakılarak
+    struct Placement
+    {
+        int room;
+        ExhibitDesc exhibit;
+    };
+    std::vector<Placement> placements;
+    placements.reserve(std::max(params.exhibits, 0));
+    std::vector<std::vector<glm::vec2>> taken(rooms);
+    const std::uint32_t modelCount = static_cast<std::uint32_t>(desc.models.size());
+    for (int i = 0; modelCount > 0 && i < params.exhibits; ++i)
+    {
+        Placement p;
+        p.room = static_cast<int>(random.index(static_cast<std::uint32_t>(rooms)));
+        const glm::vec2 lo = roomMin[p.room] + glm::vec2(EXHIBIT_MARGIN);
+        const glm::vec2 hi = roomMin[p.room] + glm::vec2(ROOM_SIZE - EXHIBIT_MARGIN);
+        for (int attempt = 0; attempt < PLACEMENT_TRIES; ++attempt)
+        {
+            p.exhibit.position = glm::vec2(random.uniform(lo.x, hi.x), random.uniform(lo.y, hi.y));
+            const bool crowded = std::any_of(taken[p.room].begin(), taken[p.room].end(), [&](const glm::vec2 &other)
+                                             { return glm::distance(other, p.exhibit.position) < MIN_SPACING; });
+            if (!crowded)
+                break; // yer bulunamazsa son deneme kalır: yoğun odalar üst üste binebilir
+        }
+        p.exhibit.model = random.index(modelCount);
+        p.exhibit.yaw = random.uniform(0.0f, 6.2831853f);
+        p.exhibit.height = random.uniform(1.2f, 2.2f);
+        taken[p.room].push_back(p.exhibit.position);
+        placements.push_back(p);
+    }
+    std::vector<int> rank(rooms);
+    for (int i = 0; i < rooms; ++i)
+        rank[order[i]] = i;
+    std::stable_sort(placements.begin(), placements.end(),
+                     [&](const Placement &a, const Placement &b) { return rank[a.room] < rank[b.room]; });
+    for (const Placement &p : placements)
+        desc.exhibits.push_back(p.exhibit);
+
+    // Işıklar: önce eserlerin üstüne, artanlar odalara sırayla dağıtılır
+    for (int i = 0; i < params.lights; ++i)
+    {
+        glm::vec2 at;
+        if (i < static_cast<int>(desc.exhibits.size()))
+            at = desc.exhibits[i].position;
+        else
+        {
+            const glm::vec2 lo = roomMin[order[i % rooms]];
+            at = glm::vec2(random.uniform(lo.x + 1.0f, lo.x + ROOM_SIZE - 1.0f),
+                           random.uniform(lo.y + 1.0f, lo.y + ROOM_SIZE - 1.0f));
+        }
+        desc.lights.push_back(ceilingSpot(glm::vec3(at.x, LIGHT_HEIGHT, at.y)));
+    }
+    return desc;
+}
@@ -0,0 +1,24 @@
+// MuseumGenerator.h
+#ifndef MUSEUMGENERATOR_H
+#define MUSEUMGENERATOR_H
+
+#include <cstdint>
+#include "SceneDesc.h"
+
+struct MuseumParams
+{
+    std::uint32_t seed = 1;
+    int rooms = 16;
+    int exhibits = 200;
+    int lights = 64;
+};
+
+// Procedural museum for scale tests: 10x10 m rooms on a grid, connected by
+// doorways along a random spanning tree (plus a few extra loops), exhibits
+// drawn from the given models with random yaw and height, and
+// ceiling spots above exhibits first, then anywhere in the rooms. Exhibits
+// are ordered room by room so the robot tour walks through the doorways.
+// The same seed gives the same museum on every platform.
+SceneDesc generateMuseum(const MuseumParams &params, const std::vector<ModelDesc> &models);
+
+#endif // MUSEUMGENERATOR_H
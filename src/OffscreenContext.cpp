@@ -0,0 +1,58 @@
+// OffscreenContext.cpp
+#include "OffscreenContext.h"
+#include <GLFW/glfw3.h>
+
+namespace
+{
+    std::string lastGlfwError;
+    void glfwError(int /*code*/, const char *description)
+    {
+        lastGlfwError = description;
+    }
+
+    GLFWwindow *tryCreate(int width, int height)
+    {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        return glfwCreateWindow(width, height, "offscreen", nullptr, nullptr);
+    }
+}
+
+// Pencere sistemi olmadan bağlam: EGL surfaceless, OSMesa, en son gizli pencere
+GLFWwindow *createOffscreenContext(int width, int height, const char *&backend, std::string &error)
+{
+    glfwSetErrorCallback(glfwError);
+#if defined(GLFW_PLATFORM_NULL)
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    if (glfwInit())
+    {
+        const struct
+        {
+            int api;
+            const char *name;
+        } apis[] = {{GLFW_EGL_CONTEXT_API, "EGL surfaceless"}, {GLFW_OSMESA_CONTEXT_API, "OSMesa"}};
+        for (const auto &api : apis)
+        {
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, api.api);
+            if (GLFWwindow *window = tryCreate(width, height))
+            {
+                backend = api.name;
+                return window;
+            }
+        }
+        glfwTerminate();
+    }
+    glfwInitHint(GLFW_PLATFORM, GLFW_ANY_PLATFORM);
+#endif
+    GLFWwindow *window = nullptr;
+    if (glfwInit())
+    {
+        backend = "hidden window";
+        window = tryCreate(width, height);
+    }
+    if (!window)
+        error = lastGlfwError;
+    return window;
+}
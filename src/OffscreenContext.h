@@ -0,0 +1,16 @@
+// OffscreenContext.h
+#ifndef OFFSCREENCONTEXT_H
+#define OFFSCREENCONTEXT_H
+
+#include <string>
+
+struct GLFWwindow;
+
+// GL 3.3 core context without a window system where GLFW allows it (3.4 null
+// platform: EGL surfaceless, then OSMesa), otherwise a hidden window. Calls
+// glfwInit itself; the caller makes the context current and calls
+// glfwTerminate. On failure returns nullptr with the last GLFW error in error.
+// Used by the benchmarks so they run on GPU-less CI under llvmpipe.
+GLFWwindow *createOffscreenContext(int width, int height, const char *&backend, std::string &error);
+
+#endif // OFFSCREENCONTEXT_H
@@ -0,0 +1,620 @@
+// PackPatch.cpp
+#include "PackPatch.h"
+#include "AssetPack.h"
+#include "Lz4.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    constexpr char MAGIC[4] = {'V', 'M', 'P', 'D'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::uint32_t ENDIAN_TAG = 0x01020304;
+
+    // İçerik tanımlı parçalar: 2 KB - 64 KB, ortalama ~10 KB
+    constexpr std::size_t MIN_CHUNK = 2048;
+    constexpr std::size_t MAX_CHUNK = 65536;
+    constexpr int CHUNK_BITS = 13;
+
+    constexpr std::size_t READ_SIZE = 65536; // applyPackPatch okuma parçası
+
+    enum PatchOp : unsigned char
+    {
+        OP_END = 0,
+        OP_COPY = 1,     // u64 eski ofset, u32 boy
+        OP_DATA = 2,     // u32 boy, baytlar
+        OP_DATA_LZ4 = 3, // u32 açılmış boy (<= MAX_CHUNK), u32 sıkışık boy, baytlar
+        OP_ZERO = 4      // u32 boy
+    };
+
+    struct PatchHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t reserved;
+        std::uint64_t oldSize, oldHash;
+        std::uint64_t newSize, newHash;
+    };
+
+    constexpr std::uint64_t FNV_OFFSET = 1469598103934665603ull;
+
+    std::uint64_t fnv1a(std::uint64_t hash, const unsigned char *bytes, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::uint64_t fileHash(const unsigned char *bytes, std::size_t size)
+    {
+        FileHash hash;
+        hash.update(bytes, size);
+        return hash.digest();
+    }
+
+    // Gear tablosu: splitmix64 ile sabit tohumdan, her platformda aynı
+    const std::uint64_t *gearTable()
+    {
+        static const auto table = []
+        {
+            struct Table
+            {
+                std::uint64_t values[256];
+            } t;
+            std::uint64_t state = 0x9E3779B97F4A7C15ull;
+            for (std::uint64_t &v : t.values)
+            {
+                std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                v = z ^ (z >> 31);
+            }
+            return t;
+        }();
+        return table.values;
+    }
+
+    // Sonraki parça sınırı; kayan gear özeti üst CHUNK_BITS biti sıfır olunca keser
+    std::size_t nextChunk(const unsigned char *data, std::size_t size)
+    {
+        if (size <= MIN_CHUNK)
+            return size;
+        const std::uint64_t *gear = gearTable();
+        const std::size_t limit = std::min(size, MAX_CHUNK);
+        std::uint64_t h = 0;
+        for (std::size_t i = MIN_CHUNK; i < limit; ++i)
+        {
+            h = (h << 1) + gear[data[i]];
+            if ((h >> (64 - CHUNK_BITS)) == 0)
+                return i + 1;
+        }
+        return limit;
+    }
+
+    std::uint64_t chunkKey(const unsigned char *data, std::size_t size)
+    {
+        return fnv1a(FNV_OFFSET, data, size) ^ (static_cast<std::uint64_t>(size) << 47);
+    }
+
+    // Op akışını yazar; bitişik kopyaları birleştirir, literal'leri LZ4 dener
+    class OpWriter
+    {
+    public:
+        OpWriter(std::ofstream &out, PatchStats &stats) : out(out), stats(stats) {}
+
+        void copy(std::uint64_t offset, std::uint64_t length)
+        {
+            stats.copiedBytes += length;
+            while (length)
+            {
+                if (!copyLength || copyOffset + copyLength != offset || copyLength == UINT32_MAX)
+                {
+                    flushCopy();
+                    copyOffset = offset;
+                }
+                const std::uint64_t add = std::min<std::uint64_t>(length, UINT32_MAX - copyLength);
+                copyLength += add;
+                offset += add;
+                length -= add;
+            }
+        }
+
+        void literal(const unsigned char *data, std::size_t size)
+        {
+            flushCopy();
+            stats.literalBytes += size;
+            while (size)
+            {
+                const std::size_t piece = std::min(size, MAX_CHUNK);
+                packed.resize(lz4CompressBound(piece));
+                const std::size_t stored = lz4Compress(data, piece, packed.data(), packed.size());
+                if (stored && stored <= piece - piece / 8)
+                {
+                    put(OP_DATA_LZ4);
+                    put(static_cast<std::uint32_t>(piece));
+                    put(static_cast<std::uint32_t>(stored));
+                    out.write(reinterpret_cast<const char *>(packed.data()), static_cast<std::streamsize>(stored));
+                }
+                else
+                {
+                    put(OP_DATA);
+                    put(static_cast<std::uint32_t>(piece));
+                    out.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(piece));
+                }
+                data += piece;
+                size -= piece;
+            }
+        }
+
+        // Sıfır dolgu (sayfa hizası) yazılmaz, boyu yeter; sondaki sıfır olmayan kısım literal
+        void region(const unsigned char *data, std::size_t size)
+        {
+            std::size_t used = size;
+            while (used && data[used - 1] == 0)
+                --used;
+            if (used)
+                literal(data, used);
+            std::uint64_t zeros = size - used;
+            if (zeros)
+                flushCopy();
+            while (zeros)
+            {
+                const std::uint32_t piece = static_cast<std::uint32_t>(std::min<std::uint64_t>(zeros, UINT32_MAX));
+                put(OP_ZERO);
+                put(piece);
+                zeros -= piece;
+            }
+        }
+
+        void end()
+        {
+            flushCopy();
+            put(OP_END);
+        }
+
+    private:
+        std::ofstream &out;
+        PatchStats &stats;
+        std::uint64_t copyOffset = 0, copyLength = 0;
+        std::vector<unsigned char> packed;
+
+        template <typename T>
+        void put(T value)
+        {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+        }
+
+        void flushCopy()
+        {
+            if (!copyLength)
+                return;
+            put(OP_COPY);
+            put(copyOffset);
+            put(static_cast<std::uint32_t>(copyLength));
+            copyLength = 0;
+        }
+    };
+
+    std::size_t argSize(unsigned char op)
+    {
+        switch (op)
+        {
+        case OP_COPY:
+            return 12;
+        case OP_DATA:
+        case OP_ZERO:
+            return 4;
+        case OP_DATA_LZ4:
+            return 8;
+        default:
+            return 0;
+        }
+    }
+}
+
+// ---------- Dosya özeti --------------------------------------------------
+
+void FileHash::update(const unsigned char *bytes, std::size_t size)
+{
+    total += size;
+    while (size && tailSize)
+    {
+        tail[tailSize++] = *bytes++;
+        --size;
+        if (tailSize == sizeof(tail))
+        {
+            word(tail);
+            tailSize = 0;
+        }
+    }
+    if (tailSize)
+        return; // parça kelimeyi tamamlamadı; kuyruk duruyor
+    for (; size >= sizeof(tail); bytes += sizeof(tail), size -= sizeof(tail))
+        word(bytes);
+    if (size)
+        std::memcpy(tail, bytes, size);
+    tailSize = size;
+}
+
+std::uint64_t FileHash::digest() const
+{
+    unsigned char last[8] = {};
+    std::memcpy(last, tail, tailSize);
+    std::uint64_t w;
+    std::memcpy(&w, last, sizeof(w));
+    std::uint64_t h = (state ^ w ^ total) * 0x9E3779B97F4A7C15ull;
+    return h ^ (h >> 29);
+}
+
+// Kelime başına bir çarpma: bayt bayt FNV'den birkaç kat hızlı
+void FileHash::word(const unsigned char *bytes)
+{
+    std::uint64_t w;
+    std::memcpy(&w, bytes, sizeof(w));
+    state = (state ^ w) * 0x9E3779B97F4A7C15ull;
+    state ^= state >> 32;
+}
+
+// ---------- Yama üretimi --------------------------------------------------
+
+bool createPackPatch(const std::string &oldPath, const std::string &newPath, const std::string &patchPath,
+                     PatchStats &stats, std::string &error)
+{
+    stats = PatchStats();
+    AssetPack oldPack, newPack;
+    if (!oldPack.mount(oldPath, error) || !newPack.mount(newPath, error))
+        return false;
+    const unsigned char *oldData = oldPack.data();
+    const unsigned char *newData = newPack.data();
+
+    // Eski paket: TOC özetine göre yükler ve tüm yüklerin parçaları
+    std::unordered_multimap<std::uint64_t, const PackEntry *> oldPayloads;
+    std::unordered_multimap<std::uint64_t, std::uint64_t> oldChunks; // anahtar -> ofset
+    std::unordered_set<std::uint64_t> seen;
+    for (std::size_t i = 0; i < oldPack.entryCount(); ++i)
+    {
+        const PackEntry &e = oldPack.entry(i);
+        // Boş yük bir sonraki yükle aynı ofseti paylaşır: ofset tekil değil
+        if (e.storedSize == 0 || !seen.insert(e.offset).second)
+            continue; // tekilleştirilmiş yük
+        oldPayloads.emplace(e.hash, &e);
+        for (std::uint64_t at = 0; at < e.storedSize;)
+        {
+            const std::size_t size = nextChunk(oldData + e.offset + at, static_cast<std::size_t>(e.storedSize - at));
+            oldChunks.emplace(chunkKey(oldData + e.offset + at, size), e.offset + at);
+            at += size;
+        }
+    }
+
+    // Yeni paketin tekil yükleri, dosyadaki sırayla (boşların yazılacak baytı yok)
+    std::vector<const PackEntry *> payloads;
+    for (std::size_t i = 0; i < newPack.entryCount(); ++i)
+        if (newPack.entry(i).storedSize > 0)
+            payloads.push_back(&newPack.entry(i));
+    std::sort(payloads.begin(), payloads.end(), [](const PackEntry *a, const PackEntry *b)
+              { return a->offset < b->offset; });
+    payloads.erase(std::unique(payloads.begin(), payloads.end(), [](const PackEntry *a, const PackEntry *b)
+                               { return a->offset == b->offset; }),
+                   payloads.end());
+
+    std::ofstream out(patchPath, std::ios::binary | std::ios::trunc);
+    PatchHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = ENDIAN_TAG;
+    header.reserved = 0;
+    header.oldSize = oldPack.fileSize();
+    header.oldHash = fileHash(oldData, oldPack.fileSize());
+    header.newSize = newPack.fileSize();
+    header.newHash = fileHash(newData, newPack.fileSize());
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    OpWriter ops(out, stats);
+    std::uint64_t cursor = 0;
+    for (const PackEntry *e : payloads)
+    {
+        // Başlık, TOC, adlar ve hiza dolgusu
+        ops.region(newData + cursor, static_cast<std::size_t>(e->offset - cursor));
+        const unsigned char *bytes = newData + e->offset;
+        cursor = e->offset + e->storedSize;
+
+        // 1) Aynı özet ve aynı baytlarla eski pakette duran yük: tek kopya
+        const PackEntry *same = nullptr;
+        auto range = oldPayloads.equal_range(e->hash);
+        for (auto it = range.first; it != range.second && !same; ++it)
+        {
+            const PackEntry *o = it->second;
+            if (o->storedSize == e->storedSize && o->codec == e->codec &&
+                std::memcmp(oldData + o->offset, bytes, static_cast<std::size_t>(e->storedSize)) == 0)
+                same = o;
+        }
+        if (same)
+        {
+            ops.copy(same->offset, e->storedSize);
+            ++stats.payloadsReused;
+            continue;
+        }
+
+        // 2) Değişmiş yük: parçalar eski pakette aranır (kaymış olsalar da)
+        ++stats.payloadsChunked;
+        for (std::uint64_t at = 0; at < e->storedSize;)
+        {
+            const unsigned char *chunk = bytes + at;
+            const std::size_t size = nextChunk(chunk, static_cast<std::size_t>(e->storedSize - at));
+            std::uint64_t from = UINT64_MAX;
+            auto candidates = oldChunks.equal_range(chunkKey(chunk, size));
+            for (auto it = candidates.first; it != candidates.second && from == UINT64_MAX; ++it)
+                if (std::memcmp(oldData + it->second, chunk, size) == 0)
+                    from = it->second;
+            ++stats.chunks;
+            if (from != UINT64_MAX)
+            {
+                ops.copy(from, size);
+                ++stats.chunksReused;
+            }
+            else
+                ops.literal(chunk, size);
+            at += size;
+        }
+    }
+    ops.region(newData + cursor, static_cast<std::size_t>(newPack.fileSize() - cursor));
+    ops.end();
+
+    stats.oldSize = oldPack.fileSize();
+    stats.newSize = newPack.fileSize();
+    stats.patchSize = static_cast<std::uint64_t>(out.tellp());
+    if (!out.flush())
+    {
+        error = "cannot write " + patchPath;
+        return false;
+    }
+    return true;
+}
+
+// ---------- Yama uygulama -------------------------------------------------
+
+PackPatcher::~PackPatcher()
+{
+    abort();
+}
+
+bool PackPatcher::begin(const std::string &path, std::string &error)
+{
+    abort();
+    if (!old.open(path, error))
+        return false;
+    packPath = path;
+    stagingPath = path + ".staging";
+    out.open(stagingPath, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return fail(error, "cannot create " + stagingPath);
+    state = State::Header;
+    pending.clear();
+    pending.reserve(lz4CompressBound(MAX_CHUNK));
+    pendingNeed = sizeof(PatchHeader);
+    written = 0;
+    hash = FileHash();
+    return true;
+}
+
+bool PackPatcher::feed(const unsigned char *data, std::size_t size, std::string &error)
+{
+    while (size)
+    {
+        switch (state)
+        {
+        case State::Literal:
+        {
+            const std::size_t take = static_cast<std::size_t>(std::min<std::uint64_t>(size, remaining));
+            if (!emit(data, take, error))
+                return false;
+            data += take;
+            size -= take;
+            remaining -= take;
+            if (!remaining)
+            {
+                state = State::OpCode;
+                pendingNeed = 1;
+            }
+            break;
+        }
+        case State::Done:
+            return fail(error, "data after the end of the patch");
+        case State::Idle:
+            error = "patch not started, failed or already finished";
+            return false;
+        default:
+        {
+            // Başlık, op kodu, argümanlar, sıkışık parça: pendingNeed bayt biriktir
+            const std::size_t take = std::min(size, pendingNeed - pending.size());
+            pending.insert(pending.end(), data, data + take);
+            data += take;
+            size -= take;
+            if (pending.size() < pendingNeed)
+                break;
+            bool ok = true;
+            if (state == State::Header)
+                ok = handleHeader(error);
+            else if (state == State::OpCode)
+            {
+                op = pending[0];
+                if (op == OP_END)
+                    state = State::Done;
+                else if (argSize(op) == 0)
+                    return fail(error, "unknown op " + std::to_string(op));
+                else
+                {
+                    state = State::OpArgs;
+                    pendingNeed = argSize(op);
+                }
+            }
+            else if (state == State::OpArgs)
+                ok = handleArgs(error);
+            else
+            {
+                decoded.resize(rawLength);
+                if (!lz4Decompress(pending.data(), pending.size(), decoded.data(), rawLength))
+                    return fail(error, "corrupt compressed data");
+                ok = emit(decoded.data(), rawLength, error);
+                state = State::OpCode;
+                pendingNeed = 1;
+            }
+            if (!ok)
+                return false;
+            pending.clear();
+            break;
+        }
+        }
+    }
+    return true;
+}
+
+bool PackPatcher::handleHeader(std::string &error)
+{
+    PatchHeader header;
+    std::memcpy(&header, pending.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        return fail(error, "not a pack patch");
+    if (header.byteOrder != ENDIAN_TAG)
+        return fail(error, "patch made for another byte order");
+    if (header.version != VERSION)
+        return fail(error, "patch version " + std::to_string(header.version));
+    // Kopyalar eski paketten okunur: tam olarak yamanın yapıldığı paket olmalı
+    if (header.oldSize != old.size() || header.oldHash != fileHash(old.data(), old.size()))
+        return fail(error, packPath + " is not the pack this patch was made from");
+    newSize = header.newSize;
+    newHash = header.newHash;
+    state = State::OpCode;
+    pendingNeed = 1;
+    return true;
+}
+
+bool PackPatcher::handleArgs(std::string &error)
+{
+    std::uint32_t length;
+    if (op == OP_COPY)
+    {
+        std::uint64_t offset;
+        std::memcpy(&offset, pending.data(), sizeof(offset));
+        std::memcpy(&length, pending.data() + 8, sizeof(length));
+        if (offset > old.size() || old.size() - offset < length)
+            return fail(error, "copy outside the old pack");
+        if (!emit(old.data() + offset, length, error))
+            return false;
+        state = State::OpCode;
+        pendingNeed = 1;
+        return true;
+    }
+
+    std::memcpy(&length, pending.data(), sizeof(length));
+    if (op == OP_DATA)
+    {
+        remaining = length;
+        state = length ? State::Literal : State::OpCode;
+        pendingNeed = 1;
+    }
+    else if (op == OP_DATA_LZ4)
+    {
+        std::uint32_t stored;
+        std::memcpy(&stored, pending.data() + 4, sizeof(stored));
+        if (length > MAX_CHUNK || stored == 0 || stored > lz4CompressBound(MAX_CHUNK))
+            return fail(error, "compressed chunk too large");
+        rawLength = length;
+        state = State::Compressed;
+        pendingNeed = stored;
+    }
+    else
+    {
+        static const unsigned char zeros[PACK_ALIGNMENT] = {};
+        for (std::uint32_t left = length; left;)
+        {
+            const std::uint32_t piece = std::min<std::uint32_t>(left, sizeof(zeros));
+            if (!emit(zeros, piece, error))
+                return false;
+            left -= piece;
+        }
+        state = State::OpCode;
+        pendingNeed = 1;
+    }
+    return true;
+}
+
+bool PackPatcher::emit(const unsigned char *data, std::size_t size, std::string &error)
+{
+    if (newSize - written < size)
+        return fail(error, "patch writes past the end of the new pack");
+    out.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+    hash.update(data, size);
+    written += size;
+    return true;
+}
+
+bool PackPatcher::finish(std::string &error)
+{
+    if (state != State::Done)
+        return fail(error, "patch incomplete (truncated?)");
+    if (written != newSize || hash.digest() != newHash)
+        return fail(error, "patched pack does not match the expected hash");
+    out.close();
+    if (!out)
+        return fail(error, "cannot write " + stagingPath);
+    old.close(); // Windows eşlenmiş dosyanın üstüne taşımaya izin vermez
+    std::error_code ec;
+    std::filesystem::rename(stagingPath, packPath, ec);
+    if (ec)
+        return fail(error, "cannot replace " + packPath + ": " + ec.message());
+    stagingPath.clear();
+    state = State::Idle; // yeni bir begin() gerekir
+    return true;
+}
+
+void PackPatcher::abort()
+{
+    if (out.is_open())
+        out.close();
+    if (!stagingPath.empty())
+    {
+        std::error_code ec;
+        std::filesystem::remove(stagingPath, ec);
+        stagingPath.clear();
+    }
+    old.close();
+    state = State::Idle;
+    pending.clear();
+}
+
+bool PackPatcher::fail(std::string &error, const std::string &message)
+{
+    error = message;
+    abort();
+    return false;
+}
+
+bool applyPackPatch(const std::string &packPath, const std::string &patchPath, std::string &error)
+{
+    std::ifstream in(patchPath, std::ios::binary);
+    if (!in)
+    {
+        error = "cannot open " + patchPath;
+        return false;
+    }
+    PackPatcher patcher;
+    if (!patcher.begin(packPath, error))
+        return false;
+    std::vector<unsigned char> buffer(READ_SIZE);
+    while (in)
+    {
+        in.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        const std::size_t got = static_cast<std::size_t>(in.gcount());
+        if (got && !patcher.feed(buffer.data(), got, error))
+            return false;
+    }
+    return patcher.finish(error);
+}
@@ -0,0 +1,104 @@
+// PackPatch.h
+#ifndef PACKPATCH_H
+#define PACKPATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+// Delta update from one cooked pack (AssetPack.h) to the next (.vmpatch).
+//
+// The patch rebuilds the new pack front to back from a stream of ops:
+// copy a range of the old pack, literal bytes (LZ4 when it pays), zero
+// padding. Payloads whose TOC hash and stored bytes are unchanged become a
+// single copy. Changed payloads are split with content-defined chunking,
+// so bytes that merely moved are still found in the old pack. The header
+// carries size and hash of both packs: a patch only applies to the
+// pack it was made from, and the result is checked before it replaces it.
+
+struct PatchStats
+{
+    std::uint64_t oldSize = 0, newSize = 0, patchSize = 0;
+    std::uint64_t copiedBytes = 0;  // new pack bytes taken from the old one
+    std::uint64_t literalBytes = 0; // new pack bytes carried in the patch
+    std::size_t payloadsReused = 0, payloadsChunked = 0;
+    std::size_t chunks = 0, chunksReused = 0;
+};
+
+bool createPackPatch(const std::string &oldPack, const std::string &newPack, const std::string &patchPath,
+                     PatchStats &stats, std::string &error);
+
+// Whole-file hash in the patch header, fed as bytes arrive. Multiplies
+// 8-byte words; catches corruption, not deliberate collisions.
+class FileHash
+{
+public:
+    void update(const unsigned char *bytes, std::size_t size);
+    std::uint64_t digest() const;
+
+private:
+    std::uint64_t state = 1469598103934665603ull, total = 0;
+    unsigned char tail[8] = {};
+    std::size_t tailSize = 0;
+    void word(const unsigned char *bytes);
+};
+
+// Applies a patch as it arrives (download, file read) in pieces of any
+// size. The result goes to <pack>.staging and is renamed over the pack only
+// after its size and hash match, so an interrupted or corrupt update leaves
+// the old pack in place. Memory stays bounded by one compressed chunk
+// whatever the pack or patch size; old pack bytes are read from a map.
+// A process may keep the old pack mounted meanwhile on POSIX (the rename
+// swaps the directory entry); Windows refuses to replace a mapped file.
+class PackPatcher
+{
+public:
+    ~PackPatcher();
+
+    bool begin(const std::string &packPath, std::string &error);
+    bool feed(const unsigned char *data, std::size_t size, std::string &error);
+    bool finish(std::string &error);
+    // Drops the staging file; the pack is untouched
+    void abort();
+
+    std::uint64_t bytesWritten() const { return written; }
+
+private:
+    enum class State
+    {
+        Header,
+        OpCode,
+        OpArgs,
+        Literal,
+        Compressed,
+        Done,
+        Idle // begin() öncesi, hata ya da finish() sonrası
+    };
+
+    std::string packPath, stagingPath;
+    MappedFile old;
+    std::ofstream out;
+    State state = State::Idle;
+    std::vector<unsigned char> pending; // başlık, op argümanları ya da sıkıştırılmış parça
+    std::vector<unsigned char> decoded;
+    std::size_t pendingNeed = 0;
+    unsigned char op = 0;
+    std::uint64_t remaining = 0; // Literal: kalan bayt
+    std::uint32_t rawLength = 0; // Compressed: açılmış boy
+    std::uint64_t newSize = 0, newHash = 0;
+    std::uint64_t written = 0;
+    FileHash hash;
+
+    bool handleHeader(std::string &error);
+    bool handleArgs(std::string &error);
+    bool emit(const unsigned char *data, std::size_t size, std::string &error);
+    bool fail(std::string &error, const std::string &message);
+};
+
+// Streams the patch file through a PackPatcher in fixed-size reads
+bool applyPackPatch(const std::string &packPath, const std::string &patchPath, std::string &error);
+
+#endif // PACKPATCH_H
@@ -0,0 +1,145 @@
+// PerfHud.cpp
+#include "PerfHud.h"
+#include "AllocCounter.h"
+#include "ProcessMemory.h"
+#include <imgui.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    constexpr double RSS_INTERVAL = 0.5; // saniye; /proc okuması her frame gereksiz
+
+    double seconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    float megabytes(long long bytes)
+    {
+        return static_cast<float>(bytes) / (1024.0f * 1024.0f);
+    }
+}
+
+PerfHud::PerfHud(const RenderStats *s) : stats(s)
+{
+}
+
+PerfHud::~PerfHud()
+{
+    setVisible(false);
+}
+
+void PerfHud::setVisible(bool visible)
+{
+    if (visible == shown)
+        return;
+    shown = visible;
+    if (shown)
+    {
+        AllocCounter::enable(); // --alloc-check de açık tutabilir: referans sayılı
+        lastAllocs = AllocCounter::count();
+        head = count = 0;
+        nextRssTime = 0.0;
+    }
+    else
+    {
+        AllocCounter::disable();
+    }
+}
+
+void PerfHud::updatePercentiles(Series &series) const
+{
+    float sorted[WINDOW];
+    // Halka dolana kadar sadece yazılmış örnekler
+    const int first = count < WINDOW ? 0 : head;
+    for (int i = 0; i < count; ++i)
+        sorted[i] = series.values[(first + i) % WINDOW];
+    std::sort(sorted, sorted + count);
+    auto percentile = [&](float p) { return sorted[static_cast<int>(p * static_cast<float>(count - 1) + 0.5f)]; };
+    series.p50 = percentile(0.50f);
+    series.p95 = percentile(0.95f);
+    series.p99 = percentile(0.99f);
+}
+
+void PerfHud::update()
+{
+    if (!shown)
+        return;
+
+    // Render thread işi ana thread'le paralel: darboğaz olan thread CPU süresidir
+    float gpuMs = stats->frameGpuMs;
+    for (int i = 0; i < stats->gpuPassCount; ++i)
+    {
+        if (std::strcmp(stats->gpuPasses[i].name, "Frame") == 0)
+            gpuMs = stats->gpuPasses[i].lastMs; // ImGui dahil
+    }
+    frame.values[head] = stats->frameMs;
+    cpu.values[head] = std::max(stats->mainThreadMs, stats->renderThreadMs);
+    gpu.values[head] = gpuMs;
+    head = (head + 1) % WINDOW;
+    count = std::min(count + 1, WINDOW);
+    updatePercentiles(frame);
+    updatePercentiles(cpu);
+    updatePercentiles(gpu);
+
+    unsigned long long allocs = AllocCounter::count();
+    allocsPerFrame = allocs >= lastAllocs ? allocs - lastAllocs : allocs; // başkası sıfırladıysa
+    lastAllocs = allocs;
+
+    double now = seconds();
+    if (now >= nextRssTime)
+    {
+        rss = ProcessMemory::residentBytes();
+        nextRssTime = now + RSS_INTERVAL;
+    }
+}
+
+void PerfHud::plot(const char *label, const Series &series, float scaleMax) const
+{
+    char overlay[64];
+    std::snprintf(overlay, sizeof(overlay), "p50 %.2f  p95 %.2f  p99 %.2f", series.p50, series.p95, series.p99);
+    ImGui::Text("%-5s %6.2f ms", label, series.values[(head + WINDOW - 1) % WINDOW]);
+    ImGui::PushID(label);
+    ImGui::PlotLines("", series.values, WINDOW, head, overlay, 0.0f, scaleMax, ImVec2(300.0f, 48.0f));
+    ImGui::PopID();
+}
+
+void PerfHud::draw()
+{
+    if (!shown)
+        return;
+
+    const ImGuiViewport *viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x - 10.0f, viewport->WorkPos.y + 10.0f),
+                            ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowBgAlpha(0.6f);
+    const ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+                                   ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing |
+                                   ImGuiWindowFlags_NoNav;
+    if (!ImGui::Begin("Performance", nullptr, flags))
+    {
+        ImGui::End();
+        return;
+    }
+
+    // Üç grafik aynı ölçekte: en az 60 Hz bütçesi
+    const float scaleMax = std::max({16.7f, frame.p99, cpu.p99, gpu.p99}) * 1.25f;
+    ImGui::Text("%.0f fps  (F3 hides)", frame.p50 > 0.0f ? 1000.0f / frame.p50 : 0.0f);
+    plot("Frame", frame, scaleMax);
+    plot("CPU", cpu, scaleMax);
+    plot("GPU", gpu, scaleMax);
+    ImGui::Separator();
+
+    ImGui::Text("Draw calls %u, triangles %llu, state changes %u", stats->drawCalls, stats->triangles,
+                stats->stateChanges);
+    ImGui::Text("Models visible %u, culled %u", stats->visibleModels, stats->totalModels - stats->visibleModels);
+    ImGui::Text("VRAM ~%.1f MB (textures %.1f, buffers %.1f)", megabytes(stats->textureBytes + stats->bufferBytes),
+                megabytes(stats->textureBytes), megabytes(stats->bufferBytes));
+    if (rss)
+        ImGui::Text("RSS %.1f MB", megabytes(static_cast<long long>(rss)));
+    ImGui::Text("Allocations/frame %llu", allocsPerFrame);
+    ImGui::End();
+}
@@ -0,0 +1,53 @@
+// PerfHud.h
+#ifndef PERFHUD_H
+#define PERFHUD_H
+
+#include <cstddef>
+#include "RenderSettings.h"
+
+// On-site performance overlay (F3 or --hud): frame/CPU/GPU time graphs with
+// rolling p50/p95/p99, draw calls, triangles, state changes, culling, VRAM
+// estimate, RSS and allocations per frame. While hidden update() and draw()
+// return at once and allocation counting is off; the render-side counters
+// (RenderCounters) are plain increments that run either way.
+class PerfHud
+{
+public:
+    explicit PerfHud(const RenderStats *stats);
+    ~PerfHud();
+    PerfHud(const PerfHud &) = delete;
+    PerfHud &operator=(const PerfHud &) = delete;
+
+    void setVisible(bool visible);
+    void toggle() { setVisible(!shown); }
+    bool visible() const { return shown; }
+
+    // Main thread, once per rendered frame; then draw() inside the ImGui frame
+    void update();
+    void draw();
+
+private:
+    static constexpr int WINDOW = 240; // ~4 s at 60 Hz
+
+    struct Series
+    {
+        float values[WINDOW] = {0};
+        float p50 = 0.0f, p95 = 0.0f, p99 = 0.0f;
+    };
+
+    const RenderStats *stats;
+    bool shown = false;
+
+    Series frame, cpu, gpu;
+    int head = 0, count = 0;
+
+    unsigned long long lastAllocs = 0;
+    unsigned long long allocsPerFrame = 0;
+    std::size_t rss = 0;
+    double nextRssTime = 0.0;
+
+    void updatePercentiles(Series &series) const;
+    void plot(const char *label, const Series &series, float scaleMax) const;
+};
+
+#endif // PERFHUD_H
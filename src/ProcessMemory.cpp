@@ -0,0 +1,96 @@
+// ProcessMemory.cpp
+#include "ProcessMemory.h"
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#elif defined(__linux__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace ProcessMemory
+{
+    std::size_t residentBytes()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.WorkingSetSize;
+        return 0;
+#elif defined(__APPLE__)
+        mach_task_basic_info info;
+        mach_msg_type_number_t size = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &size) ==
+            KERN_SUCCESS)
+            return info.resident_size;
+        return 0;
+#elif defined(__linux__)
+        std::FILE *f = std::fopen("/proc/self/statm", "r");
+        if (!f)
+            return 0;
+        unsigned long pages = 0, resident = 0;
+        int read = std::fscanf(f, "%lu %lu", &pages, &resident);
+        std::fclose(f);
+        return read == 2 ? static_cast<std::size_t>(resident) * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+        return 0;
+#endif
+    }
+
+    std::size_t peakResidentBytes()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.PeakWorkingSetSize;
+        return 0;
+#else
+#if defined(__linux__)
+        // VmHWM: resetPeak sıfırlar (getrusage'ın maxrss'i sıfırlanmaz)
+        if (std::FILE *f = std::fopen("/proc/self/status", "r"))
+        {
+            char line[256];
+            unsigned long kb = 0;
+            bool found = false;
+            while (!found && std::fgets(line, sizeof(line), f))
+                found = std::strncmp(line, "VmHWM:", 6) == 0 && std::sscanf(line + 6, "%lu", &kb) == 1;
+            std::fclose(f);
+            if (found)
+                return static_cast<std::size_t>(kb) * 1024;
+        }
+#endif
+#if defined(__APPLE__) || defined(__linux__)
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+#if defined(__APPLE__)
+        return static_cast<std::size_t>(usage.ru_maxrss); // bayt
+#else
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024; // KB
+#endif
+#else
+        return 0;
+#endif
+#endif
+    }
+
+    bool resetPeak()
+    {
+#if defined(__linux__)
+        std::FILE *f = std::fopen("/proc/self/clear_refs", "w");
+        if (!f)
+            return false;
+        const bool written = std::fputs("5", f) >= 0;
+        return std::fclose(f) == 0 && written;
+#else
+        return false;
+#endif
+    }
+}
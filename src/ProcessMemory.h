@@ -0,0 +1,18 @@
+// ProcessMemory.h
+#ifndef PROCESSMEMORY_H
+#define PROCESSMEMORY_H
+
+#include <cstddef>
+
+// Resident memory of this process (Linux, Windows, macOS); 0 elsewhere
+namespace ProcessMemory
+{
+    std::size_t residentBytes();
+    // High-water mark since process start, or since resetPeak()
+    std::size_t peakResidentBytes();
+    // Starts a new high-water mark at the current resident size; Linux only
+    // (/proc/self/clear_refs), false where the peak cannot be reset
+    bool resetPeak();
+}
+
+#endif // PROCESSMEMORY_H
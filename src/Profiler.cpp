@@ -0,0 +1,172 @@
+// Profiler.cpp
+#include "Profiler.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+namespace
+{
+    thread_local Profiler::ThreadBuffer *currentBuffer = nullptr;
+
+    // İsimler sabit metin; yine de JSON için kaçış
+    void writeString(std::FILE *f, const char *s)
+    {
+        std::fputc('"', f);
+        for (; *s; ++s)
+        {
+            if (*s == '"' || *s == '\\')
+                std::fputc('\\', f);
+            std::fputc(*s, f);
+        }
+        std::fputc('"', f);
+    }
+}
+
+Profiler &Profiler::get()
+{
+    static Profiler instance;
+    return instance;
+}
+
+std::uint64_t Profiler::now()
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+}
+
+Profiler::ThreadBuffer &Profiler::threadBuffer()
+{
+    if (!currentBuffer)
+        currentBuffer = &get().registerThread(nullptr);
+    return *currentBuffer;
+}
+
+Profiler::ThreadBuffer &Profiler::createTrack(const char *name)
+{
+    return registerThread(name);
+}
+
+Profiler::ThreadBuffer &Profiler::registerThread(const char *name)
+{
+    std::lock_guard<std::mutex> lock(captureMutex);
+    threads.emplace_back(new ThreadBuffer());
+    ThreadBuffer &buffer = *threads.back();
+    buffer.id = static_cast<unsigned int>(threads.size());
+    if (name)
+        std::snprintf(buffer.name, sizeof(buffer.name), "%s", name);
+    else
+        std::snprintf(buffer.name, sizeof(buffer.name), "Thread %u", buffer.id);
+    return buffer;
+}
+
+void Profiler::setThreadName(const char *name)
+{
+    std::snprintf(threadBuffer().name, sizeof(ThreadBuffer::name), "%s", name);
+}
+
+void Profiler::startCapture(const std::string &path, int frames)
+{
+    std::lock_guard<std::mutex> lock(captureMutex);
+    if (active.load())
+        return;
+    // Önceki yakalamadan kalanlar atılır
+    for (auto &buffer : threads)
+    {
+        buffer->read.store(buffer->written.load(std::memory_order_acquire), std::memory_order_release);
+        buffer->dropped.store(0);
+    }
+    capturePath = path;
+    framesLeft = frames;
+    captureStart = now();
+    active.store(true);
+}
+
+void Profiler::stopCapture()
+{
+    std::lock_guard<std::mutex> lock(captureMutex);
+    if (!active.load())
+        return;
+    active.store(false);
+    writeTrace();
+}
+
+void Profiler::frameBoundary()
+{
+    if (!capturing())
+        return;
+    threadBuffer().push({"Frame", now(), 0, static_cast<double>(frameIndex), ProfileEvent::Type::Frame});
+    ++frameIndex;
+    if (framesLeft > 0 && --framesLeft == 0)
+        stopCapture();
+}
+
+void Profiler::counter(const char *name, double value)
+{
+    if (capturing())
+        threadBuffer().push({name, now(), 0, value, ProfileEvent::Type::Counter});
+}
+
+void Profiler::writeTrace()
+{
+    std::FILE *f = std::fopen(capturePath.c_str(), "w");
+    if (!f)
+    {
+        std::cerr << "Profiler: cannot write " << capturePath << "\n";
+        return;
+    }
+
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    unsigned long long written = 0, dropped = 0;
+    bool first = true;
+    auto separator = [&] {
+        if (!first)
+            std::fputs(",\n", f);
+        first = false;
+    };
+    for (auto &buffer : threads)
+    {
+        separator();
+        std::fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", buffer->id);
+        writeString(f, buffer->name);
+        std::fputs("}}", f);
+
+        const std::uint64_t end = buffer->written.load(std::memory_order_acquire);
+        for (std::uint64_t i = buffer->read.load(std::memory_order_relaxed); i < end; ++i)
+        {
+            const ProfileEvent &e = buffer->events[i & (ThreadBuffer::CAPACITY - 1)];
+            if (e.start + e.duration < captureStart)
+                continue; // yakalama başlamadan biten kapsam
+            // Chrome trace mikrosaniye bekler
+            const double ts = (static_cast<double>(e.start) - static_cast<double>(captureStart)) * 1e-3;
+            separator();
+            std::fputs("{\"name\":", f);
+            writeString(f, e.name);
+            switch (e.type)
+            {
+            case ProfileEvent::Type::Scope:
+                std::fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", buffer->id, ts,
+                             static_cast<double>(e.duration) * 1e-3);
+                break;
+            case ProfileEvent::Type::Counter:
+                std::fprintf(f, ",\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"value\":%g}}", buffer->id,
+                             ts, e.value);
+                break;
+            case ProfileEvent::Type::Frame:
+                std::fprintf(f, ",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"frame\":%.0f}}",
+                             buffer->id, ts, e.value);
+                break;
+            }
+            ++written;
+        }
+        buffer->read.store(end, std::memory_order_release);
+        dropped += buffer->dropped.load();
+    }
+    std::fputs("\n]}\n", f);
+    std::fclose(f);
+
+    std::cout << "Profiler: " << written << " events";
+    if (dropped)
+        std::cout << " (" << dropped << " dropped, ring full)";
+    std::cout << " written to " << capturePath << std::endl;
+}
@@ -0,0 +1,142 @@
+// Profiler.h
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scoped CPU markers written to per-thread lock-free rings, exported as a
+// Chrome trace (chrome://tracing, ui.perfetto.dev). Markers cost one relaxed
+// load when no capture runs (not measurable in bench/ProfilerBench.cpp);
+// while capturing two clock reads and a ring write, ~65 ns on an x86-64 VM
+// where one steady_clock read is ~28 ns. Build with VM_PROFILER=0 to
+// compile them out entirely.
+//
+//   PROFILE_SCOPE("Scene::draw");   // nested scopes nest in the trace
+//   PROFILE_FUNCTION();
+//   PROFILE_COUNTER("Visible models", n);
+//   PROFILE_FRAME();                // frame boundary, main thread
+//   PROFILE_THREAD("Render");       // names the calling thread
+#ifndef VM_PROFILER
+#define VM_PROFILER 1
+#endif
+
+struct ProfileEvent
+{
+    enum class Type : std::uint8_t
+    {
+        Scope,
+        Counter,
+        Frame
+    };
+    const char *name; // string literal: sadece işaretçi saklanır
+    std::uint64_t start;
+    std::uint64_t duration;
+    double value;
+    Type type;
+};
+
+class Profiler
+{
+public:
+    static Profiler &get();
+
+    // frames > 0: stops by itself after that many PROFILE_FRAME()s, else at
+    // stopCapture(). Events are written to path when the capture stops.
+    void startCapture(const std::string &path, int frames = 0);
+    void stopCapture();
+    bool capturing() const { return active.load(std::memory_order_relaxed); }
+
+    void frameBoundary();
+    void counter(const char *name, double value);
+    void setThreadName(const char *name);
+
+    static std::uint64_t now(); // ns
+
+    // Per-thread single-producer ring; the exporter is the only reader.
+    // Event storage is allocated on the thread's first recorded event.
+    struct ThreadBuffer
+    {
+        static constexpr std::uint64_t CAPACITY = 1 << 16;
+        std::unique_ptr<ProfileEvent[]> events;
+        std::atomic<std::uint64_t> written{0};
+        std::atomic<std::uint64_t> read{0};
+        std::atomic<std::uint64_t> dropped{0};
+        unsigned int id = 0;
+        char name[32] = {0};
+
+        void push(const ProfileEvent &e)
+        {
+            if (!events)
+                events.reset(new ProfileEvent[CAPACITY]);
+            std::uint64_t w = written.load(std::memory_order_relaxed);
+            if (w - read.load(std::memory_order_acquire) >= CAPACITY)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            events[w & (CAPACITY - 1)] = e;
+            written.store(w + 1, std::memory_order_release);
+        }
+    };
+    static ThreadBuffer &threadBuffer();
+    // Extra timeline not tied to a CPU thread (GPU passes); the caller is
+    // its single producer and pushes events already in now() time.
+    ThreadBuffer &createTrack(const char *name);
+
+private:
+    Profiler() = default;
+
+    std::atomic<bool> active{false};
+    std::mutex captureMutex; // start/stop ve thread kaydı
+    std::vector<std::unique_ptr<ThreadBuffer>> threads;
+    std::string capturePath;
+    int framesLeft = 0;
+    unsigned long long frameIndex = 0;
+    std::uint64_t captureStart = 0;
+
+    ThreadBuffer &registerThread(const char *name);
+    void writeTrace();
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char *name)
+        : name(name), start(Profiler::get().capturing() ? Profiler::now() : 0)
+    {
+    }
+    ~ProfileScope()
+    {
+        if (start)
+            Profiler::threadBuffer().push({name, start, Profiler::now() - start, 0.0, ProfileEvent::Type::Scope});
+    }
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    const char *name;
+    std::uint64_t start;
+};
+
+#if VM_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __COUNTER__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#define PROFILE_COUNTER(name, value) Profiler::get().counter(name, static_cast<double>(value))
+#define PROFILE_FRAME() Profiler::get().frameBoundary()
+#define PROFILE_THREAD(name) Profiler::get().setThreadName(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_COUNTER(name, value) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,192 @@
+// RenderBench.cpp
+#include "RenderBench.h"
+#include "Transform.h"
+#include "Lights.h"
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    constexpr int WARMUP_FRAMES = 5;
+    constexpr int TIMED_FRAMES = 20;
+
+    // Eşik: ortalama fark ve piksellerin %99.9'u için en büyük fark (0-255 ölçeği)
+    constexpr double MAX_MEAN_DIFF = 0.5;
+    constexpr int MAX_P999_DIFF = 4;
+
+    struct Target
+    {
+        unsigned int fbo = 0, color = 0, depth = 0;
+        int width = 0, height = 0;
+
+        Target(int w, int h) : width(w), height(h)
+        {
+            glGenFramebuffers(1, &fbo);
+            glGenRenderbuffers(1, &color);
+            glGenRenderbuffers(1, &depth);
+            glBindRenderbuffer(GL_RENDERBUFFER, color);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+            glBindRenderbuffer(GL_RENDERBUFFER, depth);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
+            glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        }
+        ~Target()
+        {
+            glDeleteFramebuffers(1, &fbo);
+            glDeleteRenderbuffers(1, &color);
+            glDeleteRenderbuffers(1, &depth);
+        }
+    };
+
+    // Sahne üzerinde ızgara halinde, aşağı bakan spot ışıkları
+    std::vector<SpotLight> makeLights(int count, const glm::vec3 &center, float radius)
+    {
+        std::vector<SpotLight> lights;
+        int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+        for (int i = 0; i < count; ++i)
+        {
+            float fx = side > 1 ? (i % side) / float(side - 1) - 0.5f : 0.0f;
+            float fz = side > 1 ? (i / side) / float(side - 1) - 0.5f : 0.0f;
+            SpotLight light;
+            light.position = center + glm::vec3(fx * 1.6f * radius, radius, fz * 1.6f * radius);
+            light.direction = glm::normalize(glm::vec3(-fx, -1.0f, -fz));
+            light.cutOff = glm::cos(glm::radians(20.0f));
+            light.outerCutOff = glm::cos(glm::radians(28.0f));
+            light.ambient = glm::vec3(0.05f);
+            light.diffuse = glm::vec3(0.6f);
+            light.specular = glm::vec3(0.5f);
+            light.constant = 1.0f;
+            light.linear = 0.09f;
+            light.quadratic = 0.032f;
+            lights.push_back(light);
+        }
+        return lights;
+    }
+
+    // Blocking ölçüm: benchmark'ta boru hattını boşaltmak sorun değil.
+    // Renderer kendi GL_TIME_ELAPSED sorgularını kullandığından burada timestamp.
+    double timeFrames(Renderer &renderer, Scene &scene, Robot &robot, const FrameView &frame)
+    {
+        for (int i = 0; i < WARMUP_FRAMES; ++i)
+            renderer.render(scene, robot, frame);
+        glFinish();
+
+        unsigned int queries[2];
+        glGenQueries(2, queries);
+        glQueryCounter(queries[0], GL_TIMESTAMP);
+        for (int i = 0; i < TIMED_FRAMES; ++i)
+            renderer.render(scene, robot, frame);
+        glQueryCounter(queries[1], GL_TIMESTAMP);
+        GLuint64 start = 0, end = 0;
+        glGetQueryObjectui64v(queries[0], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(queries[1], GL_QUERY_RESULT, &end);
+        glDeleteQueries(2, queries);
+        return static_cast<double>(end - start) * 1e-6 / TIMED_FRAMES;
+    }
+
+    std::vector<unsigned char> readback(const Target &target)
+    {
+        std::vector<unsigned char> pixels(static_cast<size_t>(target.width) * target.height * 4);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, target.fbo);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, target.width, target.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        return pixels;
+    }
+}
+
+int runLightingBenchmark(Renderer &renderer, RenderSettings &settings, Scene &scene, Robot &robot,
+                         const BenchCamera &camera)
+{
+    const int lightCounts[] = {1, 4, 16, 64, 256};
+    const int resolutions[][2] = {{1280, 720}, {1920, 1080}, {2560, 1440}, {3840, 2160}};
+
+    const std::vector<SpotLight> originalLights = scene.getLights();
+    const RenderPath originalPath = settings.path;
+    const bool originalPrepass = settings.depthPrepass;
+    const bool originalDynamic = settings.dynamicResolution;
+    settings.depthPrepass = false;
+    settings.dynamicResolution = false;
+
+    glm::vec3 center;
+    float radius;
+    scene.getSceneBounds(center, radius);
+
+    robot.syncTransform();
+    TransformSystem::get().update();
+
+    std::printf("%-10s %6s %12s %12s %10s %8s %s\n",
+                "resolution", "lights", "forward ms", "deferred ms", "mean diff", "p99.9", "result");
+    int failures = 0;
+    for (const auto &res : resolutions)
+    {
+        Target target(res[0], res[1]);
+        FrameView frame;
+        frame.width = res[0];
+        frame.height = res[1];
+        frame.targetFramebuffer = target.fbo;
+        frame.cameraPos = camera.eye;
+        frame.view = glm::lookAt(camera.eye, camera.target, glm::vec3(0.0f, 1.0f, 0.0f));
+        frame.projection = glm::perspective(glm::radians(camera.fovDeg), float(res[0]) / float(res[1]),
+                                            camera.nearZ, camera.farZ);
+
+        for (int lightCount : lightCounts)
+        {
+            scene.setLights(makeLights(lightCount, center, radius));
+
+            // Forward en fazla MAX_SPOT_LIGHTS ışık görür; karşılaştırma sadece o sınıra kadar anlamlı
+            bool comparable = lightCount <= MAX_SPOT_LIGHTS;
+
+            settings.path = RenderPath::Forward;
+            double forwardMs = timeFrames(renderer, scene, robot, frame);
+            std::vector<unsigned char> forwardImage = readback(target);
+
+            settings.path = RenderPath::Deferred;
+            double deferredMs = timeFrames(renderer, scene, robot, frame);
+            std::vector<unsigned char> deferredImage = readback(target);
+
+            // Kanal farklarının histogramı
+            unsigned long long histogram[256] = {0};
+            double sum = 0.0;
+            for (size_t i = 0; i < forwardImage.size(); i += 4)
+            {
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    int d = std::abs(int(forwardImage[i + c]) - int(deferredImage[i + c]));
+                    histogram[d]++;
+                    sum += d;
+                }
+            }
+            unsigned long long samples = forwardImage.size() / 4 * 3;
+            unsigned long long limit = samples - samples / 1000, seen = 0;
+            int p999 = 0;
+            for (; p999 < 255; ++p999)
+            {
+                seen += histogram[p999];
+                if (seen >= limit)
+                    break;
+            }
+            double mean = sum / double(samples);
+            bool pass = !comparable || (mean <= MAX_MEAN_DIFF && p999 <= MAX_P999_DIFF);
+            failures += pass ? 0 : 1;
+
+            std::printf("%4dx%-5d %6d %12.3f %12.3f %10.3f %8d %s\n",
+                        res[0], res[1], lightCount, forwardMs, deferredMs, mean, p999,
+                        !comparable ? "n/a (forward capped)" : (pass ? "ok" : "MISMATCH"));
+        }
+    }
+
+    scene.setLights(originalLights);
+    settings.path = originalPath;
+    settings.depthPrepass = originalPrepass;
+    settings.dynamicResolution = originalDynamic;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,22 @@
+// RenderBench.h
+#ifndef RENDERBENCH_H
+#define RENDERBENCH_H
+
+#include <glm/glm.hpp>
+#include "Renderer.h"
+
+struct BenchCamera
+{
+    glm::vec3 eye;
+    glm::vec3 target;
+    float fovDeg;
+    float nearZ, farZ;
+};
+
+// --bench-lighting: forward vs. deferred over a sweep of light counts and
+// resolutions (offscreen). Prints GPU times and the image difference between
+// both paths; returns non-zero if any case is outside the tolerance.
+int runLightingBenchmark(Renderer &renderer, RenderSettings &settings, Scene &scene, Robot &robot,
+                         const BenchCamera &camera);
+
+#endif // RENDERBENCH_H
@@ -0,0 +1,6 @@
+// RenderCounters.cpp
+#include "RenderCounters.h"
+
+RenderCounters::Frame RenderCounters::frame;
+std::atomic<std::int64_t> RenderCounters::textureBytes{0};
+std::atomic<std::int64_t> RenderCounters::bufferBytes{0};
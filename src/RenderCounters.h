@@ -0,0 +1,49 @@
+// RenderCounters.h
+#ifndef RENDERCOUNTERS_H
+#define RENDERCOUNTERS_H
+
+#include <atomic>
+#include <cstdint>
+
+// Draw calls, triangles and GL state changes issued by our own draw code
+// (GL thread, plain increments), plus a running estimate of the VRAM held by
+// the textures and buffers we create (any thread). The estimate ignores
+// driver padding and counts mipmapped textures as 4/3 of the base level.
+class RenderCounters
+{
+public:
+    struct Frame
+    {
+        unsigned int drawCalls = 0;
+        unsigned int stateChanges = 0; // program, VAO, texture, sampler binds
+        std::uint64_t triangles = 0;
+    };
+
+    static void draw(std::uint64_t triangles)
+    {
+        ++frame.drawCalls;
+        frame.triangles += triangles;
+    }
+    static void stateChange(unsigned int count = 1) { frame.stateChanges += count; }
+
+    // Starts a new frame; returns the counts of the one just finished
+    static Frame endFrame()
+    {
+        Frame done = frame;
+        frame = Frame();
+        return done;
+    }
+
+    // bytes < 0 when the storage is released
+    static void trackTexture(std::int64_t bytes) { textureBytes.fetch_add(bytes, std::memory_order_relaxed); }
+    static void trackBuffer(std::int64_t bytes) { bufferBytes.fetch_add(bytes, std::memory_order_relaxed); }
+    static std::int64_t textureMemory() { return textureBytes.load(std::memory_order_relaxed); }
+    static std::int64_t bufferMemory() { return bufferBytes.load(std::memory_order_relaxed); }
+
+private:
+    static Frame frame;
+    static std::atomic<std::int64_t> textureBytes;
+    static std::atomic<std::int64_t> bufferBytes;
+};
+
+#endif // RENDERCOUNTERS_H
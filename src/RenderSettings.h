@@ -0,0 +1,131 @@
+// RenderSettings.h
+#ifndef RENDERSETTINGS_H
+#define RENDERSETTINGS_H
+
+enum class RenderPath
+{
+    Forward,
+    Deferred
+};
+
+enum class PacingMode
+{
+    VSync,
+    Adaptive,  // vsync, late frames tear instead of waiting a full interval
+    Limited,   // vsync off, sleep-spin limiter at targetFps
+    Unlimited
+};
+
+enum class UpscaleFilter
+{
+    Bilinear,
+    Sharpen
+};
+
+// Runtime switches edited from the UI
+struct RenderSettings
+{
+    RenderPath path = RenderPath::Forward; // chosen at startup (--deferred)
+    bool legacyNormalMatrix = false; // per-vertex transpose(inverse(model)), for A/B timing
+    bool depthPrepass = false;       // position-only depth pass, then shading with GL_EQUAL
+
+    // Dynamic resolution: scene is rendered offscreen at a scale chosen from GPU time
+    bool dynamicResolution = false;
+    float targetGpuMs = 14.0f; // 60 Hz bütçesinden CPU/ImGui payı düşülmüş
+    float minScale = 0.5f;
+    UpscaleFilter upscaleFilter = UpscaleFilter::Sharpen;
+    float sharpness = 0.4f;
+
+    // Idle mode: unchanged frames are not rendered, the cached frame is shown again
+    bool idleMode = true;
+
+    // Frame pacing
+    PacingMode pacing = PacingMode::VSync;
+    int targetFps = 60;
+    int maxFramesInFlight = 2; // GPU kuyruğunda bekleyebilecek frame sayısı
+
+    // Simulation runs at a fixed rate, rendering interpolates between steps
+    int simRateHz = 60;
+};
+
+constexpr int MAX_GPU_PASSES = 16;
+
+// Rolling GPU time of one named pass (GpuProfiler)
+struct GpuPassStats
+{
+    const char *name = nullptr;
+    float lastMs = 0.0f;
+    float avgMs = 0.0f;
+    float p50Ms = 0.0f;
+    float p95Ms = 0.0f;
+    float p99Ms = 0.0f;
+    float maxMs = 0.0f;
+};
+
+// Per-frame measurements shown in the UI
+struct RenderStats
+{
+    float prepassGpuMs = 0.0f;
+    float sceneGpuMs = 0.0f; // shading pass
+
+    // Deferred path
+    float geometryGpuMs = 0.0f;
+    float lightingGpuMs = 0.0f;
+    unsigned int lightsDrawn = 0;
+    unsigned int transformsUpdated = 0;
+
+    // Dynamic resolution
+    float renderScale = 1.0f;
+    int renderWidth = 0, renderHeight = 0;
+    float upscaleGpuMs = 0.0f;
+    float frameGpuMs = 0.0f; // all scene passes + upscale, input of the scale controller
+
+    // Idle mode
+    float idleFraction = 0.0f;
+    unsigned long long idleSavedFrames = 0;
+    unsigned long long idlePresentedFrames = 0;
+
+    // Frame pacing
+    float frameMs = 0.0f;
+    float frameJitterMs = 0.0f;
+    float limiterWaitMs = 0.0f;
+    float gpuWaitMs = 0.0f;
+    float inputLatencyMs = 0.0f; // input -> GPU done with the frame that reacted to it
+    unsigned long long gpuStalls = 0; // 100 ms fence waits that timed out (since start)
+
+    // Threads (main = input, sim, UI; render = GL). Equal in single-thread mode.
+    bool threaded = false;
+    float mainThreadMs = 0.0f;
+    float mainWaitMs = 0.0f;   // waiting for the render thread to take the last packet
+    float renderThreadMs = 0.0f;
+    float renderWaitMs = 0.0f; // waiting for a packet
+
+    // Job system / culling (main thread)
+    unsigned int jobThreads = 0;
+    unsigned int visibleModels = 0;
+    unsigned int totalModels = 0;
+
+    // Simulation
+    int simSteps = 0; // steps run this frame
+    float simAlpha = 0.0f;
+    float simDroppedMs = 0.0f; // total, clamped away after long frames
+
+    // Draw work of the last rendered frame (our passes + ImGui)
+    unsigned int drawCalls = 0;
+    unsigned int stateChanges = 0;
+    unsigned long long triangles = 0;
+    long long textureBytes = 0; // VRAM estimate (RenderCounters)
+    long long bufferBytes = 0;
+
+    // GPU passes, read back a few frames late
+    bool gpuTimers = false; // timer queries available
+    int gpuPassCount = 0;
+    GpuPassStats gpuPasses[MAX_GPU_PASSES];
+
+    // Upload ring
+    bool ringPersistent = false;
+    unsigned int ringBytes = 0;
+    unsigned int ringStalls = 0;
+};
+
+#endif // RENDERSETTINGS_H
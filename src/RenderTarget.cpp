@@ -0,0 +1,53 @@
+// RenderTarget.cpp
+#include "RenderTarget.h"
+#include "RenderCounters.h"
+#include <glad/glad.h>
+#include <iostream>
+
+RenderTarget::~RenderTarget()
+{
+    release();
+}
+
+void RenderTarget::release()
+{
+    if (!fbo)
+        return;
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &color);
+    glDeleteRenderbuffers(1, &depth);
+    RenderCounters::trackTexture(-static_cast<std::int64_t>(width) * height * 8); // RGBA8 + D24 (4 bayt)
+    fbo = color = depth = 0;
+}
+
+void RenderTarget::resize(int w, int h)
+{
+    if (w == width && h == height && fbo)
+        return;
+    release();
+    width = w;
+    height = h;
+
+    glGenTextures(1, &color);
+    glBindTexture(GL_TEXTURE_2D, color);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenRenderbuffers(1, &depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    RenderCounters::trackTexture(static_cast<std::int64_t>(w) * h * 8);
+
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "ERROR::RENDERTARGET: framebuffer incomplete (" << w << "x" << h << ")" << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
@@ -0,0 +1,30 @@
+// RenderTarget.h
+#ifndef RENDERTARGET_H
+#define RENDERTARGET_H
+
+// Offscreen color (RGBA8, linear filtered) + depth target.
+// Allocated for the largest size needed; smaller frames use a viewport.
+class RenderTarget
+{
+public:
+    RenderTarget() = default;
+    ~RenderTarget();
+    RenderTarget(const RenderTarget &) = delete;
+    RenderTarget &operator=(const RenderTarget &) = delete;
+
+    // Reallocates only when the size changes
+    void resize(int width, int height);
+
+    unsigned int framebuffer() const { return fbo; }
+    unsigned int colorTexture() const { return color; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    int width = 0, height = 0;
+    unsigned int fbo = 0, color = 0, depth = 0;
+
+    void release();
+};
+
+#endif // RENDERTARGET_H
@@ -0,0 +1,255 @@
+// RenderThread.cpp
+#include "RenderThread.h"
+#include "HotReload.h"
+#include "Transform.h"
+#include "Profiler.h"
+#include "GpuProfiler.h"
+#include "RenderCounters.h"
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <imgui_impl_opengl3.h>
+#include <algorithm>
+
+RenderThread::RenderThread(GLFWwindow *w, Renderer &r, Scene &s, Robot &rb,
+                           RenderSettings &rs, RenderStats &st, bool threadedMode)
+    : window(w), renderer(r), scene(s), robot(rb), renderSettings(rs), renderStats(st),
+      threaded(threadedMode)
+{
+    renderStats.threaded = threaded;
+}
+
+RenderThread::~RenderThread()
+{
+    stop();
+}
+
+void RenderThread::start()
+{
+    if (!threaded || running)
+        return;
+    running = true;
+    thread = std::thread(&RenderThread::run, this);
+}
+
+void RenderThread::stop()
+{
+    if (!thread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(doorbellMutex);
+        running = false;
+    }
+    packetReady.notify_one();
+    thread.join();
+}
+
+void RenderThread::run()
+{
+    glfwMakeContextCurrent(window);
+    PROFILE_THREAD("Render");
+    for (;;)
+    {
+        double waitStart = glfwGetTime();
+        {
+            PROFILE_SCOPE("Wait for packet");
+            std::unique_lock<std::mutex> lock(doorbellMutex);
+            packetReady.wait(lock, [this] { return packets.hasNew() || !running; });
+        }
+        if (!packets.hasNew())
+            break; // durduruldu ve bekleyen paket yok
+        double waitMs = (glfwGetTime() - waitStart) * 1000.0;
+
+        // Paket hemen alınır: limiter beklemesi ana thread'de, girişten önce.
+        // Burada sadece GPU kuyruğu sınırı kalır (ana thread o sırada bir
+        // sonraki frame'i hazırlar)
+        packets.acquire();
+        {
+            std::lock_guard<std::mutex> lock(doorbellMutex);
+            consumed = packets.readSlot().frameIndex;
+        }
+        packetTaken.notify_one();
+
+        if (!packets.readSlot().presentCached)
+        {
+            PROFILE_SCOPE("Frame pacing");
+            pacer.beginFrame(packets.readSlot().settings);
+        }
+        execute(packets.readSlot(), waitMs);
+    }
+    glfwMakeContextCurrent(nullptr);
+}
+
+void RenderThread::beginFrame(const RenderSettings &settings)
+{
+    double start = glfwGetTime();
+    if (threaded)
+    {
+        std::unique_lock<std::mutex> lock(doorbellMutex);
+        packetTaken.wait(lock, [this] { return consumed >= submitted; });
+    }
+    {
+        PROFILE_SCOPE("Frame limiter");
+        limiter.wait(settings);
+    }
+    if (!threaded)
+    {
+        PROFILE_SCOPE("Frame pacing");
+        pacer.beginFrame(settings);
+    }
+    mainFrameStart = glfwGetTime();
+    mainWaitMs = static_cast<float>((mainFrameStart - start) * 1000.0);
+}
+
+void RenderThread::submit()
+{
+    FramePacket &p = packets.writeSlot();
+    p.frameIndex = ++frameCounter;
+    if (p.presentCached)
+        limiter.restart(); // boşta: ritim uyanınca yeniden başlar
+    float mainMs = static_cast<float>((glfwGetTime() - mainFrameStart) * 1000.0);
+
+    if (!threaded)
+    {
+        packets.publish();
+        packets.acquire();
+        execute(packets.readSlot(), 0.0);
+    }
+    else
+    {
+        // Paket el değiştirmeden önce UI çizim listeleri kopyalanır
+        if (p.ui)
+        {
+            p.uiCopy.capture(p.ui);
+            p.ui = p.uiCopy.get();
+        }
+        packets.publish();
+        {
+            std::lock_guard<std::mutex> lock(doorbellMutex);
+            submitted = p.frameIndex;
+        }
+        packetReady.notify_one();
+    }
+    // Ana thread'in bu frame'deki işi (bekleme hariç)
+    lastMainMs = mainMs;
+}
+
+void RenderThread::execute(const FramePacket &p, double waitMs)
+{
+    PROFILE_SCOPE("Render frame");
+    double start = glfwGetTime();
+    const int w = p.view.width, h = p.view.height;
+
+    if (p.presentCached)
+    {
+        pacer.skipFrame();
+        if (frameCache.present(w, h))
+        {
+            glfwSwapBuffers(window);
+            presentedCached.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    // Frame sınırı: yeniden yüklenen kaynaklar bu frame'den itibaren çizilir
+    if (hotReload)
+        hotReload->update(scene, renderer);
+    renderSettings = p.settings;
+    scene.setLights(p.lights);
+    robot.applyPose(p.robotPose);
+    TransformSystem::get().update();
+    renderStats.transformsUpdated = static_cast<unsigned int>(TransformSystem::get().lastUpdateCount());
+
+    pacer.consumeInput(p.inputTime);
+    GpuProfiler &gpuProfiler = GpuProfiler::get();
+    gpuProfiler.beginFrame();
+    RenderCounters::endFrame(); // frame dışı çizimler (bench, başlangıç) sayılmaz
+    {
+        GPU_PROFILE_SCOPE("Frame");
+        renderer.render(scene, robot, p.view);
+        if (p.ui)
+        {
+            PROFILE_SCOPE("ImGui draw");
+            GPU_PROFILE_SCOPE("ImGui");
+            ImGui_ImplOpenGL3_NewFrame(); // cihaz nesneleri zaten var: sadece kontrol
+            ImGui_ImplOpenGL3_RenderDrawData(p.ui);
+        }
+    }
+    gpuProfiler.endFrame();
+
+    RenderCounters::Frame counts = RenderCounters::endFrame();
+    if (p.ui)
+    {
+        // ImGui backend kendi çağrılarını yapar: çizim listelerinden say
+        for (int i = 0; i < p.ui->CmdListsCount; ++i)
+            counts.drawCalls += static_cast<unsigned int>(p.ui->CmdLists[i]->CmdBuffer.Size);
+        counts.triangles += static_cast<std::uint64_t>(p.ui->TotalIdxCount / 3);
+    }
+    renderStats.drawCalls = counts.drawCalls;
+    renderStats.stateChanges = counts.stateChanges;
+    renderStats.triangles = counts.triangles;
+    renderStats.textureBytes = RenderCounters::textureMemory();
+    renderStats.bufferBytes = RenderCounters::bufferMemory();
+    renderStats.gpuTimers = gpuProfiler.available();
+    renderStats.gpuPassCount = gpuProfiler.snapshot(renderStats.gpuPasses, MAX_GPU_PASSES);
+    if (p.captureFrame)
+        frameCache.capture(w, h);
+    renderStats.renderThreadMs = static_cast<float>((glfwGetTime() - start) * 1000.0);
+    renderStats.renderWaitMs = static_cast<float>(waitMs);
+
+    {
+        PROFILE_SCOPE("Swap buffers");
+        glfwSwapBuffers(window);
+    }
+    pacer.endFrame();
+
+    renderStats.frameMs = pacer.frameMs();
+    renderStats.frameJitterMs = pacer.frameJitterMs();
+    renderStats.gpuWaitMs = pacer.gpuWaitMs();
+    renderStats.inputLatencyMs = pacer.inputLatencyMs();
+    renderStats.gpuStalls = pacer.gpuStalls();
+
+    statsOut.writeSlot() = renderStats;
+    statsOut.publish();
+}
+
+void RenderThread::collectStats(RenderStats &dst)
+{
+    dst.threaded = threaded;
+    dst.mainThreadMs = lastMainMs;
+    dst.mainWaitMs = mainWaitMs;
+    dst.limiterWaitMs = limiter.waitMs();
+    if (!statsOut.acquire())
+        return;
+
+    // Sadece render tarafının doldurduğu alanlar; sim/idle ana thread'de kalır
+    const RenderStats &src = statsOut.readSlot();
+    dst.prepassGpuMs = src.prepassGpuMs;
+    dst.sceneGpuMs = src.sceneGpuMs;
+    dst.geometryGpuMs = src.geometryGpuMs;
+    dst.lightingGpuMs = src.lightingGpuMs;
+    dst.lightsDrawn = src.lightsDrawn;
+    dst.transformsUpdated = src.transformsUpdated;
+    dst.ringPersistent = src.ringPersistent;
+    dst.ringBytes = src.ringBytes;
+    dst.ringStalls = src.ringStalls;
+    dst.renderScale = src.renderScale;
+    dst.renderWidth = src.renderWidth;
+    dst.renderHeight = src.renderHeight;
+    dst.upscaleGpuMs = src.upscaleGpuMs;
+    dst.frameGpuMs = src.frameGpuMs;
+    dst.frameMs = src.frameMs;
+    dst.frameJitterMs = src.frameJitterMs;
+    dst.gpuWaitMs = src.gpuWaitMs;
+    dst.inputLatencyMs = src.inputLatencyMs;
+    dst.gpuStalls = src.gpuStalls;
+    dst.renderThreadMs = src.renderThreadMs;
+    dst.renderWaitMs = src.renderWaitMs;
+    dst.drawCalls = src.drawCalls;
+    dst.stateChanges = src.stateChanges;
+    dst.triangles = src.triangles;
+    dst.textureBytes = src.textureBytes;
+    dst.bufferBytes = src.bufferBytes;
+    dst.gpuTimers = src.gpuTimers;
+    dst.gpuPassCount = src.gpuPassCount;
+    std::copy(src.gpuPasses, src.gpuPasses + src.gpuPassCount, dst.gpuPasses);
+}
@@ -0,0 +1,88 @@
+// RenderThread.h
+#ifndef RENDERTHREAD_H
+#define RENDERTHREAD_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "FramePacket.h"
+#include "FramePacer.h"
+#include "FrameCache.h"
+#include "TripleBuffer.h"
+
+struct GLFWwindow;
+class HotReload;
+
+// Render side of the frame: owns the GL context while running and turns
+// FramePackets into GL work, UI drawing and swaps. Packets come from the
+// main thread through a lock-free triple buffer, render stats go back the
+// same way. In single-thread mode the same code runs inline in submit().
+//
+// The main thread stays at most one frame ahead: beginFrame() waits until
+// the render thread has taken the previous packet.
+class RenderThread
+{
+public:
+    // renderSettings / renderStats are the objects the Renderer was built with
+    RenderThread(GLFWwindow *window, Renderer &renderer, Scene &scene, Robot &robot,
+                 RenderSettings &renderSettings, RenderStats &renderStats, bool threaded);
+    ~RenderThread();
+    RenderThread(const RenderThread &) = delete;
+    RenderThread &operator=(const RenderThread &) = delete;
+
+    // Threaded mode: the caller must have released the GL context
+    void start();
+    // Joins the render thread; the context is released, make it current again
+    void stop();
+    bool isThreaded() const { return threaded; }
+    // Applied at the start of every rendered frame; set before start()
+    void setHotReload(HotReload *reload) { hotReload = reload; }
+
+    // Main thread -------------------------------------------------
+    // Before input is polled: waits for the render thread to take the last
+    // packet, then for the frame limiter (settings: the main thread's copy)
+    void beginFrame(const RenderSettings &settings);
+    FramePacket &packet() { return packets.writeSlot(); }
+    void submit();
+    // Copies the render-side fields of the latest published stats into dst
+    void collectStats(RenderStats &dst);
+    // Idle frames whose cached image was shown again (present succeeded)
+    unsigned long long cachedPresents() const { return presentedCached.load(std::memory_order_relaxed); }
+
+private:
+    GLFWwindow *window;
+    Renderer &renderer;
+    Scene &scene;
+    Robot &robot;
+    RenderSettings &renderSettings;
+    RenderStats &renderStats;
+    bool threaded;
+    HotReload *hotReload = nullptr;
+
+    FramePacer pacer;     // render tarafı: swap aralığı, GPU kuyruğu
+    FrameLimiter limiter; // ana thread
+    FrameCache frameCache;
+
+    TripleBuffer<FramePacket> packets;
+    TripleBuffer<RenderStats> statsOut;
+    unsigned long long frameCounter = 0;
+
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::mutex doorbellMutex;
+    std::condition_variable packetReady; // ana thread -> render
+    std::condition_variable packetTaken; // render -> ana thread
+    std::atomic<unsigned long long> submitted{0};
+    std::atomic<unsigned long long> consumed{0};
+    std::atomic<unsigned long long> presentedCached{0};
+
+    double mainFrameStart = 0.0;
+    float mainWaitMs = 0.0f;
+    float lastMainMs = 0.0f;
+
+    void run();
+    void execute(const FramePacket &p, double waitMs);
+};
+
+#endif // RENDERTHREAD_H
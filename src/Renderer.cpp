@@ -0,0 +1,413 @@
+// Renderer.cpp
+#include "Renderer.h"
+#include "Transform.h"
+#include "Material.h"
+#include "Lights.h"
+#include "Profiler.h"
+#include "GpuProfiler.h"
+#include "RenderCounters.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+Renderer::Renderer(RenderSettings &rs, RenderStats &st)
+    : settings(rs), stats(st),
+      shader("shaders/vertex.glsl", "shaders/fragment.glsl"),
+      depthShader("shaders/depth_vertex.glsl", "shaders/depth_fragment.glsl"),
+      gbufferShader("shaders/vertex.glsl", "shaders/gbuffer_fragment.glsl"),
+      lightShader("shaders/fullscreen_vertex.glsl", "shaders/deferred_light_fragment.glsl"),
+      upscaleShader("shaders/fullscreen_vertex.glsl", "shaders/upscale_fragment.glsl"),
+      uploadRing(1 << 20)
+{
+    configurePrograms();
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uboAlignment);
+    glGenVertexArrays(1, &emptyVAO);
+}
+
+Renderer::~Renderer()
+{
+    glDeleteVertexArrays(1, &emptyVAO);
+}
+
+void Renderer::configurePrograms()
+{
+    shader.bindUniformBlock("LightBlock", LIGHT_BLOCK_BINDING);
+    lightShader.bindUniformBlock("LightBlock", LIGHT_BLOCK_BINDING);
+
+    lightShader.use();
+    lightShader.setInt("gAlbedoSpec", GBUFFER_TEXTURE_UNIT + 0);
+    lightShader.setInt("gNormalShininess", GBUFFER_TEXTURE_UNIT + 1);
+    lightShader.setInt("gDepth", GBUFFER_TEXTURE_UNIT + 2);
+    upscaleShader.use();
+    upscaleShader.setInt("source", 0);
+    glUseProgram(0);
+}
+
+int Renderer::reloadShaders(const std::string &path, int &failed)
+{
+    Shader *programs[] = {&shader, &depthShader, &gbufferShader, &lightShader, &upscaleShader};
+    int reloaded = 0;
+    failed = 0;
+    for (Shader *program : programs)
+    {
+        if (!program->usesFile(path))
+            continue;
+        const unsigned int old = program->ID;
+        if (!program->reload())
+        {
+            ++failed;
+            continue;
+        }
+        // Eski ID'ye bağlı önbellekler: silinen programın adı geri gelebilir
+        TransformSystem::get().forgetProgram(old);
+        MaterialLibrary::get().forgetProgram(old);
+        ++reloaded;
+    }
+    if (reloaded)
+        configurePrograms();
+    return reloaded;
+}
+
+bool Renderer::uploadLights(const std::vector<SpotLight> &lights, std::size_t first, std::size_t count)
+{
+    // Işık listesi doğrudan ring belleğine yazılır, UBO aralığı olarak bağlanır
+    UploadRing::Allocation alloc = uploadRing.allocate(LIGHT_BLOCK_SIZE, uboAlignment);
+    if (!alloc.ptr)
+        return false;
+
+    LightBlockHeader header{};
+    header.numSpotLights = static_cast<int>(std::min<std::size_t>(count, MAX_SPOT_LIGHTS));
+    auto *dst = static_cast<unsigned char *>(alloc.ptr);
+    std::memcpy(dst, &header, sizeof(header));
+    if (header.numSpotLights > 0)
+        std::memcpy(dst + sizeof(header), lights.data() + first, header.numSpotLights * sizeof(SpotLight));
+    uploadRing.flush();
+    glBindBufferRange(GL_UNIFORM_BUFFER, LIGHT_BLOCK_BINDING, uploadRing.buffer(), alloc.offset, LIGHT_BLOCK_SIZE);
+    return true;
+}
+
+void Renderer::depthPrepass(Scene &scene, Robot &robot, const FrameView &frame)
+{
+    PROFILE_SCOPE("Depth prepass");
+    GPU_PROFILE_SCOPE("Depth prepass");
+    depthShader.use();
+    TransformSystem::get().bind(depthShader);
+    depthShader.setMat4("view", frame.view);
+    depthShader.setMat4("projection", frame.projection);
+
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    scene.drawDepth(depthShader, frame.visibleModels);
+    robot.drawDepth(depthShader);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+void Renderer::render(Scene &scene, Robot &robot, const FrameView &frame)
+{
+    PROFILE_SCOPE("Renderer::render");
+    uploadRing.beginFrame();
+
+    // Dinamik çözünürlükte sahne, hedefin sol-alt köşesine küçük viewport ile çizilir;
+    // hedefler sadece pencere boyutu değişince yeniden ayrılır.
+    FrameView scaled = frame;
+    const bool dynamic = settings.dynamicResolution;
+    if (dynamic)
+    {
+        resolution.minScale = settings.minScale;
+        float scale = resolution.scale();
+        sceneTarget.resize(frame.width, frame.height);
+        scaled.width = std::max(1, static_cast<int>(frame.width * scale + 0.5f));
+        scaled.height = std::max(1, static_cast<int>(frame.height * scale + 0.5f));
+        scaled.targetFramebuffer = sceneTarget.framebuffer();
+    }
+    surfaceWidth = frame.width;
+    surfaceHeight = frame.height;
+
+    if (settings.path == RenderPath::Deferred)
+        renderDeferred(scene, robot, scaled);
+    else
+        renderForward(scene, robot, scaled);
+
+    if (dynamic)
+    {
+        upscale(scaled, frame);
+        stats.upscaleGpuMs = upscaleTimer.milliseconds();
+    }
+    else
+    {
+        stats.upscaleGpuMs = 0.0f;
+    }
+
+    stats.frameGpuMs = lastFrameGpuMs();
+    if (dynamic)
+        resolution.update(stats.frameGpuMs, settings.targetGpuMs);
+    else
+        resolution.reset();
+    stats.renderScale = static_cast<float>(scaled.width) / static_cast<float>(frame.width);
+    stats.renderWidth = scaled.width;
+    stats.renderHeight = scaled.height;
+
+    uploadRing.endFrame();
+    stats.ringPersistent = uploadRing.persistent();
+    stats.ringBytes = static_cast<unsigned int>(uploadRing.bytesLastFrame());
+    stats.ringStalls = uploadRing.stallsLastFrame();
+}
+
+// Son ölçülen (yumuşatılmamış) GPU süresi; ölçek denetleyicisi hızlı tepki versin
+float Renderer::lastFrameGpuMs() const
+{
+    float ms = shadingTimer.lastMilliseconds();
+    if (settings.path == RenderPath::Deferred || settings.depthPrepass)
+        ms += prepassTimer.lastMilliseconds();
+    if (settings.dynamicResolution)
+        ms += upscaleTimer.lastMilliseconds();
+    return ms;
+}
+
+void Renderer::upscale(const FrameView &scaled, const FrameView &frame)
+{
+    PROFILE_SCOPE("Upscale");
+    GPU_PROFILE_SCOPE("Upscale");
+    upscaleTimer.begin();
+    glBindFramebuffer(GL_FRAMEBUFFER, frame.targetFramebuffer);
+    glViewport(0, 0, frame.width, frame.height);
+    glDisable(GL_DEPTH_TEST);
+
+    float texW = static_cast<float>(sceneTarget.getWidth());
+    float texH = static_cast<float>(sceneTarget.getHeight());
+    upscaleShader.use();
+    upscaleShader.setVec2("uvScale", glm::vec2(scaled.width / texW, scaled.height / texH));
+    upscaleShader.setVec2("texelSize", glm::vec2(1.0f / texW, 1.0f / texH));
+    // Tam ölçekte keskinleştirme gereksiz: birebir kopya
+    upscaleShader.setBool("sharpen", settings.upscaleFilter == UpscaleFilter::Sharpen && scaled.width < frame.width);
+    upscaleShader.setFloat("sharpness", settings.sharpness);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, sceneTarget.colorTexture());
+    glBindVertexArray(emptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    RenderCounters::stateChange(2);
+    RenderCounters::draw(1);
+
+    glEnable(GL_DEPTH_TEST);
+    upscaleTimer.end();
+}
+
+void Renderer::renderForward(Scene &scene, Robot &robot, const FrameView &frame)
+{
+    PROFILE_SCOPE("Forward shading");
+    glBindFramebuffer(GL_FRAMEBUFFER, frame.targetFramebuffer);
+    glViewport(0, 0, frame.width, frame.height);
+
+    // ---------- Temizle ----------------------------------------
+    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // ---------- Depth pre-pass (isteğe bağlı) -------------------
+    if (settings.depthPrepass)
+    {
+        prepassTimer.begin();
+        depthPrepass(scene, robot, frame);
+        prepassTimer.end();
+        stats.prepassGpuMs = prepassTimer.milliseconds();
+
+        // Shading sadece en yakın yüzeyde çalışır
+        glDepthFunc(GL_EQUAL);
+        glDepthMask(GL_FALSE);
+    }
+    else
+    {
+        stats.prepassGpuMs = 0.0f;
+    }
+
+    // ---------- Shading -----------------------------------------
+    shader.use();
+    TransformSystem::get().bind(shader);
+    shader.setBool("legacyNormalMatrix", settings.legacyNormalMatrix);
+    shader.setVec3("viewPos", frame.cameraPos);
+    shader.setMat4("view", frame.view);
+    shader.setMat4("projection", frame.projection);
+    const std::vector<SpotLight> &lights = scene.getLights();
+    uploadLights(lights, 0, lights.size()); // forward yol en fazla MAX_SPOT_LIGHTS
+
+    shadingTimer.begin();
+    {
+        GPU_PROFILE_SCOPE("Scene");
+        scene.draw(shader, frame.visibleModels);
+    }
+    {
+        GPU_PROFILE_SCOPE("Robot");
+        robot.draw(shader);
+    }
+    shadingTimer.end();
+    stats.sceneGpuMs = shadingTimer.milliseconds();
+    stats.lightsDrawn = static_cast<unsigned int>(std::min<std::size_t>(lights.size(), MAX_SPOT_LIGHTS));
+
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+}
+
+// Attenuation'ın 1/256'nın altına düştüğü mesafe
+static float lightRange(const SpotLight &light)
+{
+    float peak = 0.0f;
+    for (int c = 0; c < 3; ++c)
+        peak = std::max(peak, light.ambient[c] + light.diffuse[c] + light.specular[c]);
+    float target = peak * 256.0f - light.constant;
+    if (target <= 0.0f)
+        return 0.0f;
+    if (light.quadratic > 0.0f)
+        return (-light.linear + std::sqrt(light.linear * light.linear + 4.0f * light.quadratic * target)) / (2.0f * light.quadratic);
+    if (light.linear > 0.0f)
+        return target / light.linear;
+    return std::numeric_limits<float>::max();
+}
+
+// Spot konisinin (apex + taban sekizgeni) ekran dikdörtgeni.
+// false: ışık ekrana hiç düşmüyor.
+static bool lightScissor(const SpotLight &light, float range, const glm::mat4 &viewProj,
+                         int width, int height, int rect[4])
+{
+    rect[0] = 0;
+    rect[1] = 0;
+    rect[2] = width;
+    rect[3] = height;
+    if (light.outerCutOff <= 0.05f)
+        return true; // neredeyse yarım küre: tüm ekran
+
+    glm::vec3 dir = glm::normalize(light.direction);
+    glm::vec3 up = std::fabs(dir.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+    glm::vec3 u = glm::normalize(glm::cross(dir, up));
+    glm::vec3 v = glm::cross(dir, u);
+    float tanOuter = std::sqrt(1.0f - light.outerCutOff * light.outerCutOff) / light.outerCutOff;
+    float baseRadius = range * tanOuter / std::cos(3.14159265f / 8.0f); // çemberi içeren sekizgen
+    glm::vec3 baseCenter = light.position + dir * range;
+
+    glm::vec3 points[9];
+    points[0] = light.position;
+    for (int i = 0; i < 8; ++i)
+    {
+        float a = i * (3.14159265f / 4.0f);
+        points[i + 1] = baseCenter + (u * std::cos(a) + v * std::sin(a)) * baseRadius;
+    }
+
+    const float inf = std::numeric_limits<float>::max();
+    float minX = inf, minY = inf, maxX = -inf, maxY = -inf;
+    for (const glm::vec3 &p : points)
+    {
+        glm::vec4 clip = viewProj * glm::vec4(p, 1.0f);
+        if (clip.w <= 1e-4f)
+            return true; // kameranın arkasına taşıyor: tüm ekran
+        float x = clip.x / clip.w, y = clip.y / clip.w;
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+    if (maxX < -1.0f || maxY < -1.0f || minX > 1.0f || minY > 1.0f)
+        return false;
+
+    minX = std::max(minX, -1.0f);
+    minY = std::max(minY, -1.0f);
+    maxX = std::min(maxX, 1.0f);
+    maxY = std::min(maxY, 1.0f);
+    rect[0] = static_cast<int>(std::floor((minX * 0.5f + 0.5f) * width));
+    rect[1] = static_cast<int>(std::floor((minY * 0.5f + 0.5f) * height));
+    rect[2] = static_cast<int>(std::ceil((maxX * 0.5f + 0.5f) * width)) - rect[0];
+    rect[3] = static_cast<int>(std::ceil((maxY * 0.5f + 0.5f) * height)) - rect[1];
+    return rect[2] > 0 && rect[3] > 0;
+}
+
+void Renderer::renderDeferred(Scene &scene, Robot &robot, const FrameView &frame)
+{
+    PROFILE_SCOPE("Deferred shading");
+    stats.prepassGpuMs = 0.0f;
+
+    // ---------- Geometri: G-buffer ------------------------------
+    gbuffer.resize(surfaceWidth, surfaceHeight);
+    gbuffer.bindForWriting();
+    glViewport(0, 0, frame.width, frame.height);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    prepassTimer.begin();
+    gbufferShader.use();
+    TransformSystem::get().bind(gbufferShader);
+    gbufferShader.setBool("legacyNormalMatrix", settings.legacyNormalMatrix);
+    gbufferShader.setMat4("view", frame.view);
+    gbufferShader.setMat4("projection", frame.projection);
+    {
+        GPU_PROFILE_SCOPE("Scene (G-buffer)");
+        scene.draw(gbufferShader, frame.visibleModels);
+    }
+    {
+        GPU_PROFILE_SCOPE("Robot (G-buffer)");
+        robot.draw(gbufferShader);
+    }
+    prepassTimer.end();
+    stats.geometryGpuMs = prepassTimer.milliseconds();
+
+    // ---------- Işıklar: hedef framebuffer'a additive ----------
+    glBindFramebuffer(GL_FRAMEBUFFER, frame.targetFramebuffer);
+    glViewport(0, 0, frame.width, frame.height);
+    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    shadingTimer.begin();
+    GPU_PROFILE_SCOPE("Lighting");
+    glm::mat4 viewProj = frame.projection * frame.view;
+    lightShader.use();
+    lightShader.setMat4("invViewProj", glm::inverse(viewProj));
+    lightShader.setVec3("viewPos", frame.cameraPos);
+    lightShader.setVec2("viewportSize", glm::vec2(frame.width, frame.height));
+    gbuffer.bindTextures();
+    glDisable(GL_DEPTH_TEST);
+    glBindVertexArray(emptyVAO);
+
+    // Geometri piksellerini sıfırla (arka plan temizleme renginde kalır)
+    lightShader.setInt("lightIndex", -1);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    RenderCounters::stateChange(4); // G-buffer dokuları + VAO
+    RenderCounters::draw(1);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    glEnable(GL_SCISSOR_TEST);
+
+    // Işıklar MAX_SPOT_LIGHTS'lık parçalar halinde yüklenir: deferred yolda sınır yok
+    glm::vec3 sceneCenter;
+    float sceneRadius;
+    scene.getSceneBounds(sceneCenter, sceneRadius);
+    const std::vector<SpotLight> &lights = scene.getLights();
+    unsigned int drawn = 0;
+    for (std::size_t first = 0; first < lights.size(); first += MAX_SPOT_LIGHTS)
+    {
+        std::size_t count = std::min<std::size_t>(MAX_SPOT_LIGHTS, lights.size() - first);
+        if (!uploadLights(lights, first, count))
+            break;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const SpotLight &light = lights[first + i];
+            // Sahnenin dışına taşan menzil işe yaramaz
+            float range = std::min(lightRange(light), glm::length(light.position - sceneCenter) + sceneRadius);
+            int rect[4];
+            if (range <= 0.0f || !lightScissor(light, range, viewProj, frame.width, frame.height, rect))
+                continue;
+            glScissor(rect[0], rect[1], rect[2], rect[3]);
+            lightShader.setInt("lightIndex", static_cast<int>(i));
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+            RenderCounters::draw(1);
+            ++drawn;
+        }
+    }
+
+    glDisable(GL_SCISSOR_TEST);
+    glDisable(GL_BLEND);
+    glEnable(GL_DEPTH_TEST);
+    glBindVertexArray(0);
+    shadingTimer.end();
+    stats.lightingGpuMs = shadingTimer.milliseconds();
+    stats.lightsDrawn = drawn;
+}
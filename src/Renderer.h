@@ -0,0 +1,80 @@
+// Renderer.h
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Shader.h"
+#include "Scene.h"
+#include "Robot.h"
+#include "UploadRing.h"
+#include "GpuTimer.h"
+#include "GBuffer.h"
+#include "RenderTarget.h"
+#include "DynamicResolution.h"
+#include "RenderSettings.h"
+
+// Camera state and output target of one frame
+struct FrameView
+{
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec3 cameraPos;
+    int width = 0, height = 0;
+    unsigned int targetFramebuffer = 0;
+    // Frustum culling result (Scene model indices); nullptr draws everything
+    const std::vector<std::uint32_t> *visibleModels = nullptr;
+};
+
+// Owns the scene programs and per-frame GPU resources, and draws one frame
+// of the 3D scene into frame.targetFramebuffer. With dynamic resolution the
+// scene goes to an offscreen target first and is upscaled to frame size.
+class Renderer
+{
+public:
+    Renderer(RenderSettings &settings, RenderStats &stats);
+    ~Renderer();
+
+    void render(Scene &scene, Robot &robot, const FrameView &frame);
+
+    Shader &getShader() { return shader; }
+
+    // Hot reload: recompiles every program built from path. A program that
+    // fails to compile or link keeps running; failed counts those.
+    int reloadShaders(const std::string &path, int &failed);
+
+private:
+    RenderSettings &settings;
+    RenderStats &stats;
+
+    Shader shader;      // forward shading (spot ışıkları)
+    Shader depthShader; // depth pre-pass
+    Shader gbufferShader;
+    Shader lightShader; // deferred, ışık başına ekran-uzayı geçişi
+    Shader upscaleShader;
+
+    UploadRing uploadRing;
+    int uboAlignment = 256;
+    GBuffer gbuffer;
+    RenderTarget sceneTarget;   // dinamik çözünürlük: tam boyutta ayrılır, viewport küçülür
+    DynamicResolution resolution;
+    int surfaceWidth = 0, surfaceHeight = 0; // G-buffer ayırma boyutu
+    unsigned int emptyVAO = 0; // tam ekran üçgen için
+
+    GpuTimer prepassTimer;
+    GpuTimer shadingTimer;
+    GpuTimer upscaleTimer;
+
+    void configurePrograms(); // uniform blokları ve sabit sampler birimleri
+    bool uploadLights(const std::vector<SpotLight> &lights, std::size_t first, std::size_t count);
+    void depthPrepass(Scene &scene, Robot &robot, const FrameView &frame);
+    void renderForward(Scene &scene, Robot &robot, const FrameView &frame);
+    void renderDeferred(Scene &scene, Robot &robot, const FrameView &frame);
+    void upscale(const FrameView &scaled, const FrameView &frame);
+    float lastFrameGpuMs() const;
+};
+
+#endif // RENDERER_H
@@ -1,6 +1,10 @@
 // Robot.cpp
 #include "Robot.h"
+#include "Material.h"
+#include "RenderCounters.h"
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/rotate_vector.hpp>
+#include <algorithm>
 #include <iostream>
 
 // Vertex data for a unit cube (36 vertices) - COMPLETE VERSION
@@ -49,10 +53,12 @@ static float cubeVertices[] = {
     -0.5f, 0.5f, -0.5f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f};
 
 Robot::Robot()
+    : transform(TransformSystem::get().create())
 {
     position = glm::vec3(0.0f, 0.5f, 0.0f); // Changed y to 0.5
     direction = glm::vec3(1.0f, 0.0f, 0.0f);
-    initMesh();
+    prevPosition = position;
+    prevDirection = direction;
 }
 
 Robot::~Robot()
@@ -86,8 +92,19 @@ void Robot::initMesh()
     glBindVertexArray(0);
 }
 
-void Robot::update(float deltaTime)
+void Robot::update(float dt)
 {
+    prevPosition = position;
+    prevDirection = direction;
+
+    // Klavye kontrolü
+    if (input.active())
+    {
+        direction = glm::rotateY(direction, glm::radians(turnSpeed * input.turn * dt));
+        glm::vec3 right = glm::normalize(glm::cross(direction, glm::vec3(0.0f, 1.0f, 0.0f)));
+        position += (direction * input.move + right * input.strafe) * speed * dt;
+    }
+
     if (waypoints.empty())
         return;
     glm::vec3 target = waypoints[currentTarget];
@@ -99,28 +116,64 @@ void Robot::update(float deltaTime)
         return;
     }
     direction = glm::normalize(toTarget);
-    position += direction * speed * deltaTime;
+    // Hedefi aşma: düşük sim hızında bile salınım olmaz
+    position += direction * std::min(speed * dt, dist);
+}
+
+void Robot::teleport(const glm::vec3 &pos)
+{
+    position = prevPosition = pos;
 }
 
 // Robot.cpp
+RobotPose Robot::pose(float alpha) const
+{
+    // Son iki sim durumu arasında ara değer
+    glm::vec3 dir = glm::mix(prevDirection, direction, alpha);
+    if (glm::dot(dir, dir) < 1e-8f)
+        dir = direction; // tam ters yönler arasında geçiş
+
+    RobotPose p;
+    p.position = glm::mix(prevPosition, position, alpha);
+    p.yaw = atan2(dir.x, dir.z); // Rotate robot to face direction
+    return p;
+}
+
+void Robot::applyPose(const RobotPose &p)
+{
+    // Scale it to be twice as big
+    TransformSystem::get().set(transform, p.position, p.yaw, 2.0f);
+}
+
 void Robot::draw(Shader &shader)
 {
-    glm::mat4 modelMat = glm::mat4(1.0f);
-    modelMat = glm::translate(modelMat, position);
-    // Rotate robot to face direction
-    float angle = atan2(direction.x, direction.z);
-    modelMat = glm::rotate(modelMat, angle, glm::vec3(0, 1, 0));
-    // Scale the robot to be twice as big
-    modelMat = glm::scale(modelMat, glm::vec3(2.0f));
-    shader.setMat4("model", modelMat);
+    if (!VAO)
+        initMesh();
+    TransformSystem::get().setDraw(transform, shader);
+    MaterialLibrary::get().bind(DEFAULT_MATERIAL, shader);
 
     glBindVertexArray(VAO);
     glDrawArrays(GL_TRIANGLES, 0, 36);
     glBindVertexArray(0);
+    RenderCounters::stateChange();
+    RenderCounters::draw(12);
+}
+
+void Robot::drawDepth(Shader &shader)
+{
+    // Küp küçük; interleaved VAO'da sadece attrib 0 okunur
+    if (!VAO)
+        initMesh();
+    TransformSystem::get().setDraw(transform, shader);
+    glBindVertexArray(VAO);
+    glDrawArrays(GL_TRIANGLES, 0, 36);
+    glBindVertexArray(0);
+    RenderCounters::stateChange();
+    RenderCounters::draw(12);
 }
 
 void Robot::setPath(const std::vector<glm::vec3> &wps)
 {
-    waypoints = wps;
+    waypoints.assign(wps.begin(), wps.end()); // kapasite korunur
     currentTarget = 0;
 }
@@ -5,26 +5,64 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include "Shader.h"
+#include "Transform.h"
 #include <glad/glad.h>
 
+// Manual control axes, each in [-1, 1]; applied on every sim step
+struct RobotInput
+{
+    float move = 0.0f;   // +ileri / -geri
+    float strafe = 0.0f; // +sağ / -sol
+    float turn = 0.0f;   // +sola dönüş (derece/sn ile çarpılır)
+
+    bool active() const { return move != 0.0f || strafe != 0.0f || turn != 0.0f; }
+};
+
+// Interpolated pose handed to the renderer
+struct RobotPose
+{
+    glm::vec3 position{0.0f};
+    float yaw = 0.0f;
+};
+
 class Robot {
 public:
+    // Simulation state (advanced only by update)
     glm::vec3 position;
     glm::vec3 direction;
     float speed = 2.5f;
+    float turnSpeed = 90.0f; // derece / sn
 
     // Mesh handles
     unsigned int VAO = 0, VBO = 0;
 
+    // GL resources are created on first draw, so a Robot can be simulated headless
     Robot();
     ~Robot();
-    void update(float deltaTime);
+    // One fixed simulation step
+    void update(float dt);
+    void setInput(const RobotInput &in) { input = in; }
+    // Moves without interpolating from the old position
+    void teleport(const glm::vec3 &pos);
     void draw(Shader &shader);
+    void drawDepth(Shader &shader);
+    // State interpolated between the last two steps (simulation side)
+    RobotPose pose(float alpha = 1.0f) const;
+    // Pushes a pose into the transform system, no-op if unchanged (render side)
+    void applyPose(const RobotPose &pose);
+    void syncTransform(float alpha = 1.0f) { applyPose(pose(alpha)); }
     void setPath(const std::vector<glm::vec3> &waypoints);
+    // Following waypoints: position changes every update
+    bool isMoving() const { return !waypoints.empty(); }
+    int targetIndex() const { return currentTarget; }
 
 private:
     std::vector<glm::vec3> waypoints;
     int currentTarget = 0;
+    TransformHandle transform;
+    RobotInput input;
+    glm::vec3 prevPosition;
+    glm::vec3 prevDirection;
 
     void initMesh();
 };
@@ -1,32 +1,128 @@
 // Scene.cpp
 #include "Scene.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "RenderCounters.h"
 #include <glm/gtc/matrix_transform.hpp>
-#include <array>
+#include <algorithm>
 #include <iostream>
 #include <limits>
 
-void Scene::init()
+void Scene::init(const SceneDesc &sceneDesc, const AssetPack *pack)
 {
+    PROFILE_SCOPE("Scene::init");
+    desc = sceneDesc;
+    stops = desc.tourStops();
+    roomTransform = TransformSystem::get().create(); // identity
     initRoom();
-    initModels();
+    initModels(pack);
+    initLights();
     computeBounds();
+    std::cout << "Scene: " << desc.floors.size() << " rooms, " << models.size() << " exhibits, " << lights.size()
+              << " lights" << std::endl;
+}
+
+void Scene::initLights()
+{
+    lights = desc.lights;
+}
+
+namespace
+{
+    constexpr std::size_t MAX_DECODE_JOBS = 256;
+
+    // pos(3), normal(3), texcoords(2); doku 2 m'de bir tekrar eder (duvarda dikey 1 m)
+    void pushVertex(std::vector<float> &out, const glm::vec3 &p, const glm::vec3 &n, float u, float v)
+    {
+        out.insert(out.end(), {p.x, p.y, p.z, n.x, n.y, n.z, u, v});
+    }
+
+    void pushQuad(std::vector<float> &out, const glm::vec3 (&corners)[4], const glm::vec3 &n, const glm::vec2 (&uv)[4])
+    {
+        for (int i : {0, 1, 2, 0, 2, 3})
+            pushVertex(out, corners[i], n, uv[i].x, uv[i].y);
+    }
+
+    // Paketteki dokular işlerde açılır, bu thread'de yüklenir; Model'in
+    // loadTexture çağrıları sonra önbellekten döner
+    void uploadPackedTextures(const AssetPack &pack, const std::vector<ModelData> &imported)
+    {
+        std::vector<std::string> paths;
+        for (const ModelData &data : imported)
+        {
+            for (const ImportedMaterial &material : data.materials)
+            {
+                for (const std::string *path : {&material.diffuseTexture, &material.specularTexture})
+                {
+                    if (!path->empty() && pack.find(*path) &&
+                        std::find(paths.begin(), paths.end(), *path) == paths.end())
+                        paths.push_back(*path);
+                }
+            }
+        }
+
+        std::vector<TextureData> textures(paths.size());
+        std::vector<std::string> errors(paths.size());
+        // Doku başına bir iş; çok dokulu pakette iş sayısı MAX_DECODE_JOBS ile sınırlı
+        const std::size_t grain = std::max<std::size_t>(1, (paths.size() + MAX_DECODE_JOBS - 1) / MAX_DECODE_JOBS);
+        JobSystem::get().parallelFor(paths.size(), [&](std::size_t begin, std::size_t end)
+                                     {
+            for (std::size_t i = begin; i < end; ++i)
+                pack.loadTexture(paths[i], textures[i], errors[i]); }, grain);
+
+        MaterialLibrary &library = MaterialLibrary::get();
+        for (std::size_t i = 0; i < paths.size(); ++i)
+        {
+            if (!errors[i].empty())
+                std::cerr << "ERROR loading texture " << errors[i] << std::endl;
+            else
+                library.createTexture(paths[i], textures[i].pixels, textures[i].width, textures[i].height,
+                                      textures[i].components);
+        }
+    }
 }
 
 void Scene::initRoom()
 {
-    // Floor vertices: pos(3), normal(3), texcoords(2)
-    float floorVertices[] = {
-        -5.0f, 0.0f, -5.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f,
-        5.0f, 0.0f, -5.0f, 0.0f, 1.0f, 0.0f, 5.0f, 0.0f,
-        5.0f, 0.0f, 5.0f, 0.0f, 1.0f, 0.0f, 5.0f, 5.0f,
-        -5.0f, 0.0f, -5.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f,
-        5.0f, 0.0f, 5.0f, 0.0f, 1.0f, 0.0f, 5.0f, 5.0f,
-        -5.0f, 0.0f, 5.0f, 0.0f, 1.0f, 0.0f, 0.0f, 5.0f};
-    glGenVertexArrays(1, &floorVAO);
-    glGenBuffers(1, &floorVBO);
-    glBindVertexArray(floorVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, floorVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(floorVertices), floorVertices, GL_STATIC_DRAW);
+    std::vector<float> vertices;
+    for (const FloorDesc &floor : desc.floors)
+    {
+        const glm::vec2 size = floor.max - floor.min;
+        const glm::vec3 corners[4] = {{floor.min.x, 0.0f, floor.min.y},
+                                      {floor.max.x, 0.0f, floor.min.y},
+                                      {floor.max.x, 0.0f, floor.max.y},
+                                      {floor.min.x, 0.0f, floor.max.y}};
+        const glm::vec2 uv[4] = {{0.0f, 0.0f}, {size.x * 0.5f, 0.0f}, size * 0.5f, {0.0f, size.y * 0.5f}};
+        pushQuad(vertices, corners, glm::vec3(0.0f, 1.0f, 0.0f), uv);
+    }
+    for (const WallDesc &wall : desc.walls)
+    {
+        const glm::vec2 d = wall.to - wall.from;
+        const float length = glm::length(d);
+        if (length <= 0.0f || wall.top <= wall.bottom)
+            continue;
+        const glm::vec3 normal(d.y / length, 0.0f, -d.x / length);
+        const glm::vec3 corners[4] = {{wall.from.x, wall.bottom, wall.from.y},
+                                      {wall.to.x, wall.bottom, wall.to.y},
+                                      {wall.to.x, wall.top, wall.to.y},
+                                      {wall.from.x, wall.top, wall.from.y}};
+        const glm::vec2 uv[4] = {{0.0f, wall.bottom}, {length * 0.5f, wall.bottom}, {length * 0.5f, wall.top},
+                                 {0.0f, wall.top}};
+        pushQuad(vertices, corners, normal, uv);
+        if (wall.twoSided)
+        {
+            const glm::vec3 back[4] = {corners[1], corners[0], corners[3], corners[2]};
+            pushQuad(vertices, back, -normal, uv);
+        }
+    }
+    roomVertexCount = static_cast<int>(vertices.size() / 8);
+
+    glGenVertexArrays(1, &roomVAO);
+    glGenBuffers(1, &roomVBO);
+    glBindVertexArray(roomVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, roomVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    RenderCounters::trackBuffer(static_cast<std::int64_t>(vertices.size() * sizeof(float)));
     // attrib 0: position
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void *)0);
     glEnableVertexAttribArray(0);
@@ -37,99 +133,156 @@ void Scene::initRoom()
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void *)(6 * sizeof(float)));
     glEnableVertexAttribArray(2);
     glBindVertexArray(0);
-
-    // Walls: four walls around floor
-    std::array<glm::vec3, 4> wallNormals = {
-        glm::vec3(0, 0, 1),  // back wall
-        glm::vec3(1, 0, 0),  // left wall
-        glm::vec3(0, 0, -1), // front wall
-        glm::vec3(-1, 0, 0)  // right wall
-    };
-    std::array<glm::vec3, 4> wallPositions = {
-        glm::vec3(0, 0, -5),
-        glm::vec3(-5, 0, 0),
-        glm::vec3(0, 0, 5),
-        glm::vec3(5, 0, 0)};
-    for (int i = 0; i < 4; ++i)
-    {
-        float nx = wallNormals[i].x;
-        float nz = wallNormals[i].z;
-        // vertical plane size 10x3
-        float wallVertices[] = {
-            -5.0f * nz + wallPositions[i].x, 0.0f, -5.0f * nx + wallPositions[i].z, nx, 0.0f, nz, 0.0f, 0.0f,
-            5.0f * nz + wallPositions[i].x, 0.0f, 5.0f * nx + wallPositions[i].z, nx, 0.0f, nz, 5.0f, 0.0f,
-            5.0f * nz + wallPositions[i].x, 3.0f, 5.0f * nx + wallPositions[i].z, nx, 0.0f, nz, 5.0f, 3.0f,
-            -5.0f * nz + wallPositions[i].x, 0.0f, -5.0f * nx + wallPositions[i].z, nx, 0.0f, nz, 0.0f, 0.0f,
-            5.0f * nz + wallPositions[i].x, 3.0f, 5.0f * nx + wallPositions[i].z, nx, 0.0f, nz, 5.0f, 3.0f,
-            -5.0f * nz + wallPositions[i].x, 3.0f, -5.0f * nx + wallPositions[i].z, nx, 0.0f, nz, 0.0f, 3.0f};
-        glGenVertexArrays(1, &wallVAO[i]);
-        glGenBuffers(1, &wallVBO[i]);
-        glBindVertexArray(wallVAO[i]);
-        glBindBuffer(GL_ARRAY_BUFFER, wallVBO[i]);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(wallVertices), wallVertices, GL_STATIC_DRAW);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void *)0);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void *)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void *)(6 * sizeof(float)));
-        glEnableVertexAttribArray(2);
-        glBindVertexArray(0);
-    }
 }
 
-void Scene::initModels()
+void Scene::initModels(const AssetPack *pack)
 {
-    std::vector<std::string> modelPaths = {
-        "models/heykel.obj",
-        "models/manstatue.obj",
-        "models/modelleme.obj",
-        "models/roma_mezar_modelleme.obj",
-        "models/roma_yeni.obj"};
-    std::vector<glm::vec3> positions = {
-        {2.0f, 0.0f, 3.0f},
-        {-3.0f, 0.0f, 1.0f},
-        {0.0f, 0.0f, -2.5f},
-        {4.0f, 0.0f, -1.0f},
-        {-1.5f, 0.0f, -3.5f}};
+    PROFILE_SCOPE("Scene::initModels");
     models.clear(); // Ensure we start with empty models
-    for (size_t i = 0; i < modelPaths.size(); ++i)
+
+    // Dosya okuma + Assimp işleme paralel; GL nesneleri bu thread'de.
+    // Her dosya bir kez yüklenir, eserler onun instance'larıdır.
+    JobSystem &jobs = JobSystem::get();
+    const std::size_t modelCount = desc.models.size();
+    std::vector<ModelData> imported(modelCount);
+    std::vector<std::string> errors(modelCount);
+    std::vector<ImportStats> stats(modelCount);
+    JobCounter loading{0};
+    for (size_t i = 0; i < modelCount; ++i)
     {
-        try
-        {
-            Model model(modelPaths[i]);
-            model.setUniformScale(1.8f); // örnek: her heykeli 1.8 m yüksekliğe göre ölçekle
-            model.autoGround(0.0f);      // tabanı zemine yasla
-            model.setPosition(positions[i]);
-            models.push_back(model);
-            std::cout << "Loaded model: " << modelPaths[i] << std::endl;
-        }
-        catch (const std::exception &e)
+        jobs.run([this, pack, &imported, &errors, &stats, i]
+                 {
+            const std::string &path = desc.models[i].path;
+            try
+            {
+                // Pakette pişmiş model: ayrıştırma yok, diziler doğrudan açılır
+                if (pack && pack->find(path))
+                    pack->loadModel(path, imported[i], errors[i]);
+                else
+                    imported[i] = Model::import(path, desc.models[i].import, &stats[i]);
+            }
+            catch (const std::exception &e)
+            {
+                errors[i] = e.what();
+            } },
+                 &loading);
+    }
+    jobs.wait(loading);
+    if (pack)
+        uploadPackedTextures(*pack, imported);
+
+    std::vector<Model> prototypes;
+    std::vector<int> prototypeOf(modelCount, -1);
+    for (size_t i = 0; i < modelCount; ++i)
+    {
+        if (!errors[i].empty())
         {
-            std::cerr << "ERROR loading model " << modelPaths[i] << ": " << e.what() << std::endl;
+            std::cerr << "ERROR loading model " << desc.models[i].path << ": " << errors[i] << std::endl;
+            continue;
         }
+        prototypeOf[i] = static_cast<int>(prototypes.size());
+        prototypes.emplace_back(std::move(imported[i]));
+        const ImportStats &s = stats[i];
+        if (s.verticesIn == 0) // paketten, pişmiş
+            std::cout << "Loaded model: " << desc.models[i].path << std::endl;
+        else
+            std::cout << "Loaded model: " << desc.models[i].path << " (" << s.verticesOut << " vertices from "
+                      << s.verticesIn << ", " << s.totalMs << " ms: parse " << s.parseMs << ", normals "
+                      << s.normalsMs << ", weld " << s.weldMs << ")" << std::endl;
     }
+
+    models.reserve(desc.exhibits.size());
+    modelExhibits.clear();
+    for (std::size_t e = 0; e < desc.exhibits.size(); ++e)
+    {
+        const ExhibitDesc &exhibit = desc.exhibits[e];
+        if (exhibit.model >= modelCount || prototypeOf[exhibit.model] < 0)
+            continue;
+        Model model = prototypes[prototypeOf[exhibit.model]].instance();
+        place(model, exhibit);
+        models.push_back(model);
+        modelExhibits.push_back(static_cast<std::uint32_t>(e));
+    }
+}
+
+void Scene::place(Model &model, const ExhibitDesc &exhibit)
+{
+    // Yerel sınırlardan: yükseklik eserinkine ölçeklenir, taban zemine yaslanır
+    model.setUniformScale(exhibit.height);
+    model.setYaw(exhibit.yaw);
+    model.setPosition(glm::vec3(exhibit.position.x, 0.0f, exhibit.position.y));
+    model.autoGround(0.0f);
 }
 
-void Scene::draw(Shader &shader)
+bool Scene::reloadModel(ModelData &&data, ModelReloadStats &stats)
 {
-    // Draw floor
-    shader.setMat4("model", glm::mat4(1.0f));
-    glBindVertexArray(floorVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    // İlk eser yeni veriyi alır, aynı dosyanın diğer eserleri onun mesh'lerini paylaşır
+    const std::string path = data.path;
+    const Model *reloaded = nullptr;
+    for (std::size_t i = 0; i < models.size(); ++i)
+    {
+        const ExhibitDesc &exhibit = desc.exhibits[modelExhibits[i]];
+        if (desc.models[exhibit.model].path != path)
+            continue;
+        if (reloaded)
+            models[i].shareMeshes(*reloaded);
+        else
+        {
+            models[i].reload(std::move(data), stats);
+            reloaded = &models[i];
+        }
+        place(models[i], exhibit); // yeni sınırlar: ölçek ve zemin yeniden
+    }
+    if (!reloaded)
+        return false;
 
-    // Draw walls
-    for (int i = 0; i < 4; ++i)
+    // Aynı frame sınırında: GL tarafı hemen, ana thread sonraki culling'de
+    computeBounds();
     {
-        glBindVertexArray(wallVAO[i]);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        std::lock_guard<std::mutex> lock(publishMutex);
+        publishedBounds = modelBounds;
     }
+    boundsVersion.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+bool Scene::pollModelBounds(std::vector<glm::vec4> &bounds, std::uint64_t &version) const
+{
+    if (boundsVersion.load(std::memory_order_acquire) == version)
+        return false;
+    std::lock_guard<std::mutex> lock(publishMutex);
+    bounds = publishedBounds;
+    version = boundsVersion.load(std::memory_order_relaxed);
+    return true;
+}
+
+void Scene::draw(Shader &shader, const std::vector<std::uint32_t> *visibleModels)
+{
+    PROFILE_SCOPE("Scene::draw");
+    // Önceki frame'den (ImGui vb.) kalan bağlamalara güvenme
+    MaterialLibrary &materials = MaterialLibrary::get();
+    materials.resetBindings();
+
+    // Zemin ve duvarlar
+    materials.bind(DEFAULT_MATERIAL, shader);
+    TransformSystem::get().setDraw(roomTransform, shader);
+    glBindVertexArray(roomVAO);
+    glDrawArrays(GL_TRIANGLES, 0, roomVertexCount);
+    RenderCounters::stateChange();
+    RenderCounters::draw(roomVertexCount / 3);
 
     // Draw models - FIXED: Only draw if we have models
     if (!models.empty())
     {
-        for (auto &model : models)
+        if (visibleModels)
         {
-            model.draw(shader);
+            for (std::uint32_t index : *visibleModels)
+                models[index].draw(shader);
+        }
+        else
+        {
+            for (auto &model : models)
+                model.draw(shader);
         }
     }
     else
@@ -138,6 +291,27 @@ void Scene::draw(Shader &shader)
     }
 }
 
+void Scene::drawDepth(Shader &shader, const std::vector<std::uint32_t> *visibleModels)
+{
+    PROFILE_SCOPE("Scene::drawDepth");
+    TransformSystem::get().setDraw(roomTransform, shader);
+    glBindVertexArray(roomVAO);
+    glDrawArrays(GL_TRIANGLES, 0, roomVertexCount);
+    RenderCounters::stateChange();
+    RenderCounters::draw(roomVertexCount / 3);
+    if (visibleModels)
+    {
+        for (std::uint32_t index : *visibleModels)
+            models[index].drawDepth(shader);
+    }
+    else
+    {
+        for (auto &model : models)
+            model.drawDepth(shader);
+    }
+    glBindVertexArray(0);
+}
+
 /*void Scene::getSceneBounds(glm::vec3 &center, float &radius) const
 {
     // 1) Önce AABB min/max değerleri hazırla
@@ -152,7 +326,7 @@ void Scene::draw(Shader &shader)
 
         for (const auto &mesh : model.getMeshes())
         {
-            for (const auto &v : mesh.vertices)
+            for (const auto &v : mesh.geometry.vertices)
             {
                 // vertex’i dünya koordinatına taşı
                 glm::vec3 worldPos = glm::vec3(modelMatrix * glm::vec4(v.Position, 1.0f));
@@ -169,23 +343,36 @@ void Scene::draw(Shader &shader)
 
 void Scene::computeBounds()
 {
+    PROFILE_SCOPE("Scene::computeBounds");
     glm::vec3 bbMin(std::numeric_limits<float>::max());
     glm::vec3 bbMax(-std::numeric_limits<float>::max());
+    modelBounds.clear();
+    modelBounds.reserve(models.size());
 
+    // Instance başına köşe dönüşümü: yerel AABB import sırasında (SIMD) bulundu,
+    // binlerce eser için vertex'leri yeniden dolaşmak gerekmez. Yalnız Y dönüşü
+    // olduğundan kutu en fazla sqrt(2) kat gevşer.
     for (const auto &model : models)
     {
-        // Model sınıfınız world‑transform veriyorsa kullanın; yoksa identity.
-        glm::mat4 M = model.getTransformMatrix(); // ← kendi API’nıza uyarlayın
-
-        for (const auto &mesh : model.getMeshes())
+        const glm::mat4 M = model.getTransformMatrix();
+        glm::vec3 localMin, localMax;
+        model.getLocalBounds(localMin, localMax);
+        glm::vec3 worldMin(std::numeric_limits<float>::max());
+        glm::vec3 worldMax(-std::numeric_limits<float>::max());
+        for (int corner = 0; corner < 8; ++corner)
         {
-            for (const auto &v : mesh.vertices)
-            {
-                glm::vec3 worldPos = glm::vec3(M * glm::vec4(v.Position, 1.0f));
-                bbMin = glm::min(bbMin, worldPos);
-                bbMax = glm::max(bbMax, worldPos);
-            }
+            const glm::vec3 local(corner & 1 ? localMax.x : localMin.x, corner & 2 ? localMax.y : localMin.y,
+                                  corner & 4 ? localMax.z : localMin.z);
+            const glm::vec3 world(M * glm::vec4(local, 1.0f));
+            worldMin = glm::min(worldMin, world);
+            worldMax = glm::max(worldMax, world);
         }
+
+        // Culling için dünya uzayında sınır küresi
+        glm::vec3 center = (worldMin + worldMax) * 0.5f;
+        modelBounds.push_back(glm::vec4(center, glm::length(worldMax - center)));
+        bbMin = glm::min(bbMin, worldMin);
+        bbMax = glm::max(bbMax, worldMax);
     }
 
     // Eğer hiç model yoksa, odanın sınırlarını kullanabilirsiniz (isteğe bağlı)
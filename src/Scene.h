@@ -1,37 +1,83 @@
 #ifndef SCENE_H
 #define SCENE_H
 
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <glm/glm.hpp>
 #include "Shader.h"
 #include "Model.h"
+#include "Lights.h"
+#include "SceneDesc.h"
+#include "AssetPack.h"
 #include <glad/glad.h>
 
 class Scene
 {
 public:
-    void init();
-    void draw(Shader &shader);
+    // pack: models and textures found in it are read from there instead of
+    // the loose files; it only has to stay mounted during init
+    void init(const SceneDesc &desc, const AssetPack *pack = nullptr);
+    // visibleModels: indices into the model list (see getModelBounds);
+    // nullptr draws every model. Room geometry is always drawn.
+    void draw(Shader &shader, const std::vector<std::uint32_t> *visibleModels = nullptr);
+    void drawDepth(Shader &shader, const std::vector<std::uint32_t> *visibleModels = nullptr);
+
+    const SceneDesc &getDesc() const { return desc; }
+    // Exhibit positions at robot height, used as auto tour waypoints
+    const std::vector<glm::vec3> &tourStops() const { return stops; }
+
+    const std::vector<SpotLight> &getLights() const { return lights; }
+    void setLights(const std::vector<SpotLight> &newLights) { lights = newLights; }
 
     void getSceneBounds(glm::vec3 &center, float &radius) const
     {
         center = sceneCenter;
         radius = sceneRadius;
     }
+    // World-space bounding sphere per model (xyz center, w radius); owned by
+    // the GL thread once rendering runs, see pollModelBounds
+    const std::vector<glm::vec4> &getModelBounds() const { return modelBounds; }
+    // Main thread: copies the bounds into 'bounds' if a hot reload published
+    // newer ones than 'version' (starts at 0, init's bounds). One atomic load
+    // when nothing changed.
+    bool pollModelBounds(std::vector<glm::vec4> &bounds, std::uint64_t &version) const;
+
+    // Hot reload, GL thread between frames: every exhibit showing data.path
+    // switches to the new meshes and is re-scaled and re-grounded from the
+    // new bounds, which are then published for pollModelBounds. False if no
+    // exhibit uses that model.
+    bool reloadModel(ModelData &&data, ModelReloadStats &stats);
 
 private:
-    unsigned int floorVAO = 0, floorVBO = 0;
-    unsigned int wallVAO[4] = {0}, wallVBO[4] = {0};
+    SceneDesc desc;
+    std::vector<glm::vec3> stops;
 
-    std::vector<Model> models;
+    // Tüm zemin ve duvarlar tek bir tamponda, tek çizim
+    unsigned int roomVAO = 0, roomVBO = 0;
+    int roomVertexCount = 0;
+
+    std::vector<Model> models; // eser başına bir instance
+    std::vector<std::uint32_t> modelExhibits; // models[i] -> desc.exhibits indeksi
+    std::vector<SpotLight> lights;
+    TransformHandle roomTransform = 0;
 
     void initRoom();
-    void initModels();
+    void initModels(const AssetPack *pack);
+    void initLights();
+    void place(Model &model, const ExhibitDesc &exhibit);
 
     void computeBounds();
     glm::vec3 sceneCenter{0.0f};
     float sceneRadius = 1.0f;
+    std::vector<glm::vec4> modelBounds;
+
+    // Ana thread'in culling kopyası için yayınlanan sınırlar
+    mutable std::mutex publishMutex;
+    std::vector<glm::vec4> publishedBounds;
+    std::atomic<std::uint64_t> boundsVersion{0};
 };
 
 #endif
@@ -0,0 +1,34 @@
+// SceneDesc.cpp
+#include "SceneDesc.h"
+#include <cmath>
+
+std::vector<glm::vec3> SceneDesc::tourStops() const
+{
+    std::vector<glm::vec3> stops;
+    if (!tour.empty())
+    {
+        for (const glm::vec2 &stop : tour)
+            stops.push_back(glm::vec3(stop.x, TOUR_HEIGHT, stop.y));
+        return stops;
+    }
+    stops.reserve(exhibits.size());
+    for (const ExhibitDesc &exhibit : exhibits)
+        stops.push_back(glm::vec3(exhibit.position.x, TOUR_HEIGHT, exhibit.position.y));
+    return stops;
+}
+
+SpotLight ceilingSpot(const glm::vec3 &position)
+{
+    SpotLight light;
+    light.position = position;
+    light.direction = glm::vec3(0.0f, -1.0f, 0.0f);
+    light.cutOff = std::cos(glm::radians(12.5f));
+    light.outerCutOff = std::cos(glm::radians(17.5f));
+    light.ambient = glm::vec3(0.2f);
+    light.diffuse = glm::vec3(0.6f);
+    light.specular = glm::vec3(1.0f);
+    light.constant = 1.0f;
+    light.linear = 0.09f;
+    light.quadratic = 0.032f;
+    return light;
+}
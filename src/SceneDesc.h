@@ -0,0 +1,71 @@
+// SceneDesc.h
+#ifndef SCENEDESC_H
+#define SCENEDESC_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include "ImportProfile.h"
+#include "Lights.h"
+
+// Everything Scene::init builds, as plain data: room geometry, exhibit
+// placements, lights and the tour. Loaded from a scene file (SceneFile.h;
+// the museum itself is scenes/museum.scene) or built by MuseumGenerator.
+// Ground plane is XZ, y up.
+
+// Robot centre height: tour waypoints are at this y
+constexpr float TOUR_HEIGHT = 0.5f;
+
+struct ModelDesc
+{
+    std::string path;
+    std::string info; // tur sırasında gösterilen açıklama
+    ImportProfile import;
+};
+
+// Floor rectangle at y = 0
+struct FloorDesc
+{
+    glm::vec2 min, max;
+};
+
+// Vertical quad from 'from' to 'to' (XZ), between bottom and top. With
+// d = to - from the front face normal is (d.y, 0, -d.x); two-sided walls
+// (shared between rooms) get a back face as well.
+struct WallDesc
+{
+    glm::vec2 from, to;
+    float bottom = 0.0f, top = 3.0f;
+    bool twoSided = false;
+};
+
+// One instance of models[model], scaled to height and grounded at y = 0
+struct ExhibitDesc
+{
+    std::uint32_t model = 0;
+    glm::vec2 position{0.0f};
+    float yaw = 0.0f; // radians about +Y
+    float height = 1.8f;
+};
+
+struct SceneDesc
+{
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> metadata; // serbest anahtar / değer
+    std::vector<ModelDesc> models;
+    std::vector<FloorDesc> floors;
+    std::vector<WallDesc> walls;
+    std::vector<ExhibitDesc> exhibits; // tur sırası
+    std::vector<SpotLight> lights;
+    std::vector<glm::vec2> tour; // boşsa eser sırası
+
+    // Auto tour waypoints at robot height: the tour route, else every exhibit
+    std::vector<glm::vec3> tourStops() const;
+};
+
+// Ceiling spot pointing straight down, the museum's standard fixture
+SpotLight ceilingSpot(const glm::vec3 &position);
+
+#endif // SCENEDESC_H
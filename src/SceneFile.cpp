@@ -0,0 +1,736 @@
+// SceneFile.cpp
+#include "SceneFile.h"
+#include "MappedFile.h"
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <type_traits>
+#include <unordered_map>
+
+namespace
+{
+    // ---------- İkili biçim ---------------------------------------------
+    constexpr char MAGIC[4] = {'V', 'M', 'S', 'C'};
+    constexpr std::uint32_t VERSION = 2; // 2: modellerde import profili
+    constexpr std::uint32_t ENDIAN_TAG = 0x01020304; // ters okunursa dosya başka bayt sırasında
+    constexpr std::uint32_t WALL_TWO_SIDED = 1u << 0;
+    constexpr std::uint32_t IMPORT_FLIP_UVS = 1u << 0;
+    constexpr std::uint32_t IMPORT_WELD = 1u << 1;
+
+    struct Section
+    {
+        std::uint32_t offset, count; // dosya başından bayt; kayıt sayısı (dizgelerde bayt)
+    };
+
+    struct Header
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t size; // tüm dosya
+        std::uint32_t name; // dizge ofseti
+        Section strings, metadata, models, floors, walls, exhibits, lights, tour;
+    };
+
+    struct MetaRecord
+    {
+        std::uint32_t key, value;
+    };
+    struct ModelRecord
+    {
+        std::uint32_t path, info;
+        float weldTolerance, creaseAngle;
+        std::uint32_t normals, texCoords, flags; // NormalMode, TexCoordMode, IMPORT_*
+    };
+    struct FloorRecord
+    {
+        float minX, minZ, maxX, maxZ;
+    };
+    struct WallRecord
+    {
+        float fromX, fromZ, toX, toZ, bottom, top;
+        std::uint32_t flags;
+    };
+    struct ExhibitRecord
+    {
+        std::uint32_t model;
+        float x, z, yaw, height;
+    };
+    struct StopRecord
+    {
+        float x, z;
+    };
+
+    // Tekrarlanan dizgeler bir kez yazılır; 0 ofseti boş dizge
+    class StringBlob
+    {
+    public:
+        StringBlob() : bytes(1, '\0') {}
+        std::uint32_t add(const std::string &str)
+        {
+            if (str.empty())
+                return 0;
+            auto it = offsets.find(str);
+            if (it != offsets.end())
+                return it->second;
+            const std::uint32_t offset = static_cast<std::uint32_t>(bytes.size());
+            bytes.insert(bytes.end(), str.begin(), str.end());
+            bytes.push_back('\0');
+            offsets.emplace(str, offset);
+            return offset;
+        }
+        const std::vector<char> &data() const { return bytes; }
+
+    private:
+        std::vector<char> bytes;
+        std::unordered_map<std::string, std::uint32_t> offsets;
+    };
+
+    template <typename T>
+    Section appendSection(std::vector<unsigned char> &out, const T *records, std::size_t count)
+    {
+        out.resize((out.size() + 7) & ~std::size_t(7), 0);
+        Section section{static_cast<std::uint32_t>(out.size()), static_cast<std::uint32_t>(count)};
+        if (count)
+        {
+            out.resize(out.size() + count * sizeof(T));
+            std::memcpy(out.data() + section.offset, records, count * sizeof(T));
+        }
+        return section;
+    }
+
+    // ---------- Metin biçimi --------------------------------------------
+    // Satırı boşluklardan böler; çift tırnak içi tek parça (\" ve \\ kaçışlı), # sonrası yorum
+    bool tokenize(const char *begin, const char *end, std::vector<std::string> &tokens, std::string &error)
+    {
+        tokens.clear();
+        const char *p = begin;
+        while (p < end)
+        {
+            if (*p == ' ' || *p == '\t' || *p == '\r')
+            {
+                ++p;
+                continue;
+            }
+            if (*p == '#')
+                break;
+            std::string token;
+            if (*p == '"')
+            {
+                ++p;
+                while (p < end && *p != '"')
+                {
+                    if (*p == '\\' && p + 1 < end)
+                        ++p;
+                    token += *p++;
+                }
+                if (p == end)
+                {
+                    error = "unterminated string";
+                    return false;
+                }
+                ++p;
+            }
+            else
+            {
+                while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '#')
+                    token += *p++;
+            }
+            tokens.push_back(std::move(token));
+        }
+        return true;
+    }
+
+    bool toFloat(const std::string &token, float &value)
+    {
+        char *end = nullptr;
+        value = std::strtof(token.c_str(), &end);
+        return end != token.c_str() && *end == '\0' && std::isfinite(value);
+    }
+
+    // import satırındaki değerler; enum sırasıyla
+    const char *const NORMAL_MODES[] = {"keep", "missing", "smooth", "flat"};
+    const char *const TEXCOORD_MODES[] = {"auto", "keep", "drop"};
+
+    template <std::size_t N>
+    bool lookup(const char *const (&names)[N], const std::string &value, unsigned &index)
+    {
+        for (index = 0; index < N; ++index)
+            if (value == names[index])
+                return true;
+        return false;
+    }
+
+    // "key=value" seçenekleri; hata mesajı boşsa geçerli
+    std::string parseImportOption(const std::string &option, ImportProfile &profile)
+    {
+        const std::size_t equals = option.find('=');
+        if (equals == std::string::npos)
+            return "import: expected key=value, got '" + option + "'";
+        const std::string key = option.substr(0, equals), value = option.substr(equals + 1);
+        unsigned index = 0;
+        float number = 0.0f;
+        if (key == "weld" && value == "off")
+            profile.weld = false;
+        else if (key == "weld" && toFloat(value, number))
+        {
+            profile.weld = true;
+            profile.weldTolerance = number;
+        }
+        else if (key == "normals" && lookup(NORMAL_MODES, value, index))
+            profile.normals = static_cast<NormalMode>(index);
+        else if (key == "crease" && toFloat(value, number))
+            profile.creaseAngle = number;
+        else if (key == "uvs" && lookup(TEXCOORD_MODES, value, index))
+            profile.texCoords = static_cast<TexCoordMode>(index);
+        else if (key == "flipuv" && (value == "on" || value == "off"))
+            profile.flipUVs = value == "on";
+        else
+            return "import: bad option '" + option + "'";
+        return std::string();
+    }
+
+    // Sadece varsayılandan farklı olanlar
+    std::string formatImportOptions(const ImportProfile &profile)
+    {
+        const ImportProfile defaults;
+        char number[32];
+        std::string out;
+        if (profile.weld != defaults.weld || profile.weldTolerance != defaults.weldTolerance)
+        {
+            std::snprintf(number, sizeof(number), "%.7g", profile.weldTolerance);
+            out += profile.weld ? std::string(" weld=") + number : std::string(" weld=off");
+        }
+        if (profile.normals != defaults.normals)
+            out += std::string(" normals=") + NORMAL_MODES[static_cast<unsigned>(profile.normals)];
+        if (profile.creaseAngle != defaults.creaseAngle)
+        {
+            std::snprintf(number, sizeof(number), "%.7g", profile.creaseAngle);
+            out += std::string(" crease=") + number;
+        }
+        if (profile.texCoords != defaults.texCoords)
+            out += std::string(" uvs=") + TEXCOORD_MODES[static_cast<unsigned>(profile.texCoords)];
+        if (profile.flipUVs != defaults.flipUVs)
+            out += profile.flipUVs ? " flipuv=on" : " flipuv=off";
+        return out;
+    }
+
+    std::string quote(const std::string &str)
+    {
+        std::string out = "\"";
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+                out += '\\';
+            out += c;
+        }
+        return out + '"';
+    }
+
+    // Metinde modeller isimle anılır: dosya adından, çakışırsa _2, _3...
+    std::vector<std::string> modelIds(const std::vector<ModelDesc> &models)
+    {
+        std::vector<std::string> ids;
+        std::unordered_map<std::string, int> used;
+        for (const ModelDesc &model : models)
+        {
+            std::string stem = model.path.substr(model.path.find_last_of("/\\") + 1);
+            stem = stem.substr(0, stem.find('.'));
+            for (char &c : stem)
+                if (!std::isalnum(static_cast<unsigned char>(c)))
+                    c = '_';
+            if (stem.empty())
+                stem = "model";
+            const int n = ++used[stem];
+            ids.push_back(n == 1 ? stem : stem + "_" + std::to_string(n));
+        }
+        return ids;
+    }
+
+    // Zemin + dört iç duvar (kapısız); ters saat yönünde köşeler, duvarlar içe bakar
+    void addRoom(SceneDesc &desc, glm::vec2 lo, glm::vec2 hi, float height)
+    {
+        desc.floors.push_back({lo, hi});
+        const glm::vec2 corners[4] = {{lo.x, lo.y}, {hi.x, lo.y}, {hi.x, hi.y}, {lo.x, hi.y}};
+        for (int side = 0; side < 4; ++side)
+            desc.walls.push_back({corners[(side + 1) % 4], corners[side], 0.0f, height, false});
+    }
+
+    bool allFinite(std::initializer_list<float> values)
+    {
+        for (float v : values)
+            if (!std::isfinite(v))
+                return false;
+        return true;
+    }
+}
+
+bool validateScene(const SceneDesc &desc, std::string &error)
+{
+    auto fail = [&](const char *kind, std::size_t index, const char *what)
+    {
+        error = std::string(kind) + " " + std::to_string(index) + ": " + what;
+        return false;
+    };
+    for (std::size_t i = 0; i < desc.models.size(); ++i)
+    {
+        const ModelDesc &m = desc.models[i];
+        if (m.path.empty())
+            return fail("model", i, "empty path");
+        if (!allFinite({m.import.weldTolerance, m.import.creaseAngle}))
+            return fail("model", i, "non-finite import value");
+        if (!(m.import.weldTolerance >= 0.0f && m.import.weldTolerance < 1.0f))
+            return fail("model", i, "weld tolerance must be in [0, 1)");
+        if (!(m.import.creaseAngle >= 0.0f && m.import.creaseAngle <= 180.0f))
+            return fail("model", i, "crease angle must be in [0, 180]");
+    }
+    for (std::size_t i = 0; i < desc.floors.size(); ++i)
+    {
+        const FloorDesc &f = desc.floors[i];
+        if (!allFinite({f.min.x, f.min.y, f.max.x, f.max.y}))
+            return fail("floor", i, "non-finite coordinate");
+        if (!(f.min.x < f.max.x && f.min.y < f.max.y))
+            return fail("floor", i, "empty rectangle");
+    }
+    for (std::size_t i = 0; i < desc.walls.size(); ++i)
+    {
+        const WallDesc &w = desc.walls[i];
+        if (!allFinite({w.from.x, w.from.y, w.to.x, w.to.y, w.bottom, w.top}))
+            return fail("wall", i, "non-finite coordinate");
+        if (w.from == w.to || !(w.bottom < w.top))
+            return fail("wall", i, "zero length or height");
+    }
+    for (std::size_t i = 0; i < desc.exhibits.size(); ++i)
+    {
+        const ExhibitDesc &e = desc.exhibits[i];
+        if (e.model >= desc.models.size())
+            return fail("exhibit", i, "model index out of range");
+        if (!allFinite({e.position.x, e.position.y, e.yaw, e.height}))
+            return fail("exhibit", i, "non-finite value");
+        if (!(e.height > 0.0f))
+            return fail("exhibit", i, "height must be positive");
+    }
+    for (std::size_t i = 0; i < desc.lights.size(); ++i)
+    {
+        const SpotLight &l = desc.lights[i];
+        if (!allFinite({l.position.x, l.position.y, l.position.z, l.direction.x, l.direction.y, l.direction.z,
+                        l.cutOff, l.outerCutOff, l.diffuse.x, l.diffuse.y, l.diffuse.z}))
+            return fail("light", i, "non-finite value");
+        if (glm::length(l.direction) < 1e-6f)
+            return fail("light", i, "zero direction");
+        // Açılar kosinüs olarak: iç koni daha dar => daha büyük kosinüs.
+        // Shader (cutOff - outerCutOff) ile böler
+        if (!(l.cutOff > l.outerCutOff))
+            return fail("light", i, "inner angle must be smaller than outer");
+    }
+    for (std::size_t i = 0; i < desc.tour.size(); ++i)
+        if (!allFinite({desc.tour[i].x, desc.tour[i].y}))
+            return fail("stop", i, "non-finite coordinate");
+    return true;
+}
+
+bool parseSceneText(const char *text, std::size_t size, SceneDesc &desc, std::string &error)
+{
+    desc = SceneDesc();
+    std::unordered_map<std::string, std::uint32_t> models;
+    std::vector<std::string> tokens;
+    std::size_t lineNumber = 0;
+    auto fail = [&](const std::string &message)
+    {
+        error = "line " + std::to_string(lineNumber) + ": " + message;
+        return false;
+    };
+
+    const char *cursor = text, *end = text + size;
+    while (cursor < end)
+    {
+        const char *lineEnd = static_cast<const char *>(std::memchr(cursor, '\n', end - cursor));
+        if (!lineEnd)
+            lineEnd = end;
+        ++lineNumber;
+        std::string tokenError;
+        if (!tokenize(cursor, lineEnd, tokens, tokenError))
+            return fail(tokenError);
+        cursor = lineEnd < end ? lineEnd + 1 : end;
+        if (tokens.empty())
+            continue;
+
+        const std::string &keyword = tokens[0];
+        const std::size_t args = tokens.size() - 1;
+        float v[11];
+        std::string badNumber;
+        auto numbers = [&](std::size_t first, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                if (!toFloat(tokens[first + i], v[i]))
+                {
+                    badNumber = keyword + ": expected a number, got '" + tokens[first + i] + "'";
+                    return false;
+                }
+            return true;
+        };
+
+        if (keyword == "scene")
+        {
+            if (args != 1)
+                return fail("scene: expected \"name\"");
+            desc.name = tokens[1];
+        }
+        else if (keyword == "meta")
+        {
+            if (args != 2)
+                return fail("meta: expected key \"value\"");
+            desc.metadata.emplace_back(tokens[1], tokens[2]);
+        }
+        else if (keyword == "model")
+        {
+            if (args < 2 || args > 3)
+                return fail("model: expected id path [\"info\"]");
+            if (!models.emplace(tokens[1], static_cast<std::uint32_t>(desc.models.size())).second)
+                return fail("model: duplicate id '" + tokens[1] + "'");
+            desc.models.push_back({tokens[2], args == 3 ? tokens[3] : std::string(), ImportProfile()});
+        }
+        else if (keyword == "import")
+        {
+            if (args < 2)
+                return fail("import: expected model key=value...");
+            auto model = models.find(tokens[1]);
+            if (model == models.end())
+                return fail("import: unknown model '" + tokens[1] + "'");
+            for (std::size_t i = 2; i <= args; ++i)
+            {
+                const std::string bad = parseImportOption(tokens[i], desc.models[model->second].import);
+                if (!bad.empty())
+                    return fail(bad);
+            }
+        }
+        else if (keyword == "room")
+        {
+            if (args != 5)
+                return fail("room: expected x0 z0 x1 z1 height");
+            if (!numbers(1, 5))
+                return fail(badNumber);
+            addRoom(desc, glm::vec2(v[0], v[1]), glm::vec2(v[2], v[3]), v[4]);
+        }
+        else if (keyword == "floor")
+        {
+            if (args != 4)
+                return fail("floor: expected x0 z0 x1 z1");
+            if (!numbers(1, 4))
+                return fail(badNumber);
+            desc.floors.push_back({glm::vec2(v[0], v[1]), glm::vec2(v[2], v[3])});
+        }
+        else if (keyword == "wall")
+        {
+            if (args < 6 || args > 7 || (args == 7 && tokens[7] != "two-sided"))
+                return fail("wall: expected x0 z0 x1 z1 bottom top [two-sided]");
+            if (!numbers(1, 6))
+                return fail(badNumber);
+            desc.walls.push_back({glm::vec2(v[0], v[1]), glm::vec2(v[2], v[3]), v[4], v[5], args == 7});
+        }
+        else if (keyword == "exhibit")
+        {
+            if (args < 3 || args > 5)
+                return fail("exhibit: expected model x z [yaw [height]]");
+            auto model = models.find(tokens[1]);
+            if (model == models.end())
+                return fail("exhibit: unknown model '" + tokens[1] + "'");
+            if (!numbers(2, args - 1))
+                return fail(badNumber);
+            ExhibitDesc exhibit;
+            exhibit.model = model->second;
+            exhibit.position = glm::vec2(v[0], v[1]);
+            if (args >= 4)
+                exhibit.yaw = glm::radians(v[2]);
+            if (args == 5)
+                exhibit.height = v[3];
+            desc.exhibits.push_back(exhibit);
+        }
+        else if (keyword == "light")
+        {
+            if (args != 3 && args != 6 && args != 8 && args != 11)
+                return fail("light: expected x y z [dx dy dz [inner outer [r g b]]]");
+            if (!numbers(1, args))
+                return fail(badNumber);
+            SpotLight light = ceilingSpot(glm::vec3(v[0], v[1], v[2]));
+            if (args >= 6)
+                light.direction = glm::vec3(v[3], v[4], v[5]);
+            if (args >= 8)
+            {
+                light.cutOff = std::cos(glm::radians(v[6]));
+                light.outerCutOff = std::cos(glm::radians(v[7]));
+            }
+            if (args == 11)
+                light.diffuse = glm::vec3(v[8], v[9], v[10]);
+            desc.lights.push_back(light);
+        }
+        else if (keyword == "stop")
+        {
+            if (args != 2)
+                return fail("stop: expected x z");
+            if (!numbers(1, 2))
+                return fail(badNumber);
+            desc.tour.push_back(glm::vec2(v[0], v[1]));
+        }
+        else
+            return fail("unknown entry '" + keyword + "'");
+    }
+    return validateScene(desc, error);
+}
+
+std::string formatSceneText(const SceneDesc &desc)
+{
+    std::string out = "# Virtual Museum scene (see src/SceneFile.h for the format)\n";
+    char line[256];
+    auto emit = [&](const char *format, auto... values)
+    {
+        std::snprintf(line, sizeof(line), format, values...);
+        out += line;
+    };
+    if (!desc.name.empty())
+        out += "scene " + quote(desc.name) + "\n";
+    for (const auto &entry : desc.metadata)
+        out += "meta " + quote(entry.first) + " " + quote(entry.second) + "\n";
+
+    const std::vector<std::string> ids = modelIds(desc.models);
+    out += "\n";
+    for (std::size_t i = 0; i < desc.models.size(); ++i)
+        out += "model " + ids[i] + " " + quote(desc.models[i].path) + " " + quote(desc.models[i].info) + "\n";
+    for (std::size_t i = 0; i < desc.models.size(); ++i)
+        if (desc.models[i].import != ImportProfile())
+            out += "import " + ids[i] + formatImportOptions(desc.models[i].import) + "\n";
+
+    out += "\n";
+    for (const FloorDesc &f : desc.floors)
+        emit("floor %.7g %.7g %.7g %.7g\n", f.min.x, f.min.y, f.max.x, f.max.y);
+    for (const WallDesc &w : desc.walls)
+        emit("wall %.7g %.7g %.7g %.7g %.7g %.7g%s\n", w.from.x, w.from.y, w.to.x, w.to.y, w.bottom, w.top,
+             w.twoSided ? " two-sided" : "");
+
+    out += "\n";
+    for (const ExhibitDesc &e : desc.exhibits)
+    {
+        out += "exhibit " + ids[e.model];
+        emit(" %.7g %.7g %.7g %.7g\n", e.position.x, e.position.y, glm::degrees(e.yaw), e.height);
+    }
+
+    // Ortam / yansıma / zayıflama metinde yok: ceilingSpot varsayılanları
+    out += "\n";
+    for (const SpotLight &l : desc.lights)
+        emit("light %.7g %.7g %.7g %.7g %.7g %.7g %.7g %.7g %.7g %.7g %.7g\n", l.position.x, l.position.y,
+             l.position.z, l.direction.x, l.direction.y, l.direction.z, glm::degrees(std::acos(l.cutOff)),
+             glm::degrees(std::acos(l.outerCutOff)), l.diffuse.x, l.diffuse.y, l.diffuse.z);
+
+    if (!desc.tour.empty())
+        out += "\n";
+    for (const glm::vec2 &stop : desc.tour)
+        emit("stop %.7g %.7g\n", stop.x, stop.y);
+    return out;
+}
+
+std::vector<unsigned char> compileScene(const SceneDesc &desc)
+{
+    StringBlob strings;
+    std::vector<MetaRecord> metadata;
+    for (const auto &entry : desc.metadata)
+        metadata.push_back({strings.add(entry.first), strings.add(entry.second)});
+    std::vector<ModelRecord> models;
+    for (const ModelDesc &model : desc.models)
+    {
+        const ImportProfile &p = model.import;
+        models.push_back({strings.add(model.path), strings.add(model.info), p.weldTolerance, p.creaseAngle,
+                          static_cast<std::uint32_t>(p.normals), static_cast<std::uint32_t>(p.texCoords),
+                          (p.flipUVs ? IMPORT_FLIP_UVS : 0u) | (p.weld ? IMPORT_WELD : 0u)});
+    }
+    std::vector<FloorRecord> floors;
+    for (const FloorDesc &f : desc.floors)
+        floors.push_back({f.min.x, f.min.y, f.max.x, f.max.y});
+    std::vector<WallRecord> walls;
+    for (const WallDesc &w : desc.walls)
+        walls.push_back({w.from.x, w.from.y, w.to.x, w.to.y, w.bottom, w.top, w.twoSided ? WALL_TWO_SIDED : 0u});
+    std::vector<ExhibitRecord> exhibits;
+    for (const ExhibitDesc &e : desc.exhibits)
+        exhibits.push_back({e.model, e.position.x, e.position.y, e.yaw, e.height});
+    std::vector<StopRecord> tour;
+    for (const glm::vec2 &stop : desc.tour)
+        tour.push_back({stop.x, stop.y});
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = ENDIAN_TAG;
+    header.name = strings.add(desc.name);
+
+    std::vector<unsigned char> out(sizeof(Header));
+    header.metadata = appendSection(out, metadata.data(), metadata.size());
+    header.models = appendSection(out, models.data(), models.size());
+    header.floors = appendSection(out, floors.data(), floors.size());
+    header.walls = appendSection(out, walls.data(), walls.size());
+    header.exhibits = appendSection(out, exhibits.data(), exhibits.size());
+    header.lights = appendSection(out, desc.lights.data(), desc.lights.size()); // std140 düzeni, olduğu gibi
+    header.tour = appendSection(out, tour.data(), tour.size());
+    header.strings = appendSection(out, strings.data().data(), strings.data().size());
+    header.size = static_cast<std::uint32_t>(out.size());
+    std::memcpy(out.data(), &header, sizeof(header));
+    return out;
+}
+
+bool readSceneBinary(const unsigned char *data, std::size_t size, SceneDesc &desc, std::string &error)
+{
+    desc = SceneDesc();
+    Header header;
+    if (size < sizeof(header))
+    {
+        error = "truncated header";
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        error = "not a compiled scene";
+    else if (header.byteOrder != ENDIAN_TAG)
+        error = "compiled for another byte order";
+    else if (header.version != VERSION)
+        error = "version " + std::to_string(header.version) + ", expected " + std::to_string(VERSION);
+    else if (header.size != size)
+        error = "size mismatch (truncated file?)";
+    if (!error.empty())
+        return false;
+
+    // Kayıtlar memcpy ile okunur: eşlemenin hizasına ve aliasing kurallarına güvenilmez
+    auto section = [&](const Section &s, std::size_t recordSize, const char *name) -> const unsigned char *
+    {
+        if (std::uint64_t(s.offset) + std::uint64_t(s.count) * recordSize > size)
+        {
+            error = std::string(name) + " section out of bounds";
+            return nullptr;
+        }
+        return data + s.offset;
+    };
+    const unsigned char *blob = section(header.strings, 1, "string");
+    if (!blob)
+        return false;
+    if (header.strings.count == 0 || blob[header.strings.count - 1] != '\0')
+    {
+        error = "string blob not terminated";
+        return false;
+    }
+    bool badString = false;
+    auto string = [&](std::uint32_t offset)
+    {
+        if (offset >= header.strings.count)
+        {
+            badString = true;
+            return std::string();
+        }
+        return std::string(reinterpret_cast<const char *>(blob + offset));
+    };
+    auto records = [&](const Section &s, auto &out, const char *name)
+    {
+        using Record = typename std::decay_t<decltype(out)>::value_type;
+        const unsigned char *bytes = section(s, sizeof(Record), name);
+        if (!bytes)
+            return false;
+        out.resize(s.count);
+        if (s.count)
+            std::memcpy(out.data(), bytes, s.count * sizeof(Record));
+        return true;
+    };
+
+    std::vector<MetaRecord> metadata;
+    std::vector<ModelRecord> models;
+    std::vector<FloorRecord> floors;
+    std::vector<WallRecord> walls;
+    std::vector<ExhibitRecord> exhibits;
+    std::vector<StopRecord> tour;
+    if (!records(header.metadata, metadata, "metadata") || !records(header.models, models, "model") ||
+        !records(header.floors, floors, "floor") || !records(header.walls, walls, "wall") ||
+        !records(header.exhibits, exhibits, "exhibit") || !records(header.lights, desc.lights, "light") ||
+        !records(header.tour, tour, "tour"))
+        return false;
+
+    desc.name = string(header.name);
+    desc.metadata.reserve(metadata.size());
+    for (const MetaRecord &m : metadata)
+        desc.metadata.emplace_back(string(m.key), string(m.value));
+    desc.models.reserve(models.size());
+    for (const ModelRecord &m : models)
+    {
+        if (m.normals > static_cast<std::uint32_t>(NormalMode::Flat) ||
+            m.texCoords > static_cast<std::uint32_t>(TexCoordMode::Drop))
+        {
+            error = "model " + std::to_string(desc.models.size()) + ": unknown import mode";
+            return false;
+        }
+        ModelDesc model{string(m.path), string(m.info), ImportProfile()};
+        model.import.weldTolerance = m.weldTolerance;
+        model.import.creaseAngle = m.creaseAngle;
+        model.import.normals = static_cast<NormalMode>(m.normals);
+        model.import.texCoords = static_cast<TexCoordMode>(m.texCoords);
+        model.import.flipUVs = (m.flags & IMPORT_FLIP_UVS) != 0;
+        model.import.weld = (m.flags & IMPORT_WELD) != 0;
+        desc.models.push_back(std::move(model));
+    }
+    if (badString)
+    {
+        error = "string offset out of range";
+        return false;
+    }
+    desc.floors.reserve(floors.size());
+    for (const FloorRecord &f : floors)
+        desc.floors.push_back({glm::vec2(f.minX, f.minZ), glm::vec2(f.maxX, f.maxZ)});
+    desc.walls.reserve(walls.size());
+    for (const WallRecord &w : walls)
+        desc.walls.push_back({glm::vec2(w.fromX, w.fromZ), glm::vec2(w.toX, w.toZ), w.bottom, w.top,
+                              (w.flags & WALL_TWO_SIDED) != 0});
+    desc.exhibits.reserve(exhibits.size());
+    for (const ExhibitRecord &e : exhibits)
+        desc.exhibits.push_back({e.model, glm::vec2(e.x, e.z), e.yaw, e.height});
+    desc.tour.reserve(tour.size());
+    for (const StopRecord &s : tour)
+        desc.tour.push_back(glm::vec2(s.x, s.z));
+    return validateScene(desc, error);
+}
+
+bool loadSceneFile(const std::string &path, SceneDesc &desc, std::string &error)
+{
+    MappedFile file;
+    if (!file.open(path, error))
+        return false;
+    bool ok;
+    if (file.size() >= sizeof(MAGIC) && std::memcmp(file.data(), MAGIC, sizeof(MAGIC)) == 0)
+        ok = readSceneBinary(file.data(), file.size(), desc, error);
+    else
+        ok = parseSceneText(reinterpret_cast<const char *>(file.data()), file.size(), desc, error);
+    if (!ok)
+        error = path + ": " + error;
+    return ok;
+}
+
+bool saveSceneFile(const std::string &path, const SceneDesc &desc, std::string &error)
+{
+    const std::string suffix = ".vmscene";
+    const bool binary = path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(),
+                                                                     suffix) == 0;
+    std::ofstream out(path, std::ios::binary);
+    if (binary)
+    {
+        const std::vector<unsigned char> bytes = compileScene(desc);
+        out.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+    else
+    {
+        const std::string text = formatSceneText(desc);
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+    if (!out)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
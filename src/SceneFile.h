@@ -0,0 +1,47 @@
+// SceneFile.h
+#ifndef SCENEFILE_H
+#define SCENEFILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "SceneDesc.h"
+
+// Scene files in two forms holding the same SceneDesc.
+//
+// Text (.scene), for authoring: one entry per line, '#' starts a comment,
+// strings with spaces go in double quotes. Angles in degrees.
+//   scene "name"
+//   meta <key> "value"
+//   model <id> <path> "info"
+//   import <model id> [weld=<tolerance>|off] [normals=keep|missing|smooth|flat]
+//          [crease=<degrees>] [uvs=auto|keep|drop] [flipuv=on|off]
+//                                        options of ImportProfile.h, per model
+//   room x0 z0 x1 z1 height              floor + four inward-facing walls
+//   floor x0 z0 x1 z1
+//   wall x0 z0 x1 z1 bottom top [two-sided]
+//   exhibit <model id> x z [yaw [height]]
+//   light x y z [dx dy dz [inner outer [r g b]]]   ceiling spot defaults
+//   stop x z                             tour waypoint, in order
+//
+// Binary (.vmscene), compiled from the text: a header of section offsets
+// followed by fixed-size little-endian records and one string blob, read
+// straight from a memory map. Both forms are validated on load (indices,
+// finite numbers, degenerate geometry) and report the offending entry.
+
+constexpr const char *DEFAULT_SCENE_PATH = "scenes/museum.scene";
+
+bool parseSceneText(const char *text, std::size_t size, SceneDesc &desc, std::string &error);
+std::string formatSceneText(const SceneDesc &desc);
+
+std::vector<unsigned char> compileScene(const SceneDesc &desc);
+bool readSceneBinary(const unsigned char *data, std::size_t size, SceneDesc &desc, std::string &error);
+
+bool validateScene(const SceneDesc &desc, std::string &error);
+
+// Either form, told apart by the binary magic; the file is memory mapped
+bool loadSceneFile(const std::string &path, SceneDesc &desc, std::string &error);
+// Binary if path ends in .vmscene, text otherwise
+bool saveSceneFile(const std::string &path, const SceneDesc &desc, std::string &error);
+
+#endif // SCENEFILE_H
@@ -1,11 +1,13 @@
 // Shader.cpp
 #include "Shader.h"
+#include "RenderCounters.h"
 #include <glad/glad.h>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
-static void checkCompileErrors(unsigned int shader, const std::string& type) {
+static bool checkCompileErrors(unsigned int shader, const std::string& type) {
     int success;
     char infoLog[1024];
     if (type != "PROGRAM") {
@@ -23,9 +25,11 @@ static void checkCompileErrors(unsigned int shader, const std::string& type) {
                       << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
         }
     }
+    return success != 0;
 }
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath) {
+// Program her durumda oluşturulur; ok: okuma, derleme ve bağlama başarılı mı
+static unsigned int buildProgram(const std::string& vertexPath, const std::string& fragmentPath, bool& ok) {
     // 1. Shader kaynak kodlarını dosyalardan oku
     std::string vertexCode;
     std::string fragmentCode;
@@ -33,6 +37,7 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     std::ifstream fShaderFile;
     vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
     fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    ok = true;
     try {
         vShaderFile.open(vertexPath);
         fShaderFile.open(fragmentPath);
@@ -45,6 +50,7 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
         fragmentCode = fShaderStream.str();
     } catch (std::ifstream::failure& e) {
         std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ: " << e.what() << std::endl;
+        ok = false;
     }
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
@@ -55,44 +61,91 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     vertex = glCreateShader(GL_VERTEX_SHADER);
     glShaderSource(vertex, 1, &vShaderCode, NULL);
     glCompileShader(vertex);
-    checkCompileErrors(vertex, "VERTEX");
+    ok = checkCompileErrors(vertex, "VERTEX") && ok;
     // Fragment Shader
     fragment = glCreateShader(GL_FRAGMENT_SHADER);
     glShaderSource(fragment, 1, &fShaderCode, NULL);
     glCompileShader(fragment);
-    checkCompileErrors(fragment, "FRAGMENT");
+    ok = checkCompileErrors(fragment, "FRAGMENT") && ok;
 
     // 3. Shader Program
-    ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
-    glLinkProgram(ID);
-    checkCompileErrors(ID, "PROGRAM");
+    unsigned int program = glCreateProgram();
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    glLinkProgram(program);
+    ok = checkCompileErrors(program, "PROGRAM") && ok;
     // 4. Shader objelerini temizle
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+    return program;
+}
+
+Shader::Shader(const char* vertexPath, const char* fragmentPath)
+    : vertexPath(vertexPath), fragmentPath(fragmentPath) {
+    bool ok;
+    ID = buildProgram(this->vertexPath, this->fragmentPath, ok);
+}
+
+bool Shader::reload() {
+    bool ok;
+    unsigned int program = buildProgram(vertexPath, fragmentPath, ok);
+    if (!ok) {
+        // Hatalı düzenleme: eski program çalışmaya devam eder
+        glDeleteProgram(program);
+        return false;
+    }
+    glDeleteProgram(ID);
+    ID = program;
+    uniforms.clear();
+    return true;
+}
+
+bool Shader::usesFile(const std::string &path) const {
+    const std::filesystem::path file = std::filesystem::path(path).lexically_normal();
+    return std::filesystem::path(vertexPath).lexically_normal() == file ||
+           std::filesystem::path(fragmentPath).lexically_normal() == file;
 }
 
 void Shader::use() const {
     glUseProgram(ID);
+    RenderCounters::stateChange();
+}
+
+int Shader::uniformLocation(const char *name) const {
+    for (const UniformSlot &slot : uniforms)
+        if (slot.name == name)
+            return slot.location;
+    int location = glGetUniformLocation(ID, name);
+    uniforms.push_back({name, location});
+    return location;
+}
+
+void Shader::setBool(const char *name, bool value) const {
+    glUniform1i(uniformLocation(name), (int)value);
+}
+
+void Shader::setInt(const char *name, int value) const {
+    glUniform1i(uniformLocation(name), value);
 }
 
-void Shader::setBool(const std::string &name, bool value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+void Shader::setFloat(const char *name, float value) const {
+    glUniform1f(uniformLocation(name), value);
 }
 
-void Shader::setInt(const std::string &name, int value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+void Shader::setVec2(const char *name, const glm::vec2 &value) const {
+    glUniform2fv(uniformLocation(name), 1, &value[0]);
 }
 
-void Shader::setFloat(const std::string &name, float value) const {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+void Shader::setVec3(const char *name, const glm::vec3 &value) const {
+    glUniform3fv(uniformLocation(name), 1, &value[0]);
 }
 
-void Shader::setVec3(const std::string &name, const glm::vec3 &value) const {
-    glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+void Shader::setMat4(const char *name, const glm::mat4 &mat) const {
+    glUniformMatrix4fv(uniformLocation(name), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::setMat4(const std::string &name, const glm::mat4 &mat) const {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::bindUniformBlock(const char *name, unsigned int binding) const {
+    unsigned int index = glGetUniformBlockIndex(ID, name);
+    if (index != GL_INVALID_INDEX)
+        glUniformBlockBinding(ID, index, binding);
 }
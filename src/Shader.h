@@ -3,6 +3,7 @@
 #define SHADER_H
 
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
 
 class Shader {
@@ -10,11 +11,31 @@ public:
     unsigned int ID;
     Shader(const char* vertexPath, const char* fragmentPath);
     void use() const;
-    void setBool(const std::string &name, bool value) const;
-    void setInt(const std::string &name, int value) const;
-    void setFloat(const std::string &name, float value) const;
-    void setVec3(const std::string &name, const glm::vec3 &value) const;
-    void setMat4(const std::string &name, const glm::mat4 &mat) const;
+    // Hot reload: recompiles from the same files. On a read, compile or link
+    // error the old program stays in use and false is returned. The new
+    // program has a new ID and no uniform values: callers set them again.
+    bool reload();
+    bool usesFile(const std::string &path) const;
+    // Locations are looked up once per name and cached; no allocation
+    // after the first call with a given name.
+    void setBool(const char *name, bool value) const;
+    void setInt(const char *name, int value) const;
+    void setFloat(const char *name, float value) const;
+    void setVec2(const char *name, const glm::vec2 &value) const;
+    void setVec3(const char *name, const glm::vec3 &value) const;
+    void setMat4(const char *name, const glm::mat4 &mat) const;
+    void bindUniformBlock(const char *name, unsigned int binding) const;
+    int uniformLocation(const char *name) const;
+
+private:
+    std::string vertexPath, fragmentPath;
+
+    struct UniformSlot
+    {
+        std::string name;
+        int location;
+    };
+    mutable std::vector<UniformSlot> uniforms; // program başına birkaç düzine isim: doğrusal arama
 };
 
 #endif // SHADER_H
@@ -0,0 +1,174 @@
+// Transform.cpp
+#include "Transform.h"
+#include "RenderCounters.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRANSFORM_SIMD 1
+#endif
+
+TransformSystem &TransformSystem::get()
+{
+    static TransformSystem system;
+    return system;
+}
+
+TransformHandle TransformSystem::create()
+{
+    TransformHandle h = static_cast<TransformHandle>(gpu.size());
+    posX.push_back(0.0f);
+    posY.push_back(0.0f);
+    posZ.push_back(0.0f);
+    yaws.push_back(0.0f);
+    scales.push_back(1.0f);
+    gpu.emplace_back();
+    dirty.push_back(1);
+    dirtyList.push_back(h);
+    return h;
+}
+
+void TransformSystem::set(TransformHandle h, const glm::vec3 &position, float yaw, float scale)
+{
+    if (posX[h] == position.x && posY[h] == position.y && posZ[h] == position.z &&
+        yaws[h] == yaw && scales[h] == scale)
+        return;
+
+    posX[h] = position.x;
+    posY[h] = position.y;
+    posZ[h] = position.z;
+    yaws[h] = yaw;
+    scales[h] = scale;
+    if (!dirty[h])
+    {
+        dirty[h] = 1;
+        dirtyList.push_back(h);
+    }
+}
+
+// 4 dönüşüm aynı anda: SoA girdiler SIMD yazmaçlarına toplanır, matris
+// elemanları dört şeritte birlikte hesaplanır, sonra her girdiye dağıtılır.
+void TransformSystem::computeBatch(const std::uint32_t *indices, std::size_t count)
+{
+    alignas(16) float c[4], s[4], sc[4], tx[4], ty[4], tz[4];
+    for (std::size_t lane = 0; lane < 4; ++lane)
+    {
+        std::uint32_t i = indices[lane < count ? lane : 0];
+        c[lane] = std::cos(yaws[i]);
+        s[lane] = std::sin(yaws[i]);
+        sc[lane] = scales[i];
+        tx[lane] = posX[i];
+        ty[lane] = posY[i];
+        tz[lane] = posZ[i];
+    }
+
+    alignas(16) float cs[4], ss[4], cn[4], sn[4], inv[4];
+#ifdef TRANSFORM_SIMD
+    __m128 vc = _mm_load_ps(c), vs = _mm_load_ps(s), vscale = _mm_load_ps(sc);
+    __m128 vinv = _mm_div_ps(_mm_set1_ps(1.0f), vscale);
+    _mm_store_ps(cs, _mm_mul_ps(vc, vscale));
+    _mm_store_ps(ss, _mm_mul_ps(vs, vscale));
+    _mm_store_ps(cn, _mm_mul_ps(vc, vinv));
+    _mm_store_ps(sn, _mm_mul_ps(vs, vinv));
+    _mm_store_ps(inv, vinv);
+#else
+    for (int lane = 0; lane < 4; ++lane)
+    {
+        inv[lane] = 1.0f / sc[lane];
+        cs[lane] = c[lane] * sc[lane];
+        ss[lane] = s[lane] * sc[lane];
+        cn[lane] = c[lane] * inv[lane];
+        sn[lane] = s[lane] * inv[lane];
+    }
+#endif
+
+    // translate * rotateY(yaw) * scale(s)
+    for (std::size_t lane = 0; lane < count; ++lane)
+    {
+        GpuTransform &t = gpu[indices[lane]];
+        t.world[0] = glm::vec4(cs[lane], 0.0f, -ss[lane], 0.0f);
+        t.world[1] = glm::vec4(0.0f, sc[lane], 0.0f, 0.0f);
+        t.world[2] = glm::vec4(ss[lane], 0.0f, cs[lane], 0.0f);
+        t.world[3] = glm::vec4(tx[lane], ty[lane], tz[lane], 1.0f);
+        t.normal[0] = glm::vec4(cn[lane], 0.0f, -sn[lane], 0.0f);
+        t.normal[1] = glm::vec4(0.0f, inv[lane], 0.0f, 0.0f);
+        t.normal[2] = glm::vec4(sn[lane], 0.0f, cn[lane], 0.0f);
+    }
+}
+
+void TransformSystem::update()
+{
+    updatedLastFrame = dirtyList.size();
+    if (dirtyList.empty())
+        return;
+
+    // Yükleme aralığı bitişik olsun diye sıralı işle
+    std::sort(dirtyList.begin(), dirtyList.end());
+    for (std::size_t i = 0; i < dirtyList.size(); i += 4)
+        computeBatch(&dirtyList[i], std::min<std::size_t>(4, dirtyList.size() - i));
+
+    if (!buffer)
+    {
+        glGenBuffers(1, &buffer);
+        glGenTextures(1, &bufferTexture);
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    if (gpu.size() > capacity)
+    {
+        // Büyürken tamamını yeniden yükle
+        RenderCounters::trackBuffer(-static_cast<std::int64_t>(capacity * sizeof(GpuTransform)));
+        capacity = std::max<std::size_t>(gpu.size() * 2, 64);
+        RenderCounters::trackBuffer(static_cast<std::int64_t>(capacity * sizeof(GpuTransform)));
+        glBufferData(GL_TEXTURE_BUFFER, capacity * sizeof(GpuTransform), nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, gpu.size() * sizeof(GpuTransform), gpu.data());
+        glBindTexture(GL_TEXTURE_BUFFER, bufferTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, buffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+    else
+    {
+        std::size_t first = dirtyList.front(), last = dirtyList.back();
+        glBufferSubData(GL_TEXTURE_BUFFER, first * sizeof(GpuTransform),
+                        (last - first + 1) * sizeof(GpuTransform), &gpu[first]);
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    for (std::uint32_t h : dirtyList)
+        dirty[h] = 0;
+    dirtyList.clear();
+}
+
+void TransformSystem::forgetProgram(unsigned int program)
+{
+    programs.erase(std::remove_if(programs.begin(), programs.end(),
+                                  [program](const ProgramSlot &slot) { return slot.program == program; }),
+                   programs.end());
+}
+
+const TransformSystem::ProgramSlot &TransformSystem::slotFor(const Shader &shader)
+{
+    for (const ProgramSlot &slot : programs)
+    {
+        if (slot.program == shader.ID)
+            return slot;
+    }
+    // İlk kullanım: sampler birimini sabitle, konumu bir kez çöz
+    glUniform1i(glGetUniformLocation(shader.ID, "transforms"), TRANSFORM_TEXTURE_UNIT);
+    programs.push_back({shader.ID, glGetUniformLocation(shader.ID, "transformIndex")});
+    return programs.back();
+}
+
+void TransformSystem::bind(const Shader &shader)
+{
+    glActiveTexture(GL_TEXTURE0 + TRANSFORM_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, bufferTexture);
+    glActiveTexture(GL_TEXTURE0);
+    slotFor(shader);
+}
+
+void TransformSystem::setDraw(TransformHandle h, const Shader &shader)
+{
+    glUniform1i(slotFor(shader).locIndex, static_cast<int>(h));
+}
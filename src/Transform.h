@@ -0,0 +1,71 @@
+// Transform.h
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Shader.h"
+
+using TransformHandle = std::uint32_t;
+
+// Texture unit of the transform buffer (units below it belong to materials)
+constexpr unsigned int TRANSFORM_TEXTURE_UNIT = 2;
+
+// One entry of the GPU transform buffer: 7 RGBA32F texels
+struct GpuTransform
+{
+    glm::vec4 world[4];  // model matrix columns
+    glm::vec4 normal[3]; // transpose(inverse(mat3(model))) columns, w unused
+};
+
+// Owns every object's world + normal matrix. Objects only rotate about +Y and
+// scale uniformly (statues, robot, room), so the normal matrix is R / scale.
+class TransformSystem
+{
+public:
+    static TransformSystem &get();
+
+    TransformHandle create();
+    // Marks the entry dirty only if something actually changed
+    void set(TransformHandle h, const glm::vec3 &position, float yaw = 0.0f, float scale = 1.0f);
+
+    // Recomputes dirty matrices in batches of four and uploads the changed range
+    void update();
+    // Binds the buffer texture for this frame; call after shader.use() of every program that draws
+    void bind(const Shader &shader);
+    // Selects the transform used by the next draw call
+    void setDraw(TransformHandle h, const Shader &shader);
+    // Drops the cached location of a deleted program (shader hot reload)
+    void forgetProgram(unsigned int program);
+
+    const GpuTransform &operator[](TransformHandle h) const { return gpu[h]; }
+    std::size_t size() const { return gpu.size(); }
+    std::size_t lastUpdateCount() const { return updatedLastFrame; }
+
+private:
+    TransformSystem() = default;
+    void computeBatch(const std::uint32_t *indices, std::size_t count);
+
+    // SoA kaynak veri
+    std::vector<float> posX, posY, posZ, yaws, scales;
+    std::vector<std::uint8_t> dirty;
+    std::vector<std::uint32_t> dirtyList;
+
+    std::vector<GpuTransform> gpu;
+    std::size_t updatedLastFrame = 0;
+
+    // GL kaynakları
+    unsigned int buffer = 0, bufferTexture = 0;
+    std::size_t capacity = 0; // entries allocated on the GPU
+    // Program başına "transformIndex" konumu (pre-pass + shading programları)
+    struct ProgramSlot
+    {
+        unsigned int program;
+        int locIndex;
+    };
+    std::vector<ProgramSlot> programs;
+    const ProgramSlot &slotFor(const Shader &shader);
+};
+
+#endif // TRANSFORM_H
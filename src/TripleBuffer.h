@@ -0,0 +1,46 @@
+// TripleBuffer.h
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+// Lock-free single producer / single consumer handoff of the latest value.
+// The producer fills writeSlot() and publishes it; the consumer takes the
+// most recently published slot. Neither side ever waits for the other, an
+// unread value is simply replaced by a newer one.
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Producer -----------------------------------------------------
+    T &writeSlot() { return slots[back]; }
+    void publish()
+    {
+        unsigned int prev = middle.exchange(back | DIRTY, std::memory_order_acq_rel);
+        back = prev & INDEX;
+    }
+
+    // Consumer -----------------------------------------------------
+    bool hasNew() const { return (middle.load(std::memory_order_acquire) & DIRTY) != 0; }
+    // Takes the latest published value; false if nothing new since the last call
+    bool acquire()
+    {
+        if (!hasNew())
+            return false;
+        unsigned int prev = middle.exchange(front, std::memory_order_acq_rel);
+        front = prev & INDEX;
+        return true;
+    }
+    const T &readSlot() const { return slots[front]; }
+
+private:
+    static constexpr unsigned int INDEX = 3;
+    static constexpr unsigned int DIRTY = 4;
+
+    T slots[3];
+    std::atomic<unsigned int> middle{1};
+    unsigned int back = 0;  // sadece üretici
+    unsigned int front = 2; // sadece tüketici
+};
+
+#endif // TRIPLEBUFFER_H
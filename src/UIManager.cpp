@@ -1,29 +1,23 @@
 // UIManager.cpp
 #include "UIManager.h"
+#include "Profiler.h"
 #include <imgui.h>
-#include <glm/gtx/string_cast.hpp>
 
-UIManager::UIManager(Robot *r, Scene *s, Shader *sh)
-    : robot(r), scene(s), shader(sh)
+UIManager::UIManager(const Robot *r, Scene *s, CommandQueue *cq, RenderSettings *rs, const RenderStats *st)
+    : robot(r), scene(s), commands(cq), settings(rs), stats(st)
 {
-    // Initialize object positions matching Scene::initModels()
-    objectPositions = {
-        {2.0f, 0.5f, 3.0f},  // Changed y to 0.5
-        {-3.0f, 0.5f, 1.0f}, // Changed y to 0.5
-        {0.0f, 0.5f, -2.5f}, // Changed y to 0.5
-        {4.0f, 0.5f, -1.0f}, // Changed y to 0.5
-        {-1.5f, 0.5f, -3.5f} // Changed y to 0.5
-    }; // Descriptions for each object
-    infoStrings = {
-        "Heykel: Antik döneme ait taş heykel.",
-        "Manstatue: Orta Çağ'dan kalma insan heykeli.",
-        "Modelleme: Modern sanat eseri.",
-        "Roma Mezar Modeli: Roma dönemine ait mezar maketi.",
-        "Roma Yeni: Yenilenmiş Roma dönemi lahdi."};
+    // Object positions (robot height) and descriptions come from the scene
+    const SceneDesc &desc = scene->getDesc();
+    for (const ExhibitDesc &exhibit : desc.exhibits)
+    {
+        objectPositions.push_back(glm::vec3(exhibit.position.x, TOUR_HEIGHT, exhibit.position.y));
+        infoStrings.push_back(exhibit.model < desc.models.size() ? desc.models[exhibit.model].info : std::string());
+    }
 }
 
 void UIManager::render()
 {
+    PROFILE_SCOPE("UIManager::render");
     // Main control window
     ImGui::Begin("Controls");
     if (autoTour)
@@ -31,7 +25,7 @@ void UIManager::render()
         if (ImGui::Button("Stop Auto Tour"))
         {
             autoTour = false;
-            robot->setPath({});
+            commands->setRobotPath({});
         }
     }
     else
@@ -39,13 +33,113 @@ void UIManager::render()
         if (ImGui::Button("Start Auto Tour"))
         {
             autoTour = true;
-            robot->setPath(objectPositions);
+            commands->setRobotPath(scene->tourStops());
         }
     }
     ImGui::Separator();
     ImGui::Checkbox("Auto Tour", &autoTour);
-    ImGui::SliderFloat3("Robot Position", &robot->position.x, -10.0f, 10.0f);
-    ImGui::Text("Robot Direction: %s", glm::to_string(robot->direction).c_str());
+    glm::vec3 robotPosition = robot->position;
+    if (ImGui::SliderFloat3("Robot Position", &robotPosition.x, -10.0f, 10.0f))
+        commands->teleportRobot(robotPosition);
+    ImGui::Text("Robot Direction: (%.3f, %.3f, %.3f)", robot->direction.x, robot->direction.y, robot->direction.z);
+
+    if (ImGui::CollapsingHeader("Rendering"))
+    {
+        ImGui::Checkbox("Per-vertex normal matrix (legacy)", &settings->legacyNormalMatrix);
+        if (settings->path == RenderPath::Deferred)
+        {
+            ImGui::Text("Path: deferred (%u lights drawn)", stats->lightsDrawn);
+            ImGui::Text("G-buffer GPU: %.3f ms", stats->geometryGpuMs);
+            ImGui::Text("Lighting GPU: %.3f ms", stats->lightingGpuMs);
+        }
+        else
+        {
+            ImGui::Text("Path: forward (%u lights)", stats->lightsDrawn);
+            ImGui::Checkbox("Depth pre-pass", &settings->depthPrepass);
+            ImGui::Text("Pre-pass GPU: %.3f ms", stats->prepassGpuMs);
+            ImGui::Text("Shading GPU:  %.3f ms", stats->sceneGpuMs);
+            ImGui::Text("Total GPU:    %.3f ms", stats->prepassGpuMs + stats->sceneGpuMs);
+        }
+        ImGui::Separator();
+        ImGui::Checkbox("Dynamic resolution", &settings->dynamicResolution);
+        if (settings->dynamicResolution)
+        {
+            ImGui::SliderFloat("GPU budget (ms)", &settings->targetGpuMs, 4.0f, 33.0f, "%.1f");
+            ImGui::SliderFloat("Min scale", &settings->minScale, 0.25f, 1.0f, "%.2f");
+            const char *filters[] = {"Bilinear", "Sharpen"};
+            int filter = static_cast<int>(settings->upscaleFilter);
+            if (ImGui::Combo("Upscale", &filter, filters, 2))
+                settings->upscaleFilter = static_cast<UpscaleFilter>(filter);
+            if (settings->upscaleFilter == UpscaleFilter::Sharpen)
+                ImGui::SliderFloat("Sharpness", &settings->sharpness, 0.0f, 1.0f, "%.2f");
+            ImGui::Text("Upscale GPU:  %.3f ms", stats->upscaleGpuMs);
+        }
+        ImGui::Text("Scale %.2f (%dx%d), frame GPU %.3f ms",
+                    stats->renderScale, stats->renderWidth, stats->renderHeight, stats->frameGpuMs);
+        ImGui::Separator();
+        const char *modes[] = {"VSync", "Adaptive VSync", "Limited", "Unlimited"};
+        int mode = static_cast<int>(settings->pacing);
+        if (ImGui::Combo("Pacing", &mode, modes, 4))
+            settings->pacing = static_cast<PacingMode>(mode);
+        if (settings->pacing == PacingMode::Limited)
+            ImGui::SliderInt("Target FPS", &settings->targetFps, 24, 240);
+        ImGui::SliderInt("Max frames in flight", &settings->maxFramesInFlight, 1, 3);
+        ImGui::Text("Frame %.2f ms (jitter %.2f), limiter %.2f ms, GPU wait %.2f ms",
+                    stats->frameMs, stats->frameJitterMs, stats->limiterWaitMs, stats->gpuWaitMs);
+        ImGui::Text("Input latency: %.1f ms, GPU stalls %llu", stats->inputLatencyMs, stats->gpuStalls);
+        ImGui::Separator();
+        const int simRates[] = {30, 60, 120, 240};
+        const char *simRateNames[] = {"30 Hz", "60 Hz", "120 Hz", "240 Hz"};
+        int rateIndex = 1;
+        for (int i = 0; i < 4; ++i)
+            if (simRates[i] == settings->simRateHz)
+                rateIndex = i;
+        if (ImGui::Combo("Simulation rate", &rateIndex, simRateNames, 4))
+            settings->simRateHz = simRates[rateIndex];
+        ImGui::Text("Sim steps this frame: %d, alpha %.2f, dropped %.1f ms",
+                    stats->simSteps, stats->simAlpha, stats->simDroppedMs);
+        ImGui::Separator();
+        ImGui::Text("%s", stats->threaded ? "Threads: main + render" : "Threads: single");
+        ImGui::Text("Main:   %.2f ms (waiting for render %.2f ms)", stats->mainThreadMs, stats->mainWaitMs);
+        ImGui::Text("Render: %.2f ms (waiting for packet %.2f ms)", stats->renderThreadMs, stats->renderWaitMs);
+        ImGui::Text("Job threads: %u, visible models: %u / %u", stats->jobThreads, stats->visibleModels,
+                    stats->totalModels);
+        ImGui::Separator();
+        ImGui::Checkbox("Idle mode", &settings->idleMode);
+        ImGui::Text("Idle %.1f%%, %llu frames saved (%llu re-presented)", stats->idleFraction * 100.0f,
+                    stats->idleSavedFrames, stats->idlePresentedFrames);
+        ImGui::Text("Transforms updated: %u", stats->transformsUpdated);
+        ImGui::Text("Upload ring (%s): %u B/frame, %u stalls",
+                    stats->ringPersistent ? "persistent" : "orphan", stats->ringBytes, stats->ringStalls);
+    }
+
+    if (ImGui::CollapsingHeader("GPU passes"))
+    {
+        if (!stats->gpuTimers)
+            ImGui::TextDisabled("Timer queries not supported by this driver");
+        else if (ImGui::BeginTable("gpuPasses", 7, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+        {
+            // Son 128 ölçüm üzerinden, ms
+            const char *columns[] = {"Pass", "last", "avg", "p50", "p95", "p99", "max"};
+            for (const char *column : columns)
+                ImGui::TableSetupColumn(column);
+            ImGui::TableHeadersRow();
+            for (int i = 0; i < stats->gpuPassCount; ++i)
+            {
+                const GpuPassStats &pass = stats->gpuPasses[i];
+                const float values[] = {pass.lastMs, pass.avgMs, pass.p50Ms, pass.p95Ms, pass.p99Ms, pass.maxMs};
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(pass.name);
+                for (float value : values)
+                {
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", value);
+                }
+            }
+            ImGui::EndTable();
+        }
+    }
     ImGui::End();
 
     // Proximity detection for pop-up
@@ -7,17 +7,21 @@
 #include <glm/glm.hpp>
 #include "Robot.h"
 #include "Scene.h"
-#include "Shader.h"
+#include "CommandQueue.h"
+#include "RenderSettings.h"
 
 class UIManager {
 public:
-    UIManager(Robot* robot, Scene* scene, Shader* shader);
+    // Robot state is only read here; changes go through the command queue
+    UIManager(const Robot* robot, Scene* scene, CommandQueue* commands, RenderSettings* settings, const RenderStats* stats);
     void render();
 
 private:
-    Robot* robot;
+    const Robot* robot;
     Scene* scene;
-    Shader* shader;
+    CommandQueue* commands;
+    RenderSettings* settings;
+    const RenderStats* stats;
 
     bool autoTour = false;
     bool showInfo = false;
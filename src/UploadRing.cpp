@@ -0,0 +1,155 @@
+// UploadRing.cpp
+#include "UploadRing.h"
+#include "RenderCounters.h"
+#include <glad/glad.h>
+#include <cstring>
+#include <iostream>
+
+static bool hasBufferStorage()
+{
+#if defined(GL_VERSION_4_4)
+    if (GLAD_GL_VERSION_4_4)
+        return true;
+#endif
+#if defined(GL_ARB_buffer_storage)
+    if (GLAD_GL_ARB_buffer_storage)
+        return true;
+#endif
+    return false;
+}
+
+UploadRing::UploadRing(std::size_t bytesPerFrame)
+    : frameSize(bytesPerFrame)
+{
+    glGenBuffers(1, &bufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, bufferId);
+
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage)
+    if (hasBufferStorage())
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, frameSize * FRAMES, nullptr, flags);
+        base = static_cast<unsigned char *>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, frameSize * FRAMES, flags));
+        persistentMapped = base != nullptr;
+    }
+#endif
+
+    if (!persistentMapped)
+    {
+        // GL 3.3 yolu: tek frame'lik buffer, her frame orphan edilir
+        glBufferData(GL_COPY_WRITE_BUFFER, frameSize, nullptr, GL_STREAM_DRAW);
+        base = new unsigned char[frameSize];
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    RenderCounters::trackBuffer(static_cast<std::int64_t>(frameSize * (persistentMapped ? FRAMES : 1)));
+
+    std::cout << "UploadRing: " << (persistentMapped ? "persistent mapped" : "orphaning")
+              << ", " << frameSize / 1024 << " KB/frame" << std::endl;
+}
+
+UploadRing::~UploadRing()
+{
+    for (void *&fence : fences)
+    {
+        if (fence)
+            glDeleteSync(static_cast<GLsync>(fence));
+        fence = nullptr;
+    }
+    if (persistentMapped)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, bufferId);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    else
+    {
+        delete[] base;
+    }
+    glDeleteBuffers(1, &bufferId);
+    RenderCounters::trackBuffer(-static_cast<std::int64_t>(frameSize * (persistentMapped ? FRAMES : 1)));
+}
+
+void UploadRing::beginFrame()
+{
+    head = 0;
+    flushedTo = 0;
+    orphaned = false;
+
+    GLsync fence = static_cast<GLsync>(fences[frame]);
+    if (!fence)
+        return;
+
+    // GPU bu bölgeyi hâlâ okuyor mu? Önce beklemeden sor.
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED)
+    {
+        ++frameStalls;
+        ++stallCount;
+        do
+        {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+        } while (status == GL_TIMEOUT_EXPIRED);
+    }
+    glDeleteSync(fence);
+    fences[frame] = nullptr;
+}
+
+UploadRing::Allocation UploadRing::allocate(std::size_t size, std::size_t alignment)
+{
+    Allocation a;
+    std::size_t aligned = alignment > 1 ? (head + alignment - 1) / alignment * alignment : head;
+    if (aligned + size > frameSize)
+    {
+        ++frameOverflows;
+        return a;
+    }
+
+    std::size_t regionStart = persistentMapped ? frame * frameSize : 0;
+    a.ptr = base + regionStart + aligned;
+    a.offset = regionStart + aligned;
+    a.size = size;
+    head = aligned + size;
+    frameBytes += size;
+    return a;
+}
+
+std::size_t UploadRing::write(const void *data, std::size_t size, std::size_t alignment)
+{
+    Allocation a = allocate(size, alignment);
+    if (!a.ptr)
+        return static_cast<std::size_t>(-1);
+    std::memcpy(a.ptr, data, size);
+    return a.offset;
+}
+
+void UploadRing::flush()
+{
+    if (persistentMapped || flushedTo == head)
+        return;
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, bufferId);
+    if (!orphaned)
+    {
+        // Orphan: sürücü eski depoyu GPU bitene kadar tutar, biz yenisine yazarız
+        glBufferData(GL_COPY_WRITE_BUFFER, frameSize, nullptr, GL_STREAM_DRAW);
+        orphaned = true;
+    }
+    glBufferSubData(GL_COPY_WRITE_BUFFER, flushedTo, head - flushedTo, base + flushedTo);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    flushedTo = head;
+}
+
+void UploadRing::endFrame()
+{
+    flush();
+    if (persistentMapped)
+        fences[frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frame = (frame + 1) % FRAMES;
+
+    lastFrameBytes = frameBytes;
+    lastFrameStalls = frameStalls;
+    lastFrameOverflows = frameOverflows;
+    frameBytes = 0;
+    frameStalls = 0;
+    frameOverflows = 0;
+}
@@ -0,0 +1,66 @@
+// UploadRing.h
+#ifndef UPLOADRING_H
+#define UPLOADRING_H
+
+#include <cstddef>
+
+// Per-frame streaming buffer for dynamic GPU data (lights, instance data,
+// debug lines...). With GL_ARB_buffer_storage it is one persistently mapped,
+// coherent buffer split into FRAMES regions guarded by fences; on plain GL 3.3
+// it writes into CPU staging memory and orphans the buffer on flush().
+class UploadRing
+{
+public:
+    static constexpr int FRAMES = 3;
+
+    struct Allocation
+    {
+        void *ptr = nullptr;    // write destination (valid until endFrame)
+        std::size_t offset = 0; // byte offset for glBindBufferRange
+        std::size_t size = 0;
+    };
+
+    explicit UploadRing(std::size_t bytesPerFrame);
+    ~UploadRing();
+    UploadRing(const UploadRing &) = delete;
+    UploadRing &operator=(const UploadRing &) = delete;
+
+    // Waits (and counts a stall) if the GPU still reads this frame's region
+    void beginFrame();
+    // ptr == nullptr when the frame budget is exhausted
+    Allocation allocate(std::size_t size, std::size_t alignment);
+    // Copies data in; returns its offset, or (size_t)-1 on overflow
+    std::size_t write(const void *data, std::size_t size, std::size_t alignment);
+    // Makes everything written so far visible to the GPU (no-op when persistent)
+    void flush();
+    // Fences the frame's region
+    void endFrame();
+
+    unsigned int buffer() const { return bufferId; }
+    bool persistent() const { return persistentMapped; }
+
+    // İstatistikler
+    std::size_t bytesLastFrame() const { return lastFrameBytes; }
+    unsigned int stallsLastFrame() const { return lastFrameStalls; }
+    unsigned long long totalStalls() const { return stallCount; }
+    unsigned int overflowsLastFrame() const { return lastFrameOverflows; }
+
+private:
+    std::size_t frameSize;
+    unsigned int bufferId = 0;
+    bool persistentMapped = false;
+
+    unsigned char *base = nullptr; // mapped memory or CPU staging
+    void *fences[FRAMES] = {nullptr};
+    int frame = 0;
+    std::size_t head = 0;      // bytes used in the current frame
+    std::size_t flushedTo = 0; // staging path: bytes already uploaded
+    bool orphaned = false;
+
+    std::size_t frameBytes = 0, lastFrameBytes = 0;
+    unsigned int frameStalls = 0, lastFrameStalls = 0;
+    unsigned int frameOverflows = 0, lastFrameOverflows = 0;
+    unsigned long long stallCount = 0;
+};
+
+#endif // UPLOADRING_H
@@ -17,8 +17,33 @@
 
 #include "Shader.h"
 #include "Scene.h"
+#include "MuseumGenerator.h"
+#include "SceneFile.h"
+#include "AssetPack.h"
+#include "PackPatch.h"
 #include "Robot.h"
 #include "UIManager.h"
+#include "Renderer.h"
+#include "RenderSettings.h"
+#include "RenderBench.h"
+#include "RenderThread.h"
+#include "HotReload.h"
+#include "CommandQueue.h"
+#include "IdleMonitor.h"
+#include "FixedStep.h"
+#include "HeadlessSim.h"
+#include "JobSystem.h"
+#include "Frustum.h"
+#include "AllocCounter.h"
+#include "Profiler.h"
+#include "GpuProfiler.h"
+#include "PerfHud.h"
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <chrono>
+#include <string>
 
 // ImGui ------------------------------------------------------------
 #include <imgui.h>
@@ -30,9 +55,22 @@
 // -----------------------------------------------------------------
 constexpr unsigned int SCR_WIDTH  = 1280;
 constexpr unsigned int SCR_HEIGHT =  720;
+constexpr int ALLOC_WARMUP_FRAMES  = 120; // --alloc-check: önbellekler, havuzlar dolsun
+constexpr int TRACE_HOTKEY_FRAMES  = 120; // F9 ile yakalanan frame sayısı
 
 float deltaTime = 0.0f;            // frame‑ler arası süre
 float lastFrame = 0.0f;
+unsigned int inputEvents = 0;      // her GLFW giriş olayında artar (idle modundan uyandırır)
+double pendingInputTime = -1.0;    // henüz bir frame'e yansımamış en eski girişin zamanı
+bool traceRequested = false;       // F9: sonraki frame'lerden iz yakala
+bool hudToggleRequested = false;   // F3: performans katmanı
+
+void noteInput()
+{
+    ++inputEvents;
+    if (pendingInputTime < 0.0)
+        pendingInputTime = glfwGetTime();
+}
 
 // ----------------------------------------------------------------------------
 // Kamera (orbit)
@@ -68,11 +106,13 @@ namespace Cam {
 // -----------------------------------------------------------------------------
 void framebuffer_size_callback(GLFWwindow *window, int width, int height)
 {
-    glViewport(0, 0, width, height);
+    // Viewport her frame render tarafında ayarlanır (bu thread'de GL context yok)
+    noteInput();
 }
 
 void cursor_position_callback(GLFWwindow* /*window*/, double xpos, double ypos)
 {
+    noteInput();
     if (!Cam::orbiting) return;
 
     float dx = static_cast<float>(xpos - Cam::lastX);
@@ -89,6 +129,7 @@ void cursor_position_callback(GLFWwindow* /*window*/, double xpos, double ypos)
 
 void mouse_button_callback(GLFWwindow* window, int button, int action, int /*mods*/)
 {
+    noteInput();
     if (button != GLFW_MOUSE_BUTTON_LEFT) return;
 
     if (action == GLFW_PRESS) {
@@ -102,44 +143,171 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int /*mod
 
 void scroll_callback(GLFWwindow* /*window*/, double /*xoff*/, double yoff)
 {
+    noteInput();
     Cam::distance -= static_cast<float>(yoff) * Cam::radius * 0.1f;
     // yakınlık sınırları
     Cam::distance = std::max(Cam::distance, Cam::radius * 0.5f);
     Cam::distance = std::min(Cam::distance, Cam::radius * 20.0f);
 }
 
+void key_callback(GLFWwindow* /*window*/, int key, int /*scancode*/, int action, int /*mods*/)
+{
+    noteInput(); // tuş durumu processInput'ta okunur
+    if (key == GLFW_KEY_F9 && action == GLFW_PRESS)
+        traceRequested = true;
+    if (key == GLFW_KEY_F3 && action == GLFW_PRESS)
+        hudToggleRequested = true;
+}
+
 // -----------------------------------------------------------------------------
-void processInput(GLFWwindow *window, Robot *robot)
+// Tuş durumları robot kontrol eksenlerine çevrilir; hareketi sim adımı uygular
+RobotInput processInput(GLFWwindow *window)
 {
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         glfwSetWindowShouldClose(window, true);
 
-    float moveSpeed = robot->speed * deltaTime;
-
-    // İleri / geri
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-        robot->position += robot->direction * moveSpeed;
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-        robot->position -= robot->direction * moveSpeed;
-
-    // Yanlara straf
-    glm::vec3 right = glm::normalize(glm::cross(robot->direction, glm::vec3(0.0f, 1.0f, 0.0f)));
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-        robot->position += right * moveSpeed;
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-        robot->position -= right * moveSpeed;
-
-    // Yön dönüşü (sol / sağ ok)
-    float rotSpeed = 90.0f * deltaTime; // derece / sn
-    if (glfwGetKey(window, GLFW_KEY_LEFT)  == GLFW_PRESS)
-        robot->direction = glm::rotateY(robot->direction,  glm::radians( rotSpeed));
-    if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
-        robot->direction = glm::rotateY(robot->direction,  glm::radians(-rotSpeed));
+    auto axis = [window](int positive, int negative) {
+        return (glfwGetKey(window, positive) == GLFW_PRESS ? 1.0f : 0.0f) -
+               (glfwGetKey(window, negative) == GLFW_PRESS ? 1.0f : 0.0f);
+    };
+
+    RobotInput input;
+    input.move   = axis(GLFW_KEY_W, GLFW_KEY_S);        // ileri / geri
+    input.strafe = axis(GLFW_KEY_D, GLFW_KEY_A);        // yanlara straf
+    input.turn   = axis(GLFW_KEY_LEFT, GLFW_KEY_RIGHT); // yön dönüşü
+    return input;
 }
 
 // -----------------------------------------------------------------------------
-int main()
+int main(int argc, char **argv)
 {
+    // Komut satırı ---------------------------------------------------
+    bool deferred = false, benchLighting = false, singleThread = false;
+    double headlessSeconds = 0.0;
+    int simRate = 60;
+    int allocCheckFrames = 0; // >0: ısınmadan sonra bu kadar frame ayırma yapmamalı
+    bool traceStartup = false;
+    int traceFrames = 0;
+    bool showHud = false;
+    bool hotReloading = false;
+    bool generate = false; // --rooms/--exhibits/--lights/--seed: üretilmiş müze
+    MuseumParams museum;
+    std::string scenePath = DEFAULT_SCENE_PATH, writeScenePath, packPath, patchPath;
+    bool sceneGiven = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--deferred") == 0)
+            deferred = true;
+        else if (std::strcmp(argv[i], "--bench-lighting") == 0)
+            benchLighting = true;
+        else if (std::strcmp(argv[i], "--single-thread") == 0)
+            singleThread = true;
+        else if (std::strcmp(argv[i], "--headless-sim") == 0 && i + 1 < argc)
+            headlessSeconds = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--sim-rate") == 0 && i + 1 < argc)
+            simRate = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--trace-startup") == 0)
+            traceStartup = true;
+        else if (std::strcmp(argv[i], "--trace-frames") == 0 && i + 1 < argc)
+            traceFrames = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--hud") == 0)
+            showHud = true;
+        else if (std::strcmp(argv[i], "--hot-reload") == 0)
+            hotReloading = true;
+        else if (std::strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+            scenePath = argv[++i];
+            sceneGiven = true;
+        }
+        else if (std::strcmp(argv[i], "--pack") == 0 && i + 1 < argc)
+            packPath = argv[++i];
+        else if (std::strcmp(argv[i], "--apply-patch") == 0 && i + 1 < argc)
+            patchPath = argv[++i];
+        else if (std::strcmp(argv[i], "--write-scene") == 0 && i + 1 < argc)
+            writeScenePath = argv[++i];
+        else if (std::strcmp(argv[i], "--rooms") == 0 && i + 1 < argc) {
+            generate = true;
+            museum.rooms = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--exhibits") == 0 && i + 1 < argc) {
+            generate = true;
+            museum.exhibits = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--lights") == 0 && i + 1 < argc) {
+            generate = true;
+            museum.lights = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            generate = true;
+            museum.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--alloc-check") == 0) {
+            allocCheckFrames = 600;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+                allocCheckFrames = std::max(1, std::atoi(argv[++i]));
+        }
+        else
+            std::cerr << "Unknown argument: " << argv[i] << "\n";
+    }
+
+    // Sahne dosyası (metin ya da derlenmiş); üretilmiş müze onun modellerini kullanır.
+    // --pack: pişmiş paket (museum_cook); --scene verilmediyse sahne de paketten
+    SceneDesc sceneDesc;
+    AssetPack pack;
+    {
+        auto loadStart = std::chrono::steady_clock::now();
+        std::string error;
+        // --apply-patch: paket önce güncellenir; hata olursa eskisi olduğu gibi kalır
+        if (!patchPath.empty()) {
+            if (packPath.empty()) {
+                std::cerr << "--apply-patch needs --pack\n";
+                return -1;
+            }
+            auto patchStart = std::chrono::steady_clock::now();
+            if (!applyPackPatch(packPath, patchPath, error)) {
+                std::cerr << "Patch: " << error << "\n";
+                return -1;
+            }
+            std::cout << "Patched " << packPath << " in "
+                      << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - patchStart).count()
+                      << " ms\n";
+        }
+        if (!packPath.empty() && !pack.mount(packPath, error)) {
+            std::cerr << "Pack: " << error << "\n";
+            return -1;
+        }
+        const bool fromPack = pack.isMounted() && !sceneGiven;
+        if (fromPack ? !pack.loadScene(sceneDesc, error) : !loadSceneFile(scenePath, sceneDesc, error)) {
+            std::cerr << "Scene: " << error << "\n";
+            return -1;
+        }
+        if (generate)
+            sceneDesc = generateMuseum(museum, sceneDesc.models);
+        std::cout << "Scene description: " << sceneDesc.exhibits.size() << " exhibits, " << sceneDesc.lights.size()
+                  << " lights, " << sceneDesc.walls.size() << " walls in "
+                  << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count()
+                  << " ms\n";
+        // --write-scene: .vmscene ise derlenmiş, değilse metin; sonra çık
+        if (!writeScenePath.empty()) {
+            if (!saveSceneFile(writeScenePath, sceneDesc, error)) {
+                std::cerr << error << "\n";
+                return -1;
+            }
+            std::cout << "Scene written to " << writeScenePath << "\n";
+            return 0;
+        }
+    }
+
+    // Pencere / GL olmadan, gerçek zamandan hızlı simülasyon
+    if (headlessSeconds > 0.0)
+        return runHeadlessSim(headlessSeconds, simRate, sceneDesc.tourStops());
+
+#if !VM_PROFILER
+    if (traceStartup || traceFrames > 0)
+        std::cerr << "Built with VM_PROFILER=0: traces will be empty\n";
+#endif
+    PROFILE_THREAD("Main");
+    if (traceStartup)
+        Profiler::get().startCapture("trace_startup.json");
+
     // 1) GLFW ------------------------------------------------------
     if (!glfwInit()) {
         std::cerr << "GLFW init failed\n";
@@ -163,6 +331,7 @@ int main()
     glfwSetCursorPosCallback     (window, cursor_position_callback);
     glfwSetMouseButtonCallback   (window, mouse_button_callback);
     glfwSetScrollCallback        (window, scroll_callback);
+    glfwSetKeyCallback           (window, key_callback);
 
     // 3) GLAD -------------------------------------------------------
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
@@ -179,91 +348,277 @@ int main()
     ImGui_ImplOpenGL3_Init("#version 330 core");
 
     // 5) Uygulama nesneleri ---------------------------------------
-    Shader shader("shaders/vertex.glsl", "shaders/fragment.glsl");
+    // settings/stats: ana thread (UI). renderSettings/renderStats: render tarafı,
+    // her frame paketten kopyalanır / paketle geri döner.
+    RenderSettings settings;
+    RenderStats    stats;
+    settings.path = deferred ? RenderPath::Deferred : RenderPath::Forward;
+    // Forward yol tek UBO'da en fazla MAX_SPOT_LIGHTS ışık görür; üretici ışıkları
+    // tur sırasıyla dizer, fazlası (sonraki odalar) sessizce karanlık kalırdı
+    if (!deferred && sceneDesc.lights.size() > static_cast<std::size_t>(MAX_SPOT_LIGHTS))
+        std::cerr << "Warning: the forward path draws only the first " << MAX_SPOT_LIGHTS << " of "
+                  << sceneDesc.lights.size() << " lights; " << sceneDesc.lights.size() - MAX_SPOT_LIGHTS
+                  << " stay dark. Use --deferred to draw them all.\n";
+    settings.simRateHz = simRate;
+    RenderSettings renderSettings = settings;
+    RenderStats    renderStats;
+    Renderer       renderer(renderSettings, renderStats);
+
+    // Çağıran thread iş sisteminin 0. thread'i olur (yükleme bu thread'den)
+    JobSystem::get().init();
+    stats.jobThreads = JobSystem::get().threadCount();
 
     Scene scene;
-    scene.init();
+    {
+        auto initStart = std::chrono::steady_clock::now();
+        scene.init(sceneDesc, pack.isMounted() ? &pack : nullptr);
+        std::cout << "Scene loaded from " << (pack.isMounted() ? pack.getPath() : std::string("loose files")) << " in "
+                  << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - initStart).count()
+                  << " ms\n";
+    }
+    pack.unmount(); // doku pikselleri GL'e kopyalandı; eşleme artık gerekmez
 
     // --- Sahne sınır kutusu yalnızca 1 kez -----------------------
     scene.getSceneBounds(Cam::center, Cam::radius);
     Cam::distance = Cam::radius / std::tan(glm::radians(Cam::fov * 0.5f)) + Cam::radius * 0.5f; // güvenli mesafe
 
-    Robot     robot;
-    UIManager ui(&robot, &scene, &shader);
+    Robot        robot;
+    CommandQueue commands;
+    UIManager    ui(&robot, &scene, &commands, &settings, &stats);
+    PerfHud      hud(&stats);
+    hud.setVisible(showHud);
+
+    if (benchLighting) {
+        BenchCamera camera{Cam::position(), Cam::center, Cam::fov,
+                           Cam::radius * 0.01f, Cam::distance + Cam::radius * 2.0f};
+        int result = runLightingBenchmark(renderer, renderSettings, scene, robot, camera);
+        glfwTerminate();
+        return result;
+    }
+
+    // İlk ImGui frame'inden önce font texture'ı bu thread'de oluşsun
+    ImGui_ImplOpenGL3_NewFrame();
+
+    const std::vector<SpotLight> lights = scene.getLights(); // sahne artık render tarafının
+    // Culling kopyası; hot reload bir modeli yeniden ölçeklerse pollModelBounds yeniler
+    std::vector<glm::vec4> modelBounds = scene.getModelBounds();
+    std::uint64_t modelBoundsVersion = 0;
+    IdleMonitor  idle;
+    FixedStep    simClock(settings.simRateHz);
+    RenderThread renderThread(window, renderer, scene, robot, renderSettings, renderStats, !singleThread);
+    // --hot-reload: kaydedilen model, doku ve shader'lar çalışırken yenilenir
+    HotReload hotReload;
+    if (hotReloading) {
+        std::string error;
+        if (hotReload.start(sceneDesc, [] { glfwPostEmptyEvent(); }, error)) {
+            renderThread.setHotReload(&hotReload);
+            std::cout << "Hot reload: watching shaders/ and the model directories\n";
+        } else {
+            std::cerr << "Hot reload: " << error << "\n";
+        }
+    }
+    if (renderThread.isThreaded()) {
+        glfwMakeContextCurrent(nullptr); // GL context render thread'e geçer
+        renderThread.start();
+    }
+
+    // --alloc-check: her frame gerçekten çizilsin ve robot hareket etsin
+    int loopFrames = 0, allocatingFrames = 0, firstAllocatingFrame = 0;
+    unsigned long long allocsSeen = 0;
+    if (allocCheckFrames > 0) {
+        settings.idleMode = false;
+        commands.setRobotPath(scene.tourStops());
+    }
+
+    // Başlangıç izi ilk frame'e kadar
+    if (traceStartup)
+        Profiler::get().stopCapture();
+    if (traceFrames > 0)
+        Profiler::get().startCapture("trace_frames.json", traceFrames);
+    int traceCount = 0;
 
     // -----------------------------------------------------------------
-    // ANA DÖNGÜ
+    // ANA DÖNGÜ (giriş, simülasyon, UI; GL işi render tarafında)
     // -----------------------------------------------------------------
     while (!glfwWindowShouldClose(window))
     {
+        PROFILE_FRAME();
+        if (traceRequested && !Profiler::get().capturing()) {
+            char path[32];
+            std::snprintf(path, sizeof(path), "trace_%03d.json", ++traceCount);
+            Profiler::get().startCapture(path, TRACE_HOTKEY_FRAMES);
+            std::cout << "Profiler: capturing " << TRACE_HOTKEY_FRAMES << " frames to " << path << std::endl;
+        }
+        traceRequested = false;
+        if (hudToggleRequested)
+            hud.toggle();
+        hudToggleRequested = false;
+
+        // ---------- Pacing, sonra giriş -----------------------------
+        // Olaylar beklemeden sonra okunur ki frame en taze girişle başlasın
+        {
+            PROFILE_SCOPE("Wait for render thread");
+            renderThread.beginFrame(settings);
+        }
+        JobSystem::get().beginFrame();
+        glfwPollEvents();
+        hotReload.dispatch();
+
         // Zaman --------------------------------------------------------
         float currentFrame = static_cast<float>(glfwGetTime());
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
-        processInput(window, &robot);
+        // UI'dan gelen değişiklikler sim adımlarından önce uygulanır
+        commands.apply(robot);
+
+        // Basılı tutulan tuşlar olay üretmez; kontrol aktifse giriş say
+        RobotInput robotInput = processInput(window);
+        robot.setInput(robotInput);
+        if (robotInput.active())
+            noteInput();
+
+        // ---------- Idle: değişiklik yoksa önbellekteki frame --------
+        int w, h;
+        glfwGetFramebufferSize(window, &w, &h);
+        IdleState state{Cam::position(), Cam::center, Cam::fov, robot.position, robot.direction, w, h};
+        // Açık performans katmanı canlı kalmalı: idle moduna girme
+        bool busy = robot.isMoving() || robotInput.active() || Cam::orbiting || ImGui::GetIO().WantTextInput ||
+                    hud.visible() || hotReload.busy();
+        idle.enabled = settings.idleMode;
+        bool renderFrame = idle.update(state, inputEvents, busy, glfwGetTime());
+        stats.idleFraction        = idle.idleFraction();
+        idle.setPresentedFrames(renderThread.cachedPresents());
+        stats.idleSavedFrames     = idle.savedFrames();
+        stats.idlePresentedFrames = idle.presentedFrames();
+        if (!renderFrame || w == 0 || h == 0) {
+            FramePacket &packet = renderThread.packet();
+            packet.presentCached = true;
+            packet.view.width    = w;
+            packet.view.height   = h;
+            renderThread.submit();
+            pendingInputTime = -1.0; // görüntüyü değiştirmeyen girişler gecikmeye sayılmaz
+            glfwWaitEventsTimeout(idle.wakeInterval);
+            lastFrame = static_cast<float>(glfwGetTime()); // uyanınca dev deltaTime olmasın
+            continue;
+        }
 
         // ---------- ImGui -------------------------------------------
-        ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
 
-        // Uygulama güncelleme
-        robot.update(deltaTime);
-
-        // ---------- Temizle ----------------------------------------
-        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-        shader.use();
+        // Uygulama güncelleme: sabit adımlı simülasyon
+        simClock.setRate(settings.simRateHz);
+        int simSteps = 0;
+        {
+            PROFILE_SCOPE("Simulation");
+            simSteps = simClock.tick(deltaTime, [&robot](float dt) { robot.update(dt); });
+        }
+        PROFILE_COUNTER("Sim steps", simSteps);
+        stats.simSteps     = simSteps;
+        stats.simAlpha     = simClock.alpha();
+        stats.simDroppedMs = static_cast<float>(simClock.droppedSeconds() * 1000.0);
+
+        // ---------- UI -------------------------------------------
+        {
+            PROFILE_SCOPE("UI");
+            ui.render();
+            hud.update();
+            hud.draw();
+            ImGui::Render();
+        }
 
         // ---------- Kamera & Projeksiyon ---------------------------
-        glm::vec3 camPos = Cam::position();
-        shader.setVec3("viewPos", camPos);
-
-        int w, h;
-        glfwGetFramebufferSize(window, &w, &h);
+        // Geç örnekleme: orbit/zoom, matrisler kurulmadan hemen önce güncellenir
+        glfwPollEvents();
         float aspect = static_cast<float>(w) / static_cast<float>(h);
 
-        glm::mat4 view = glm::lookAt(camPos, Cam::center, glm::vec3(0.0f, 1.0f, 0.0f));
-        glm::mat4 proj = glm::perspective(glm::radians(Cam::fov), aspect, Cam::radius * 0.01f, Cam::distance + Cam::radius * 2.0f);
-        shader.setMat4("view",       view);
-        shader.setMat4("projection", proj);
-
-        // ---------- Aydınlatma ------------------------------------
-        shader.setInt  ("numSpotLights", 1);
-        shader.setVec3 ("spotLights[0].position",  glm::vec3(0.0f, 5.0f, 0.0f));
-        shader.setVec3 ("spotLights[0].direction", glm::vec3(0.0f, -1.0f, 0.0f));
-        shader.setFloat("spotLights[0].cutOff",      glm::cos(glm::radians(12.5f)));
-        shader.setFloat("spotLights[0].outerCutOff", glm::cos(glm::radians(17.5f)));
-        shader.setVec3 ("spotLights[0].ambient",  glm::vec3(0.2f));
-        shader.setVec3 ("spotLights[0].diffuse",  glm::vec3(0.6f));
-        shader.setVec3 ("spotLights[0].specular", glm::vec3(1.0f));
-        shader.setFloat("spotLights[0].constant",  1.0f);
-        shader.setFloat("spotLights[0].linear",    0.09f);
-        shader.setFloat("spotLights[0].quadratic", 0.032f);
-
-        // ---------- Çizim ----------------------------------------
-        scene.draw(shader);
-        robot.draw(shader);
-        ui.render();
-
-        // ---------- ImGui Render ---------------------------------
-        ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-
-        // ---------- GLFW -----------------------------------------
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        // ---------- Frame paketi -----------------------------------
+        FramePacket &packet = renderThread.packet();
+        packet.presentCached = false;
+        packet.captureFrame  = idle.lastActiveFrame(); // boşta kalmadan önceki son frame saklanır
+        packet.view.cameraPos  = Cam::position();
+        packet.view.view       = glm::lookAt(packet.view.cameraPos, Cam::center, glm::vec3(0.0f, 1.0f, 0.0f));
+        packet.view.projection = glm::perspective(glm::radians(Cam::fov), aspect, Cam::radius * 0.01f, Cam::distance + Cam::radius * 2.0f);
+        packet.view.width  = w;
+        packet.view.height = h;
+        // Frustum culling: sınırların kendi kopyamız, sahne render tarafında
+        {
+            PROFILE_SCOPE("Culling");
+            scene.pollModelBounds(modelBounds, modelBoundsVersion);
+            cullSpheres(Frustum::fromMatrix(packet.view.projection * packet.view.view),
+                        modelBounds, packet.visibleModels);
+        }
+        packet.view.visibleModels = &packet.visibleModels;
+        PROFILE_COUNTER("Visible models", packet.visibleModels.size());
+        stats.visibleModels = static_cast<unsigned int>(packet.visibleModels.size());
+        stats.totalModels   = static_cast<unsigned int>(modelBounds.size());
+        packet.settings  = settings;
+        packet.robotPose = robot.pose(simClock.alpha()); // adımlar arası ara değer
+        packet.lights    = lights;
+        packet.ui        = ImGui::GetDrawData();
+        packet.inputTime = pendingInputTime;
+        pendingInputTime = -1.0;
+        {
+            PROFILE_SCOPE("Submit");
+            renderThread.submit();
+        }
+        renderThread.collectStats(stats);
+
+        // ---------- --alloc-check ------------------------------------
+        // Sayaç tüm thread'leri görür; render thread'in işi de bu frame'e sayılır
+        if (allocCheckFrames > 0) {
+            ++loopFrames;
+            if (loopFrames == ALLOC_WARMUP_FRAMES) {
+                AllocCounter::reset();
+                AllocCounter::enable();
+            } else if (loopFrames > ALLOC_WARMUP_FRAMES) {
+                unsigned long long allocs = AllocCounter::count();
+                if (allocs != allocsSeen) {
+                    if (allocatingFrames++ == 0)
+                        firstAllocatingFrame = loopFrames - ALLOC_WARMUP_FRAMES;
+                    allocsSeen = allocs;
+                }
+                if (loopFrames >= ALLOC_WARMUP_FRAMES + allocCheckFrames)
+                    glfwSetWindowShouldClose(window, true);
+            }
+        }
     }
 
     // -----------------------------------------------------------------
     // Kapat / temizlik
     // -----------------------------------------------------------------
+    renderThread.stop();
+    hotReload.stop(); // işler JobSystem kapanmadan biter
+    glfwMakeContextCurrent(window);
+    GpuProfiler::get().shutdown();
+    JobSystem::get().shutdown();
+    Profiler::get().stopCapture(); // yarım kalan yakalama da yazılsın
+
+    int exitCode = 0;
+    if (allocCheckFrames > 0) {
+        if (loopFrames >= ALLOC_WARMUP_FRAMES)
+            AllocCounter::disable(); // HUD açıksa sayaç onunla açık kalır
+        int checked = std::max(0, loopFrames - ALLOC_WARMUP_FRAMES);
+        std::cout << "Alloc check: " << checked << " frames after " << ALLOC_WARMUP_FRAMES << " warmup, "
+                  << allocatingFrames << " allocating (" << AllocCounter::count() << " allocations, "
+                  << AllocCounter::bytes() << " bytes, largest " << AllocCounter::largest() << ")";
+        if (allocatingFrames > 0)
+            std::cout << ", first at frame " << firstAllocatingFrame;
+        std::cout << "\n";
+        // Pencere erken kapandıysa da başarısız say
+        exitCode = (allocatingFrames > 0 || checked < allocCheckFrames) ? 1 : 0;
+    }
+
+    idle.setPresentedFrames(renderThread.cachedPresents());
+    std::cout << "Idle: " << idle.idleFraction() * 100.0f << "% of run time, "
+              << idle.savedFrames() << " frames saved, "
+              << idle.presentedFrames() << " cached re-presents\n";
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
 
     glfwTerminate();
-    return 0;
+    return exitCode;
 }
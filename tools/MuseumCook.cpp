@@ -0,0 +1,368 @@
+// MuseumCook.cpp
+// Offline asset cooker: imports every model of a scene and decodes its
+// textures in parallel jobs, then writes one indexed pack (AssetPack.h)
+// that VirtualMuseum and museum_bench load with --pack. Reports cook time,
+// pack size and load time of the pack against the loose files.
+//
+//   museum_cook [--scene file] [--out museum.vmpack] [--no-compress]
+//               [--reps N] [--cold] [--no-compare]
+//               [--patch-from old.vmpack [--patch file]]
+//
+// --patch-from also writes a delta update from the previously shipped pack
+// to the new one (PackPatch.h; default name: --out with .vmpatch), which
+// kiosks apply with VirtualMuseum --pack museum.vmpack --apply-patch file.
+//
+// Load time here is the CPU side (files -> ModelData + pixels); GL upload
+// is the same for both and shows up in museum_bench --pack (load_ms).
+// --cold drops the inputs and the pack from the page cache before every
+// run (posix_fadvise, Linux only). Run it from the directory holding
+// models/, like VirtualMuseum.
+#include <stb_image.h>
+#include "AssetPack.h"
+#include "JobSystem.h"
+#include "PackPatch.h"
+#include "Model.h"
+#include "SceneFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <vector>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::string scenePath = DEFAULT_SCENE_PATH;
+        std::string outPath = "museum.vmpack";
+        std::string patchFrom, patchPath;
+        bool compress = true;
+        bool compare = true;
+        bool cold = false;
+        int reps = 3;
+    };
+
+    double msSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    double megabytes(std::uint64_t bytes)
+    {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+    bool dropFromCache(const std::string &path)
+    {
+#if defined(__linux__) && defined(POSIX_FADV_DONTNEED)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        const bool dropped = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+        close(fd);
+        return dropped;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    // Modellerin kullandığı dokular, sırayla ve tekrarsız
+    std::vector<std::string> texturePaths(const std::vector<ModelData> &models)
+    {
+        std::vector<std::string> paths;
+        std::set<std::string> seen;
+        for (const ModelData &data : models)
+            for (const ImportedMaterial &material : data.materials)
+                for (const std::string *path : {&material.diffuseTexture, &material.specularTexture})
+                    if (!path->empty() && seen.insert(*path).second)
+                        paths.push_back(*path);
+        return paths;
+    }
+
+    // Kiosk'a kopyalanacak gevşek dosyalar: modeller, yanlarındaki .mtl'ler, dokular
+    std::vector<std::string> looseFiles(const SceneDesc &desc, const std::vector<std::string> &textures)
+    {
+        std::set<std::string> files(textures.begin(), textures.end());
+        std::error_code ec;
+        for (const ModelDesc &model : desc.models)
+        {
+            files.insert(model.path);
+            for (const auto &entry : fs::directory_iterator(fs::path(model.path).parent_path(), ec))
+                if (entry.is_regular_file(ec) && entry.path().extension() == ".mtl")
+                    files.insert(entry.path().string());
+        }
+        return std::vector<std::string>(files.begin(), files.end());
+    }
+
+    // Import her model için bir iş; hata mesajı boşsa başarılı
+    void importModels(const SceneDesc &desc, std::vector<ModelData> &models, std::vector<std::string> &errors)
+    {
+        JobSystem &jobs = JobSystem::get();
+        models.assign(desc.models.size(), ModelData());
+        errors.assign(desc.models.size(), std::string());
+        JobCounter counter{0};
+        for (std::size_t i = 0; i < desc.models.size(); ++i)
+        {
+            jobs.run([&desc, &models, &errors, i]
+                     {
+                try
+                {
+                    models[i] = Model::import(desc.models[i].path, desc.models[i].import);
+                }
+                catch (const std::exception &e)
+                {
+                    errors[i] = e.what();
+                } },
+                     &counter);
+        }
+        jobs.wait(counter);
+    }
+
+    struct DecodedTexture
+    {
+        unsigned char *pixels = nullptr;
+        int width = 0, height = 0, components = 0;
+    };
+
+    void decodeTextures(const std::vector<std::string> &paths, std::vector<DecodedTexture> &decoded)
+    {
+        decoded.assign(paths.size(), DecodedTexture());
+        JobSystem::get().parallelFor(paths.size(), [&](std::size_t begin, std::size_t end)
+                                     {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                DecodedTexture &t = decoded[i];
+                t.pixels = stbi_load(paths[i].c_str(), &t.width, &t.height, &t.components, 0);
+            } }, 1);
+    }
+
+    void freeTextures(std::vector<DecodedTexture> &decoded)
+    {
+        for (DecodedTexture &t : decoded)
+            stbi_image_free(t.pixels);
+        decoded.clear();
+    }
+
+    // Çalışma zamanının CPU tarafı, gevşek dosyalardan: Assimp + stb_image
+    double loadLoose(const SceneDesc &desc, const std::vector<std::string> &textures)
+    {
+        auto start = Clock::now();
+        std::vector<ModelData> models;
+        std::vector<std::string> errors;
+        importModels(desc, models, errors);
+        std::vector<DecodedTexture> decoded;
+        decodeTextures(textures, decoded);
+        const double ms = msSince(start);
+        freeTextures(decoded);
+        return ms;
+    }
+
+    // Aynısı paketten. Ham dokular eşlemede kalır; GL yüklemesi sayfaları
+    // okuyacağı için burada dokunulur ki sayfa hataları da sayılsın.
+    double loadPacked(const std::string &packPath, const SceneDesc &desc, const std::vector<std::string> &textures,
+                      std::string &error)
+    {
+        auto start = Clock::now();
+        AssetPack pack;
+        if (!pack.mount(packPath, error))
+            return -1.0;
+        std::vector<ModelData> models(desc.models.size());
+        std::vector<std::string> errors(desc.models.size());
+        JobSystem::get().parallelFor(desc.models.size(), [&](std::size_t begin, std::size_t end)
+                                     {
+            for (std::size_t i = begin; i < end; ++i)
+                pack.loadModel(desc.models[i].path, models[i], errors[i]); }, 1);
+        std::vector<TextureData> decoded(textures.size());
+        std::vector<unsigned> touched(textures.size(), 0);
+        JobSystem::get().parallelFor(textures.size(), [&](std::size_t begin, std::size_t end)
+                                     {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                std::string textureError;
+                if (!pack.loadTexture(textures[i], decoded[i], textureError) || !decoded[i].storage.empty())
+                    continue;
+                const std::size_t size = static_cast<std::size_t>(decoded[i].width) * decoded[i].height *
+                                         decoded[i].components;
+                for (std::size_t at = 0; at < size; at += PACK_ALIGNMENT)
+                    touched[i] += decoded[i].pixels[at];
+            } }, 1);
+        const double ms = msSince(start);
+        for (const std::string &e : errors)
+        {
+            if (!e.empty())
+            {
+                error = e;
+                return -1.0;
+            }
+        }
+        return ms;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options opts;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--scene") == 0 && i + 1 < argc)
+            opts.scenePath = argv[++i];
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            opts.outPath = argv[++i];
+        else if (std::strcmp(argv[i], "--no-compress") == 0)
+            opts.compress = false;
+        else if (std::strcmp(argv[i], "--no-compare") == 0)
+            opts.compare = false;
+        else if (std::strcmp(argv[i], "--cold") == 0)
+            opts.cold = true;
+        else if (std::strcmp(argv[i], "--reps") == 0 && i + 1 < argc)
+            opts.reps = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--patch-from") == 0 && i + 1 < argc)
+            opts.patchFrom = argv[++i];
+        else if (std::strcmp(argv[i], "--patch") == 0 && i + 1 < argc)
+            opts.patchPath = argv[++i];
+        else
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+    }
+
+    SceneDesc desc;
+    std::string error;
+    if (!loadSceneFile(opts.scenePath, desc, error))
+    {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 2;
+    }
+    JobSystem::get().init();
+    const unsigned int threads = JobSystem::get().threadCount();
+
+    // ---------- Pişirme ---------------------------------------------------
+    auto cookStart = Clock::now();
+    std::vector<ModelData> models;
+    std::vector<std::string> errors;
+    importModels(desc, models, errors);
+    const double importMs = msSince(cookStart);
+    bool failed = false;
+    for (std::size_t i = 0; i < errors.size(); ++i)
+    {
+        if (!errors[i].empty())
+        {
+            std::fprintf(stderr, "%s: %s\n", desc.models[i].path.c_str(), errors[i].c_str());
+            failed = true;
+        }
+    }
+    if (failed)
+        return 1;
+
+    auto textureStart = Clock::now();
+    const std::vector<std::string> textures = texturePaths(models);
+    std::vector<DecodedTexture> decoded;
+    decodeTextures(textures, decoded);
+    const double textureMs = msSince(textureStart);
+
+    auto packStart = Clock::now();
+    PackWriter writer;
+    writer.addScene(desc);
+    for (ModelData &data : models)
+    {
+        writer.addModel(data);
+        data = ModelData(); // kopyalandı; bellek erken geri verilsin
+    }
+    std::size_t packedTextures = 0;
+    for (std::size_t i = 0; i < textures.size(); ++i)
+    {
+        const DecodedTexture &t = decoded[i];
+        if (!t.pixels)
+        {
+            // Çalışma zamanı gevşek dosyaya düşer; kiosk'ta yoksa beyaz doku
+            std::fprintf(stderr, "warning: cannot decode %s, left out of the pack\n", textures[i].c_str());
+            continue;
+        }
+        writer.addTexture(textures[i], t.pixels, t.width, t.height, t.components);
+        ++packedTextures;
+    }
+    freeTextures(decoded);
+    PackStats stats;
+    if (!writer.write(opts.outPath, opts.compress, stats, error))
+    {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    const double packMs = msSince(packStart);
+    const double cookMs = msSince(cookStart);
+
+    std::uint64_t looseBytes = 0;
+    const std::vector<std::string> loose = looseFiles(desc, textures);
+    for (const std::string &file : loose)
+    {
+        std::error_code ec;
+        const auto size = fs::file_size(file, ec);
+        if (!ec)
+            looseBytes += size;
+    }
+
+    std::printf("cooked %zu models, %zu textures in %.1f ms on %u threads "
+                "(import %.1f, textures %.1f, hash/compress/write %.1f)\n",
+                desc.models.size(), packedTextures, cookMs, threads, importMs, textureMs, packMs);
+    std::printf("%s: %zu entries, %zu payloads (%zu LZ4), %.2f MB decoded -> %.2f MB after dedup -> %.2f MB stored, "
+                "file %.2f MB\n",
+                opts.outPath.c_str(), stats.entries, stats.payloads, stats.compressed, megabytes(stats.rawBytes),
+                megabytes(stats.uniqueBytes), megabytes(stats.storedBytes), megabytes(stats.fileBytes));
+    std::printf("loose files: %zu, %.2f MB (pack is %.0f%%)\n", loose.size(), megabytes(looseBytes),
+                looseBytes ? 100.0 * static_cast<double>(stats.fileBytes) / static_cast<double>(looseBytes) : 0.0);
+
+    if (!opts.patchFrom.empty())
+    {
+        const std::string patchPath =
+            opts.patchPath.empty() ? fs::path(opts.outPath).replace_extension(".vmpatch").string() : opts.patchPath;
+        PatchStats patch;
+        auto diffStart = Clock::now();
+        if (!createPackPatch(opts.patchFrom, opts.outPath, patchPath, patch, error))
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        std::printf("%s: %.3f MB from %s in %.1f ms (%.2f%% of the pack; %zu payloads reused, %zu changed, "
+                    "%zu/%zu chunks found)\n",
+                    patchPath.c_str(), megabytes(patch.patchSize), opts.patchFrom.c_str(), msSince(diffStart),
+                    100.0 * static_cast<double>(patch.patchSize) / static_cast<double>(patch.newSize),
+                    patch.payloadsReused, patch.payloadsChunked, patch.chunksReused, patch.chunks);
+    }
+    if (!opts.compare)
+        return 0;
+
+    // ---------- Yükleme karşılaştırması (en iyi tekrar) -------------------
+    double bestLoose = 1e30, bestPack = 1e30;
+    for (int rep = 0; rep < opts.reps; ++rep)
+    {
+        if (opts.cold)
+            for (const std::string &file : loose)
+                dropFromCache(file);
+        bestLoose = std::min(bestLoose, loadLoose(desc, textures));
+
+        if (opts.cold)
+            dropFromCache(opts.outPath);
+        const double packed = loadPacked(opts.outPath, desc, textures, error);
+        if (packed < 0.0)
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        bestPack = std::min(bestPack, packed);
+    }
+    std::printf("load (%s cache, best of %d): loose %.2f ms, pack %.2f ms (%.1fx)\n", opts.cold ? "cold" : "warm",
+                opts.reps, bestLoose, bestPack, bestPack > 0.0 ? bestLoose / bestPack : 0.0);
+    return 0;
+}